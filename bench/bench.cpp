@@ -0,0 +1,650 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+/*  Performance suite
+
+    Usage:
+        boost_punycode_bench
+            [--filter=<substring>]
+            [--min-time=<seconds>]
+            [--format=console|json]
+            [--perf]
+            [--latency]
+
+    Every kernel runs over every corpus. One op
+    is one conversion of one corpus input, and
+    bytes/sec is always measured against the
+    utf8 size of the input so that kernels over
+    the same corpus can be compared directly.
+
+    With --perf, hardware counters (cycles,
+    instructions, branch misses, L1i misses)
+    are reported per input byte and per label.
+    Counters the host cannot provide show as
+    n/a, or null in the json.
+
+    With --latency, individual calls to
+    utf8_to_idna and decode are timed instead,
+    and percentiles of the per-call latency
+    are reported for each corpus.
+*/
+
+#include "bench.hpp"
+#include <boost/punycode/detail/nameprep.hpp>
+#include <boost/punycode/domain_set.hpp>
+#include <boost/punycode/idna.hpp>
+#include <boost/punycode/idna_hash.hpp>
+#include <boost/punycode/idna_view.hpp>
+#include <boost/punycode/public_suffix_list.hpp>
+#include <boost/punycode/punycode.hpp>
+#include <boost/punycode/transcode.hpp>
+#include <boost/punycode/utf8_count.hpp>
+#include <boost/punycode/utf8_input.hpp>
+#include <boost/punycode/utf8_output.hpp>
+#include <boost/punycode/uts46.hpp>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <new>
+
+//------------------------------------------------
+//
+// Allocation counting
+//
+
+namespace {
+
+std::uint64_t g_allocs = 0;
+
+} // (anon)
+
+void*
+operator new(std::size_t n)
+{
+    ++g_allocs;
+    if(n == 0)
+        n = 1;
+    if(void* p = std::malloc(n))
+        return p;
+    throw std::bad_alloc();
+}
+
+void*
+operator new[](std::size_t n)
+{
+    return ::operator new(n);
+}
+
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace boost {
+namespace punycode {
+namespace bench {
+
+std::uint64_t
+allocation_count() noexcept
+{
+    return g_allocs;
+}
+
+//------------------------------------------------
+//
+// Kernels
+//
+
+static
+bool
+needs_puny(corpus const& c)
+{
+    return c.has_non_ascii;
+}
+
+// true if every label fits the
+// buffer inside an idna_view iterator
+static
+bool
+dns_labels(corpus const& c)
+{
+    for(auto const& s : c.utf8)
+    {
+        try
+        {
+            idna_view const v(s);
+            for(auto it = v.begin(); it != v.end(); ++it)
+            {
+            }
+        }
+        catch(std::exception const&)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static
+std::vector<kernel>
+make_kernels()
+{
+    std::vector<kernel> v;
+
+    v.push_back({ "encode",
+        [](corpus const& c)
+        {
+            char buf[32768];
+            for(auto const& s : c.utf32)
+            {
+                auto const end = punycode::encode(
+                    &buf[0], s.data(), s.data() + s.size());
+                do_not_optimize(end);
+            }
+        } });
+
+    v.push_back({ "decode",
+        [](corpus const& c)
+        {
+            char32_t buf[8192];
+            for(auto const& s : c.puny)
+            {
+                std::size_t n = 8192;
+                punycode::decode(
+                    s.data(), s.size(), &buf[0], &n);
+                do_not_optimize(n);
+            }
+        },
+        needs_puny });
+
+    v.push_back({ "utf8_input",
+        [](corpus const& c)
+        {
+            char32_t buf[8192];
+            for(auto const& s : c.utf8)
+            {
+                auto const end = std::copy(
+                    utf8_input(s.data(), s.data() + s.size()),
+                    utf8_input(s.data() + s.size()),
+                    &buf[0]);
+                do_not_optimize(end);
+            }
+        } });
+
+    v.push_back({ "utf8_to_utf32",
+        [](corpus const& c)
+        {
+            char32_t buf[8192];
+            for(auto const& s : c.utf8)
+            {
+                auto const rv = utf8_to_utf32(s, &buf[0]);
+                do_not_optimize(*rv);
+            }
+        } });
+
+    v.push_back({ "is_valid_utf8",
+        [](corpus const& c)
+        {
+            for(auto const& s : c.utf8)
+                do_not_optimize(is_valid_utf8(s));
+        } });
+
+    v.push_back({ "utf8_output",
+        [](corpus const& c)
+        {
+            char buf[32768];
+            for(auto const& s : c.utf32)
+            {
+                std::copy(s.begin(), s.end(),
+                    utf8_output(&buf[0]));
+                do_not_optimize(buf[0]);
+            }
+        } });
+
+    v.push_back({ "utf32_to_utf8",
+        [](corpus const& c)
+        {
+            char buf[32768];
+            for(auto const& s : c.utf32)
+            {
+                auto const rv = utf32_to_utf8(
+                    s.data(), s.size(), &buf[0], sizeof(buf));
+                do_not_optimize(*rv);
+            }
+        } });
+
+    v.push_back({ "utf8_count",
+        [](corpus const& c)
+        {
+            for(auto const& s : c.utf32)
+                do_not_optimize(std::copy(s.begin(), s.end(),
+                    utf8_count()).count());
+        } });
+
+    v.push_back({ "utf8_length",
+        [](corpus const& c)
+        {
+            for(auto const& s : c.utf32)
+                do_not_optimize(utf8_length(
+                    s.data(), s.size()));
+        } });
+
+    v.push_back({ "utf32_length",
+        [](corpus const& c)
+        {
+            for(auto const& s : c.utf8)
+                do_not_optimize(utf32_length(s));
+        } });
+
+    v.push_back({ "nameprep",
+        [](corpus const& c)
+        {
+            using iter = punycode::detail::nameprep_iterator<utf8_input>;
+            for(auto const& s : c.utf8)
+            {
+                utf8_input const first(
+                    s.data(), s.data() + s.size());
+                utf8_input const last(
+                    s.data() + s.size());
+                char32_t sum = 0;
+                for(iter it(first, last), end(last);
+                        it != end; ++it)
+                    sum += *it;
+                do_not_optimize(sum);
+            }
+        } });
+
+    v.push_back({ "utf8_to_idna",
+        [](corpus const& c)
+        {
+            // storage is reused, as a caller in a
+            // loop would, so steady state is measured
+            std::string storage;
+            for(auto const& s : c.utf8)
+            {
+                auto rv = utf8_to_idna(
+                    s, std::move(storage));
+                do_not_optimize(rv->data());
+                storage = std::move(*rv);
+            }
+        } });
+
+    v.push_back({ "utf8_to_idna_labels",
+        [](corpus const& c)
+        {
+            std::string storage;
+            std::vector<label_info> labels;
+            for(auto const& s : c.utf8)
+            {
+                auto rv = utf8_to_idna(
+                    s, labels, std::move(storage));
+                do_not_optimize(labels.data());
+                storage = std::move(*rv);
+            }
+        } });
+
+    v.push_back({ "utf8_to_idna_borrowed",
+        [](corpus const& c)
+        {
+            std::string storage;
+            for(auto const& s : c.utf8)
+                do_not_optimize(utf8_to_idna_borrowed(
+                    s, storage)->data());
+        } });
+
+    v.push_back({ "utf8_to_dns_wire",
+        [](corpus const& c)
+        {
+            char buf[255];
+            for(auto const& s : c.utf8)
+            {
+                auto rv = utf8_to_dns_wire(
+                    s, buf, sizeof(buf));
+                do_not_optimize(buf);
+                do_not_optimize(rv.has_value());
+            }
+        } });
+
+    v.push_back({ "uts46_to_ascii",
+        [](corpus const& c)
+        {
+            // inputs UTS #46 rejects are timed
+            // too, but leave the storage behind
+            std::string storage;
+            for(auto const& s : c.utf8)
+            {
+                auto rv = uts46_to_ascii(
+                    s, {}, std::move(storage));
+                do_not_optimize(rv.has_value());
+                if(rv)
+                    storage = std::move(*rv);
+            }
+        } });
+
+    v.push_back({ "idna_view",
+        [](corpus const& c)
+        {
+            char buf[1024];
+            for(auto const& s : c.utf8)
+            {
+                idna_view const v(s);
+                do_not_optimize(std::copy(
+                    v.begin(), v.end(), &buf[0]));
+            }
+        },
+        dns_labels });
+
+    v.push_back({ "idna_hash",
+        [](corpus const& c)
+        {
+            std::size_t h = 0;
+            for(auto const& s : c.utf8)
+                h += idna_hash()(s);
+            do_not_optimize(h);
+        },
+        dns_labels });
+
+    v.push_back({ "skeleton_hash",
+        [](corpus const& c)
+        {
+            std::vector<core::string_view> const v(
+                c.utf8.begin(), c.utf8.end());
+            std::vector<std::uint64_t> h(v.size());
+            skeleton_hash(v.data(), v.size(), h.data());
+            do_not_optimize(h.data());
+        } });
+
+    v.push_back({ "idna_classify",
+        [](corpus const& c)
+        {
+            unsigned f = 0;
+            for(auto const& s : c.utf8)
+                f |= idna_classify(s);
+            do_not_optimize(f);
+        } });
+
+    v.push_back({ "idna_equivalent",
+        [](corpus const& c)
+        {
+            // each input against its IDNA, the
+            // slowest case, since nothing differs
+            std::size_t n = 0;
+            for(std::size_t i = 0; i < c.size(); ++i)
+                n += idna_equivalent(
+                    c.utf8[i], c.idna[i]);
+            do_not_optimize(n);
+        } });
+
+    v.push_back({ "registrable_domain",
+        [](corpus const& c)
+        {
+            // the list of the system when there is
+            // one, so that the root is as wide as in
+            // use, or else the corpus TLDs alone
+            static public_suffix_list const psl = []
+            {
+                auto rv = public_suffix_list::load(
+                    "/usr/share/publicsuffix/public_suffix_list.dat");
+                if(rv)
+                    return std::move(*rv);
+                return *public_suffix_list::parse(
+                    "com\norg\nnet\nde\nru\njp\nio\n");
+            }();
+            std::size_t n = 0;
+            for(auto const& s : c.idna)
+                n += psl.registrable_domain(s).size();
+            do_not_optimize(n);
+        } });
+
+    v.push_back({ "domain_set",
+        [](corpus const& c)
+        {
+            // a million names under the corpus
+            // TLDs, so that "com" is a wide level
+            static domain_set const set = []
+            {
+                std::vector<std::string> names;
+                std::uint32_t x = 1;
+                for(int i = 0; i < 1000000; ++i)
+                {
+                    std::string s;
+                    for(int j = 0; j < 10; ++j)
+                    {
+                        x = x * 1664525u + 1013904223u;
+                        s.push_back(static_cast<char>(
+                            'a' + (x >> 24) % 26));
+                    }
+                    s += i % 2 ? ".com" : ".net";
+                    names.push_back(std::move(s));
+                }
+                std::vector<core::string_view> const v(
+                    names.begin(), names.end());
+                return *domain_set::build(v.data(), v.size());
+            }();
+            std::size_t n = 0;
+            for(auto const& s : c.utf8)
+                n += set.contains(s);
+            do_not_optimize(n);
+        } });
+
+    v.push_back({ "utf16_to_idna",
+        [](corpus const& c)
+        {
+            std::string storage;
+            for(auto const& s : c.utf16)
+            {
+                auto rv = utf16_to_idna(
+                    s, std::move(storage));
+                do_not_optimize(rv->data());
+                storage = std::move(*rv);
+            }
+        } });
+
+    return v;
+}
+
+static
+void
+usage()
+{
+    std::fprintf(stderr,
+        "usage: boost_punycode_bench"
+        " [--filter=<substring>]"
+        " [--min-time=<seconds>]"
+        " [--format=console|json]"
+        " [--perf]"
+        " [--latency]\n");
+}
+
+static
+bool
+parse_args(
+    int argc,
+    char** argv,
+    options& opt)
+{
+    auto const arg =
+        [](char const* s, char const* name)
+            -> char const*
+        {
+            auto const n = std::strlen(name);
+            if(std::strncmp(s, name, n) == 0)
+                return s + n;
+            return nullptr;
+        };
+    for(int i = 1; i < argc; ++i)
+    {
+        char const* v;
+        if((v = arg(argv[i], "--filter=")))
+            opt.filter = v;
+        else if((v = arg(argv[i], "--min-time=")))
+            opt.min_time = std::atof(v);
+        else if(std::strcmp(argv[i], "--perf") == 0)
+            opt.perf = true;
+        else if(std::strcmp(argv[i], "--latency") == 0)
+            opt.latency = true;
+        else if((v = arg(argv[i], "--format=")))
+        {
+            if(std::strcmp(v, "json") == 0)
+                opt.json = true;
+            else if(std::strcmp(v, "console") != 0)
+                return false;
+        }
+        else
+            return false;
+    }
+    return opt.min_time > 0;
+}
+
+static
+bool
+selected(
+    options const& opt,
+    std::string const& name)
+{
+    return
+        opt.filter.empty() ||
+        name.find(opt.filter) != std::string::npos;
+}
+
+static
+int
+run_latency(
+    options const& opt,
+    std::vector<corpus> const& corpora)
+{
+    tsc_clock const clk;
+    std::FILE* con = opt.json ? stderr : stdout;
+    print_latency_header(con);
+
+    std::vector<latency_result> results;
+    for(auto const& c : corpora)
+    {
+        if(selected(opt, "utf8_to_idna/" + c.name))
+        {
+            std::string storage;
+            results.push_back(measure_latency(
+                "utf8_to_idna", c, opt, clk,
+                [&](std::size_t i)
+                {
+                    // failures are timed too, since
+                    // throwing is one of the outliers
+                    try
+                    {
+                        auto rv = utf8_to_idna(
+                            c.utf8[i], std::move(storage));
+                        if(rv)
+                            storage = std::move(*rv);
+                    }
+                    catch(std::exception const&)
+                    {
+                    }
+                }));
+            print_latency(con, results.back());
+        }
+        if( c.has_non_ascii &&
+            selected(opt, "decode/" + c.name))
+        {
+            std::vector<char32_t> buf(8192);
+            results.push_back(measure_latency(
+                "decode", c, opt, clk,
+                [&](std::size_t i)
+                {
+                    auto const& s = c.puny[i];
+                    std::size_t n = buf.size();
+                    punycode::decode(
+                        s.data(), s.size(), buf.data(), &n);
+                    do_not_optimize(n);
+                }));
+            print_latency(con, results.back());
+        }
+    }
+
+    if(opt.json)
+        print_latency_json(stdout, results, opt, clk);
+    return EXIT_SUCCESS;
+}
+
+static
+int
+run(int argc, char** argv)
+{
+    options opt;
+    if(! parse_args(argc, argv, opt))
+    {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    auto const corpora = make_corpora();
+    if(opt.latency)
+        return run_latency(opt, corpora);
+
+    auto const kernels = make_kernels();
+
+    perf_counters pc;
+    if(opt.perf && ! pc.available())
+        std::fprintf(stderr,
+            "warning: hardware counters are unavailable"
+            " on this host, continuing without them\n");
+    perf_counters* ppc = (opt.perf &&
+        pc.available()) ? &pc : nullptr;
+
+    // progress goes to stderr so the
+    // json on stdout stays parseable
+    std::FILE* con = opt.json ? stderr : stdout;
+    print_console_header(con);
+
+    std::vector<result> results;
+    for(auto const& k : kernels)
+    {
+        for(auto const& c : corpora)
+        {
+            if(! selected(opt, k.name + "/" + c.name))
+                continue;
+            if(! k.accepts(c))
+                continue;
+            results.push_back(measure(k, c, opt, ppc));
+            print_console(con, results.back());
+        }
+    }
+
+    if(opt.json)
+        print_json(stdout, results, opt);
+    return EXIT_SUCCESS;
+}
+
+} // bench
+} // punycode
+} // boost
+
+int
+main(int argc, char** argv)
+{
+    return boost::punycode::bench::run(argc, argv);
+}
@@ -0,0 +1,472 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#ifndef BOOST_PUNYCODE_BENCH_BENCH_HPP
+#define BOOST_PUNYCODE_BENCH_BENCH_HPP
+
+#include "corpus.hpp"
+#include "histogram.hpp"
+#include "perf_counters.hpp"
+#include "tsc_clock.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace punycode {
+namespace bench {
+
+/** Number of calls to the global operator new
+
+    The benchmark executable replaces the global
+    allocation functions so this can be sampled
+    around each measurement.
+*/
+std::uint64_t
+allocation_count() noexcept;
+
+/** Prevent the optimizer from discarding a value
+*/
+template<class T>
+inline
+void
+do_not_optimize(T const& v) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(v) : "memory");
+#else
+    static volatile char sink;
+    sink = *reinterpret_cast<
+        char const volatile*>(&v);
+#endif
+}
+
+/** A benchmark kernel
+
+    One call to `run` performs one operation on
+    every input in the corpus. A kernel which
+    does not apply to a corpus returns `false`
+    from `accepts`, and the pair is skipped.
+*/
+struct kernel
+{
+    std::string name;
+    std::function<void(corpus const&)> run;
+    std::function<bool(corpus const&)> accepts;
+
+    kernel(
+        std::string name_,
+        std::function<void(corpus const&)> run_,
+        std::function<bool(corpus const&)> accepts_ =
+            [](corpus const&) { return true; })
+        : name(std::move(name_))
+        , run(std::move(run_))
+        , accepts(std::move(accepts_))
+    {
+    }
+};
+
+/** The measurement of one kernel over one corpus
+*/
+struct result
+{
+    std::string kernel;
+    std::string corpus;
+    std::uint64_t iterations = 0;
+    std::uint64_t ops = 0;
+    double seconds = 0;
+    double ns_per_op = 0;
+    double bytes_per_second = 0;
+    double allocs_per_op = 0;
+
+    // hardware counters, when requested
+    perf_counters::sample counters;
+    std::uint64_t bytes = 0;
+    std::uint64_t labels = 0;
+
+    bool
+    has_counters() const noexcept
+    {
+        for(auto v : counters.valid)
+            if(v)
+                return true;
+        return false;
+    }
+
+    double
+    per_byte(std::size_t i) const noexcept
+    {
+        return static_cast<double>(
+            counters.value[i]) /
+            static_cast<double>(bytes);
+    }
+
+    double
+    per_label(std::size_t i) const noexcept
+    {
+        return static_cast<double>(
+            counters.value[i]) /
+            static_cast<double>(labels);
+    }
+};
+
+struct options
+{
+    std::string filter;
+    double min_time = 0.5;
+    bool json = false;
+    bool perf = false;
+    bool latency = false;
+};
+
+/** Time a kernel over a corpus
+
+    The number of passes grows until the
+    measured interval reaches `min_time`, in
+    the same manner as Google Benchmark.
+    When `pc` is not null, hardware counters
+    are read around the final interval.
+*/
+inline
+result
+measure(
+    kernel const& k,
+    corpus const& c,
+    options const& opt,
+    perf_counters* pc = nullptr)
+{
+    using clock = std::chrono::steady_clock;
+
+    // warm up caches and branch predictors
+    k.run(c);
+
+    result r;
+    r.kernel = k.name;
+    r.corpus = c.name;
+    std::uint64_t iters = 1;
+    for(;;)
+    {
+        if(pc)
+            pc->start();
+        auto const a0 = allocation_count();
+        auto const t0 = clock::now();
+        for(std::uint64_t i = 0; i < iters; ++i)
+            k.run(c);
+        auto const t1 = clock::now();
+        auto const a1 = allocation_count();
+        if(pc)
+            r.counters = pc->stop();
+        auto const sec = std::chrono::duration<
+            double>(t1 - t0).count();
+        if( sec >= opt.min_time ||
+            iters >= (std::uint64_t(1) << 40))
+        {
+            r.iterations = iters;
+            r.ops = iters * c.size();
+            r.seconds = sec;
+            r.ns_per_op = sec * 1e9 /
+                static_cast<double>(r.ops);
+            r.bytes_per_second =
+                static_cast<double>(c.bytes) *
+                static_cast<double>(iters) / sec;
+            r.allocs_per_op =
+                static_cast<double>(a1 - a0) /
+                static_cast<double>(r.ops);
+            r.bytes = iters * c.bytes;
+            r.labels = iters * c.labels;
+            return r;
+        }
+        // aim just past min_time, at most 10x
+        double mul = sec > 0 ?
+            1.4 * opt.min_time / sec : 10;
+        if(mul > 10)
+            mul = 10;
+        if(mul < 2)
+            mul = 2;
+        iters = static_cast<std::uint64_t>(
+            static_cast<double>(iters) * mul);
+    }
+}
+
+//------------------------------------------------
+
+inline
+void
+print_console_header(std::FILE* f)
+{
+    std::fprintf(f,
+        "%-28s %14s %14s %12s %10s\n",
+        "benchmark", "iterations",
+        "ns/op", "MB/s", "allocs/op");
+}
+
+inline
+void
+print_console(
+    std::FILE* f,
+    result const& r)
+{
+    auto const name =
+        r.kernel + "/" + r.corpus;
+    std::fprintf(f,
+        "%-28s %14llu %14.1f %12.1f %10.2f\n",
+        name.c_str(),
+        static_cast<unsigned long long>(
+            r.iterations),
+        r.ns_per_op,
+        r.bytes_per_second / 1e6,
+        r.allocs_per_op);
+    if(! r.has_counters())
+        return;
+    std::fprintf(f, "%-28s", "");
+    for(std::size_t i = 0;
+        i < perf_counters::size; ++i)
+    {
+        if(! r.counters.valid[i])
+            std::fprintf(f, " %s=n/a",
+                perf_counters::name(i));
+        else
+            std::fprintf(f, " %s=%.2f/B %.1f/label",
+                perf_counters::name(i),
+                r.per_byte(i),
+                r.per_label(i));
+    }
+    std::fprintf(f, "\n");
+}
+
+/** Write results in Google Benchmark's JSON layout
+
+    Extra fields are added alongside the
+    standard ones so existing tooling which
+    compares runs keeps working.
+*/
+inline
+void
+print_json(
+    std::FILE* f,
+    std::vector<result> const& v,
+    options const& opt)
+{
+    std::fprintf(f,
+        "{\n"
+        "  \"context\": {\n"
+        "    \"library\": \"boost_punycode\",\n"
+        "    \"min_time\": %g\n"
+        "  },\n"
+        "  \"benchmarks\": [",
+        opt.min_time);
+    for(std::size_t i = 0; i < v.size(); ++i)
+    {
+        auto const& r = v[i];
+        std::fprintf(f,
+            "%s\n"
+            "    {\n"
+            "      \"name\": \"%s/%s\",\n"
+            "      \"kernel\": \"%s\",\n"
+            "      \"corpus\": \"%s\",\n"
+            "      \"iterations\": %llu,\n"
+            "      \"ops\": %llu,\n"
+            "      \"real_time\": %.3f,\n"
+            "      \"time_unit\": \"ns\",\n"
+            "      \"bytes_per_second\": %.1f,\n"
+            "      \"allocs_per_op\": %.4f",
+            i ? "," : "",
+            r.kernel.c_str(), r.corpus.c_str(),
+            r.kernel.c_str(), r.corpus.c_str(),
+            static_cast<unsigned long long>(
+                r.iterations),
+            static_cast<unsigned long long>(
+                r.ops),
+            r.ns_per_op,
+            r.bytes_per_second,
+            r.allocs_per_op);
+        if(opt.perf)
+        {
+            // unavailable counters are null
+            std::fprintf(f, ",\n      \"counters\": {");
+            for(std::size_t j = 0;
+                j < perf_counters::size; ++j)
+            {
+                std::fprintf(f, "%s\n        \"%s\": ",
+                    j ? "," : "", perf_counters::name(j));
+                if(! r.counters.valid[j])
+                    std::fprintf(f, "null");
+                else
+                    std::fprintf(f,
+                        "{ \"per_byte\": %.4f,"
+                        " \"per_label\": %.2f }",
+                        r.per_byte(j), r.per_label(j));
+            }
+            std::fprintf(f, "\n      }");
+        }
+        std::fprintf(f, "\n    }");
+    }
+    std::fprintf(f, "\n  ]\n}\n");
+}
+
+//------------------------------------------------
+
+/** Per-call latencies of one operation over one corpus
+*/
+struct latency_result
+{
+    std::string op;
+    std::string corpus;
+    histogram hist;
+};
+
+/** Time individual calls
+
+    `f(i)` performs one call on input `i`. Inputs
+    are visited round robin until at least one
+    full pass has been made and `min_time` has
+    elapsed, or a million samples are recorded.
+*/
+template<class F>
+latency_result
+measure_latency(
+    std::string op,
+    corpus const& c,
+    options const& opt,
+    tsc_clock const& clk,
+    F&& f)
+{
+    using clock = std::chrono::steady_clock;
+
+    // warm up
+    for(std::size_t i = 0; i < c.size(); ++i)
+        f(i);
+
+    latency_result r;
+    r.op = std::move(op);
+    r.corpus = c.name;
+    auto const begin = clock::now();
+    std::uint64_t n = 0;
+    for(;;)
+    {
+        for(std::size_t i = 0; i < c.size(); ++i)
+        {
+            auto const t0 = clk.start();
+            f(i);
+            auto const t1 = clk.stop();
+            r.hist.record(clk.to_ns(t0, t1));
+        }
+        n += c.size();
+        if(n >= 1000000)
+            break;
+        if(std::chrono::duration<double>(
+                clock::now() - begin).count() >=
+                    opt.min_time)
+            break;
+    }
+    return r;
+}
+
+static double const latency_percentiles[] = {
+    50, 90, 99, 99.9, 99.99 };
+
+inline
+void
+print_latency_header(std::FILE* f)
+{
+    std::fprintf(f, "%-28s %10s", "latency (ns)", "samples");
+    for(auto p : latency_percentiles)
+    {
+        char buf[16];
+        std::snprintf(buf, sizeof(buf), "p%g", p);
+        std::fprintf(f, " %10s", buf);
+    }
+    std::fprintf(f, " %10s\n", "max");
+}
+
+inline
+void
+print_latency(
+    std::FILE* f,
+    latency_result const& r)
+{
+    auto const name = r.op + "/" + r.corpus;
+    std::fprintf(f, "%-28s %10llu",
+        name.c_str(), static_cast<
+            unsigned long long>(r.hist.count()));
+    for(auto p : latency_percentiles)
+        std::fprintf(f, " %10llu", static_cast<
+            unsigned long long>(r.hist.percentile(p)));
+    std::fprintf(f, " %10llu\n", static_cast<
+        unsigned long long>(r.hist.max()));
+}
+
+inline
+void
+print_latency_json(
+    std::FILE* f,
+    std::vector<latency_result> const& v,
+    options const& opt,
+    tsc_clock const& clk)
+{
+    std::fprintf(f,
+        "{\n"
+        "  \"context\": {\n"
+        "    \"library\": \"boost_punycode\",\n"
+        "    \"min_time\": %g,\n"
+        "    \"clock\": \"%s\",\n"
+        "    \"ns_per_tick\": %.6f\n"
+        "  },\n"
+        "  \"latencies\": [",
+        opt.min_time,
+        tsc_clock::source(),
+        clk.ns_per_tick());
+    for(std::size_t i = 0; i < v.size(); ++i)
+    {
+        auto const& r = v[i];
+        std::fprintf(f,
+            "%s\n"
+            "    {\n"
+            "      \"name\": \"%s/%s\",\n"
+            "      \"op\": \"%s\",\n"
+            "      \"corpus\": \"%s\",\n"
+            "      \"samples\": %llu,\n"
+            "      \"time_unit\": \"ns\",\n"
+            "      \"min\": %llu,\n"
+            "      \"mean\": %.1f,\n",
+            i ? "," : "",
+            r.op.c_str(), r.corpus.c_str(),
+            r.op.c_str(), r.corpus.c_str(),
+            static_cast<unsigned long long>(
+                r.hist.count()),
+            static_cast<unsigned long long>(
+                r.hist.min()),
+            r.hist.mean());
+        for(auto p : latency_percentiles)
+        {
+            char buf[16];
+            std::snprintf(buf, sizeof(buf), "p%g", p);
+            std::fprintf(f,
+                "      \"%s\": %llu,\n", buf,
+                static_cast<unsigned long long>(
+                    r.hist.percentile(p)));
+        }
+        std::fprintf(f,
+            "      \"max\": %llu\n"
+            "    }",
+            static_cast<unsigned long long>(
+                r.hist.max()));
+    }
+    std::fprintf(f, "\n  ]\n}\n");
+}
+
+} // bench
+} // punycode
+} // boost
+
+#endif
@@ -0,0 +1,334 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#ifndef BOOST_PUNYCODE_BENCH_CORPUS_HPP
+#define BOOST_PUNYCODE_BENCH_CORPUS_HPP
+
+#include <boost/punycode/ascii_count.hpp>
+#include <boost/punycode/idna.hpp>
+#include <boost/punycode/punycode.hpp>
+#include <boost/punycode/transcode.hpp>
+#include <boost/punycode/utf16_output.hpp>
+#include <boost/punycode/utf8_output.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace punycode {
+namespace bench {
+
+/** A small deterministic PRNG
+
+    Corpora are generated from a fixed seed so
+    every host benchmarks exactly the same bytes.
+*/
+class xorshift
+{
+    std::uint64_t s_;
+
+public:
+    explicit
+    xorshift(std::uint64_t seed) noexcept
+        : s_(seed ? seed : 0x9e3779b97f4a7c15)
+    {
+    }
+
+    std::uint32_t
+    operator()() noexcept
+    {
+        s_ ^= s_ << 13;
+        s_ ^= s_ >> 7;
+        s_ ^= s_ << 17;
+        return static_cast<
+            std::uint32_t>(s_ >> 32);
+    }
+
+    // uniform in [0, n)
+    std::uint32_t
+    operator()(std::uint32_t n) noexcept
+    {
+        return static_cast<std::uint32_t>(
+            (static_cast<std::uint64_t>(
+                (*this)()) * n) >> 32);
+    }
+};
+
+/** A named set of inputs in every form the kernels need
+*/
+struct corpus
+{
+    std::string name;
+    std::vector<std::string> utf8;
+    std::vector<std::u16string> utf16;
+    std::vector<std::u32string> utf32;
+    std::vector<std::string> puny;
+
+    // the IDNA of each input
+    std::vector<std::string> idna;
+
+    // total utf8 bytes, used for bytes/sec
+    std::size_t bytes = 0;
+
+    // total dot-separated labels
+    std::size_t labels = 0;
+
+    // true if any input needs punycode
+    bool has_non_ascii = false;
+
+    std::size_t
+    size() const noexcept
+    {
+        return utf8.size();
+    }
+};
+
+//------------------------------------------------
+
+namespace detail {
+
+struct cp_range
+{
+    char32_t first;
+    char32_t last;
+};
+
+// pick a range, then a code point within it
+inline
+char32_t
+pick(
+    xorshift& rng,
+    cp_range const* r,
+    std::size_t n)
+{
+    auto const& e = r[rng(
+        static_cast<std::uint32_t>(n))];
+    return e.first + rng(e.last - e.first + 1);
+}
+
+template<std::size_t N>
+char32_t
+pick(
+    xorshift& rng,
+    cp_range const (&r)[N])
+{
+    return pick(rng, r, N);
+}
+
+inline
+std::string
+to_utf8(std::u32string const& s)
+{
+    std::string out;
+    out.resize(utf8_length(s.data(), s.size()));
+    utf8_output(&out[0], &out[0] + out.size())
+        .write(s.data(), s.size());
+    return out;
+}
+
+inline
+std::u16string
+to_utf16(std::u32string const& s)
+{
+    std::u16string out(2 * s.size(), u'\0');
+    auto const it = std::copy(s.begin(), s.end(),
+        utf16_output(&out[0], &out[0] + out.size()));
+    out.resize(it.base() - &out[0]);
+    return out;
+}
+
+inline
+std::string
+to_puny(std::u32string const& s)
+{
+    std::string out;
+    out.resize(punycode::encode(
+        ascii_count(), s.begin(), s.end()).count());
+    punycode::encode(&out[0], s.begin(), s.end());
+    return out;
+}
+
+inline
+std::size_t
+puny_size(std::u32string const& s)
+{
+    return punycode::encode(
+        ascii_count(), s.begin(), s.end()).count();
+}
+
+static cp_range const ldh[] = {
+    { 'a', 'z' }, { 'a', 'z' }, { '0', '9' } };
+static cp_range const latin[] = {
+    { 'a', 'z' }, { 'a', 'z' }, { 'a', 'z' },
+    { 0x00E0, 0x00F6 }, { 0x00F8, 0x00FF },
+    { 0x0101, 0x0101 }, { 0x010D, 0x010D },
+    { 0x0119, 0x0119 }, { 0x0142, 0x0142 },
+    { 0x0161, 0x0161 }, { 0x017E, 0x017E } };
+static cp_range const cyrillic[] = {
+    { 0x0430, 0x044F } };
+static cp_range const cjk[] = {
+    { 0x4E00, 0x9FFF } };
+static cp_range const arabic[] = {
+    { 0x0627, 0x064A } };
+static cp_range const emoji[] = {
+    { 0x1F300, 0x1F5FF }, { 0x1F600, 0x1F64F } };
+// without Arabic, since a label which mixes
+// it with the others breaks the bidi rule
+static cp_range const mixed[] = {
+    { 'a', 'z' }, { 0x00E0, 0x00F6 },
+    { 0x0430, 0x044F }, { 0x4E00, 0x9FFF },
+    { 0x1F600, 0x1F64F } };
+
+inline
+std::u32string
+make_label(
+    xorshift& rng,
+    cp_range const* r,
+    std::size_t nr,
+    std::size_t min_len,
+    std::size_t max_len)
+{
+    std::u32string s;
+    auto const n = min_len + rng(
+        static_cast<std::uint32_t>(
+            max_len - min_len + 1));
+    for(std::size_t i = 0; i < n; ++i)
+        s.push_back(pick(rng, r, nr));
+    return s;
+}
+
+static char const* const tlds[] = {
+    "com", "org", "net", "de", "ru", "jp", "io" };
+
+// a single label whose ACE form is exactly
+// 63 octets, the largest a DNS label can be
+template<std::size_t N>
+std::u32string
+make_max_label(
+    xorshift& rng,
+    cp_range const (&r)[N])
+{
+    std::u32string s;
+    for(;;)
+    {
+        auto const cp = pick(rng, r, N);
+        s.push_back(cp);
+        auto const n = puny_size(s) + 4;
+        if(n == 63)
+            return s;
+        if(n > 63)
+        {
+            s.pop_back();
+            // top off with ascii, one octet each
+            while(puny_size(s) + 4 < 63)
+                s.insert(s.begin(), U'a' +
+                    static_cast<char32_t>(rng(26)));
+            if(puny_size(s) + 4 == 63)
+                return s;
+            s.clear();
+        }
+    }
+}
+
+inline
+void
+add(corpus& c, std::u32string s)
+{
+    if(std::any_of(s.begin(), s.end(),
+        [](char32_t cp) { return cp >= 0x80; }))
+        c.has_non_ascii = true;
+    c.utf8.push_back(to_utf8(s));
+    c.utf16.push_back(to_utf16(s));
+    c.puny.push_back(to_puny(s));
+    c.idna.push_back(utf8_to_idna(
+        c.utf8.back()).value());
+    c.bytes += c.utf8.back().size();
+    c.labels += 1 + std::count(
+        s.begin(), s.end(), U'.');
+    c.utf32.push_back(std::move(s));
+}
+
+} // detail
+
+//------------------------------------------------
+
+/** Return the standard benchmark corpora
+
+    Every corpus is rebuilt from the same seed,
+    so results are comparable across runs and hosts.
+*/
+inline
+std::vector<corpus>
+make_corpora()
+{
+    using namespace detail;
+
+    std::size_t const n = 256;
+    std::vector<corpus> v;
+    auto const domains =
+        [&](char const* name,
+            cp_range const* r,
+            std::size_t nr,
+            std::size_t min_len,
+            std::size_t max_len)
+        {
+            xorshift rng(v.size() + 1);
+            corpus c;
+            c.name = name;
+            for(std::size_t i = 0; i < n; ++i)
+            {
+                auto s = make_label(
+                    rng, r, nr, min_len, max_len);
+                s.push_back('.');
+                for(auto p = tlds[rng(7)]; *p; ++p)
+                    s.push_back(static_cast<
+                        unsigned char>(*p));
+                add(c, std::move(s));
+            }
+            v.push_back(std::move(c));
+        };
+
+    domains("ascii", ldh, 3, 4, 16);
+    domains("latin", latin, 11, 4, 16);
+    domains("cyrillic", cyrillic, 1, 4, 16);
+    domains("cjk", cjk, 1, 2, 8);
+    domains("arabic", arabic, 1, 4, 16);
+    domains("emoji", emoji, 2, 1, 6);
+    domains("mixed", mixed, 5, 4, 16);
+
+    {
+        xorshift rng(v.size() + 1);
+        corpus c;
+        c.name = "max_label";
+        for(std::size_t i = 0; i < n; ++i)
+            add(c, make_max_label(rng, mixed));
+        v.push_back(std::move(c));
+    }
+
+    {
+        // not a host name: no dots, no length
+        // limits, mixed scripts throughout
+        xorshift rng(v.size() + 1);
+        corpus c;
+        c.name = "long";
+        for(std::size_t i = 0; i < 16; ++i)
+            add(c, make_label(rng,
+                mixed, 5, 2048, 4096));
+        v.push_back(std::move(c));
+    }
+
+    return v;
+}
+
+} // bench
+} // punycode
+} // boost
+
+#endif
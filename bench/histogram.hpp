@@ -0,0 +1,164 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#ifndef BOOST_PUNYCODE_BENCH_HISTOGRAM_HPP
+#define BOOST_PUNYCODE_BENCH_HISTOGRAM_HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace boost {
+namespace punycode {
+namespace bench {
+
+/** A log-linear histogram in the style of HdrHistogram
+
+    Values below 2^sub_bits are counted exactly.
+    Above that, every power of two is divided into
+    2^(sub_bits-1) equal buckets, so any recorded
+    value is reproduced within 1/64 of itself
+    across the full 64-bit range, in a fixed
+    amount of memory allocated up front.
+*/
+class histogram
+{
+    static constexpr unsigned sub_bits = 7;
+    static constexpr std::uint64_t sub_count =
+        std::uint64_t(1) << sub_bits;
+    static constexpr std::uint64_t half_count =
+        sub_count / 2;
+
+    std::vector<std::uint64_t> counts_;
+    std::uint64_t total_ = 0;
+    std::uint64_t min_ = UINT64_MAX;
+    std::uint64_t max_ = 0;
+    double sum_ = 0;
+
+    static
+    unsigned
+    log2(std::uint64_t v) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63u - static_cast<unsigned>(
+            __builtin_clzll(v));
+#else
+        unsigned n = 0;
+        while(v >>= 1)
+            ++n;
+        return n;
+#endif
+    }
+
+    static
+    std::size_t
+    index(std::uint64_t v) noexcept
+    {
+        if(v < sub_count)
+            return static_cast<std::size_t>(v);
+        auto const shift = log2(v) - sub_bits + 1;
+        auto const sub = v >> shift;
+        return static_cast<std::size_t>(
+            sub_count +
+            (shift - 1) * half_count +
+            (sub - half_count));
+    }
+
+    // largest value which maps to bucket i
+    static
+    std::uint64_t
+    highest(std::size_t i) noexcept
+    {
+        if(i < sub_count)
+            return i;
+        auto const k = (i - sub_count) / half_count;
+        auto const sub = half_count +
+            (i - sub_count) % half_count;
+        auto const shift = k + 1;
+        return ((sub + 1) << shift) - 1;
+    }
+
+public:
+    histogram()
+        : counts_(index(UINT64_MAX) + 1)
+    {
+    }
+
+    void
+    record(std::uint64_t v) noexcept
+    {
+        ++counts_[index(v)];
+        ++total_;
+        sum_ += static_cast<double>(v);
+        if(v < min_)
+            min_ = v;
+        if(v > max_)
+            max_ = v;
+    }
+
+    std::uint64_t
+    count() const noexcept
+    {
+        return total_;
+    }
+
+    std::uint64_t
+    min() const noexcept
+    {
+        return total_ ? min_ : 0;
+    }
+
+    std::uint64_t
+    max() const noexcept
+    {
+        return max_;
+    }
+
+    double
+    mean() const noexcept
+    {
+        return total_ ? sum_ /
+            static_cast<double>(total_) : 0;
+    }
+
+    /** Return the value at or below which p percent fall
+
+        The result is the upper edge of the bucket
+        which holds the requested rank, clamped to
+        the largest value recorded.
+    */
+    std::uint64_t
+    percentile(double p) const noexcept
+    {
+        if(total_ == 0)
+            return 0;
+        auto rank = static_cast<std::uint64_t>(
+            p / 100.0 * static_cast<double>(total_) + 0.5);
+        if(rank < 1)
+            rank = 1;
+        if(rank > total_)
+            rank = total_;
+        std::uint64_t n = 0;
+        for(std::size_t i = 0; i < counts_.size(); ++i)
+        {
+            n += counts_[i];
+            if(n >= rank)
+            {
+                auto const v = highest(i);
+                return v < max_ ? v : max_;
+            }
+        }
+        return max_;
+    }
+};
+
+} // bench
+} // punycode
+} // boost
+
+#endif
@@ -0,0 +1,189 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#ifndef BOOST_PUNYCODE_BENCH_PERF_COUNTERS_HPP
+#define BOOST_PUNYCODE_BENCH_PERF_COUNTERS_HPP
+
+#include <cstdint>
+
+#if defined(__linux__)
+# include <linux/perf_event.h>
+# include <sys/ioctl.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+# include <cstring>
+#endif
+
+namespace boost {
+namespace punycode {
+namespace bench {
+
+/** Hardware performance counters read around a kernel
+
+    On Linux these come from `perf_event_open`.
+    Each counter is opened on its own, so a host
+    which lacks one event (L1i misses are often
+    missing in VMs) still reports the others.
+    Everywhere else, or when the kernel refuses
+    (see /proc/sys/kernel/perf_event_paranoid),
+    every counter is simply unavailable.
+*/
+class perf_counters
+{
+public:
+    enum : std::size_t
+    {
+        cycles = 0,
+        instructions,
+        branch_misses,
+        l1i_misses,
+        size
+    };
+
+    /** A reading, scaled for multiplexing
+    */
+    struct sample
+    {
+        std::uint64_t value[size] = {};
+        bool valid[size] = {};
+    };
+
+    static
+    char const*
+    name(std::size_t i) noexcept
+    {
+        static char const* const names[size] = {
+            "cycles",
+            "instructions",
+            "branch_misses",
+            "l1i_misses" };
+        return names[i];
+    }
+
+#if defined(__linux__)
+    perf_counters() noexcept
+    {
+        open(cycles, PERF_TYPE_HARDWARE,
+            PERF_COUNT_HW_CPU_CYCLES);
+        open(instructions, PERF_TYPE_HARDWARE,
+            PERF_COUNT_HW_INSTRUCTIONS);
+        open(branch_misses, PERF_TYPE_HARDWARE,
+            PERF_COUNT_HW_BRANCH_MISSES);
+        open(l1i_misses, PERF_TYPE_HW_CACHE,
+            PERF_COUNT_HW_CACHE_L1I |
+            (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+    }
+
+    ~perf_counters()
+    {
+        for(auto fd : fd_)
+            if(fd != -1)
+                ::close(fd);
+    }
+
+    perf_counters(perf_counters const&) = delete;
+    perf_counters& operator=(perf_counters const&) = delete;
+
+    bool
+    available() const noexcept
+    {
+        for(auto fd : fd_)
+            if(fd != -1)
+                return true;
+        return false;
+    }
+
+    void
+    start() noexcept
+    {
+        for(auto fd : fd_)
+        {
+            if(fd == -1)
+                continue;
+            ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    sample
+    stop() noexcept
+    {
+        for(auto fd : fd_)
+            if(fd != -1)
+                ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        sample s;
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            if(fd_[i] == -1)
+                continue;
+            // value, time enabled, time running
+            std::uint64_t buf[3];
+            if(::read(fd_[i], buf, sizeof(buf)) !=
+                    static_cast<ssize_t>(sizeof(buf)) ||
+                buf[2] == 0)
+                continue;
+            double v = static_cast<double>(buf[0]);
+            if(buf[2] < buf[1])
+                v = v * static_cast<double>(buf[1]) /
+                    static_cast<double>(buf[2]);
+            s.value[i] = static_cast<std::uint64_t>(v);
+            s.valid[i] = true;
+        }
+        return s;
+    }
+
+private:
+    void
+    open(
+        std::size_t i,
+        std::uint32_t type,
+        std::uint64_t config) noexcept
+    {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format =
+            PERF_FORMAT_TOTAL_TIME_ENABLED |
+            PERF_FORMAT_TOTAL_TIME_RUNNING;
+        fd_[i] = static_cast<int>(::syscall(
+            __NR_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    int fd_[size] = { -1, -1, -1, -1 };
+#else
+    bool
+    available() const noexcept
+    {
+        return false;
+    }
+
+    void
+    start() noexcept
+    {
+    }
+
+    sample
+    stop() noexcept
+    {
+        return {};
+    }
+#endif
+};
+
+} // bench
+} // punycode
+} // boost
+
+#endif
@@ -0,0 +1,154 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#ifndef BOOST_PUNYCODE_BENCH_TSC_CLOCK_HPP
+#define BOOST_PUNYCODE_BENCH_TSC_CLOCK_HPP
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+# include <intrin.h>
+# define BOOST_PUNYCODE_BENCH_HAS_TSC
+#elif (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+# include <x86intrin.h>
+# define BOOST_PUNYCODE_BENCH_HAS_TSC
+#endif
+
+namespace boost {
+namespace punycode {
+namespace bench {
+
+/** A low-overhead clock for timing single calls
+
+    On x86 this reads the time stamp counter,
+    fenced so that the timed work cannot drift
+    outside the interval. Ticks are converted to
+    nanoseconds with a ratio calibrated against
+    the steady clock. Other targets fall back to
+    the steady clock, and one tick is one ns.
+*/
+class tsc_clock
+{
+    double ns_per_tick_ = 1;
+    std::uint64_t overhead_ = 0;
+
+public:
+    tsc_clock() noexcept
+    {
+        calibrate();
+    }
+
+    static
+    char const*
+    source() noexcept
+    {
+#ifdef BOOST_PUNYCODE_BENCH_HAS_TSC
+        return "tsc";
+#else
+        return "steady_clock";
+#endif
+    }
+
+    /** Read the clock before the timed work
+    */
+    static
+    std::uint64_t
+    start() noexcept
+    {
+#ifdef BOOST_PUNYCODE_BENCH_HAS_TSC
+        _mm_lfence();
+        auto const t = __rdtsc();
+        _mm_lfence();
+        return t;
+#else
+        return now_ns();
+#endif
+    }
+
+    /** Read the clock after the timed work
+    */
+    static
+    std::uint64_t
+    stop() noexcept
+    {
+#ifdef BOOST_PUNYCODE_BENCH_HAS_TSC
+        unsigned aux;
+        auto const t = __rdtscp(&aux);
+        _mm_lfence();
+        return t;
+#else
+        return now_ns();
+#endif
+    }
+
+    /** Return the elapsed nanoseconds, less the clock's own cost
+    */
+    std::uint64_t
+    to_ns(
+        std::uint64_t t0,
+        std::uint64_t t1) const noexcept
+    {
+        auto d = t1 - t0;
+        d = d > overhead_ ? d - overhead_ : 0;
+        return static_cast<std::uint64_t>(
+            static_cast<double>(d) * ns_per_tick_ + 0.5);
+    }
+
+    double
+    ns_per_tick() const noexcept
+    {
+        return ns_per_tick_;
+    }
+
+private:
+    static
+    std::uint64_t
+    now_ns() noexcept
+    {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<
+                std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().
+                        time_since_epoch()).count());
+    }
+
+    void
+    calibrate() noexcept
+    {
+        // smallest back-to-back reading
+        overhead_ = UINT64_MAX;
+        for(int i = 0; i < 1000; ++i)
+        {
+            auto const t0 = start();
+            auto const t1 = stop();
+            if(t1 - t0 < overhead_)
+                overhead_ = t1 - t0;
+        }
+#ifdef BOOST_PUNYCODE_BENCH_HAS_TSC
+        auto const c0 = now_ns();
+        auto const t0 = start();
+        while(now_ns() - c0 < 50000000)
+        {
+        }
+        auto const c1 = now_ns();
+        auto const t1 = stop();
+        ns_per_tick_ =
+            static_cast<double>(c1 - c0) /
+            static_cast<double>(t1 - t0);
+#endif
+    }
+};
+
+} // bench
+} // punycode
+} // boost
+
+#endif
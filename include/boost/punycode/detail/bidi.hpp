@@ -0,0 +1,179 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#ifndef BOOST_PUNYCODE_DETAIL_BIDI_HPP
+#define BOOST_PUNYCODE_DETAIL_BIDI_HPP
+
+#include <boost/punycode/detail/config.hpp>
+
+namespace boost {
+namespace punycode {
+namespace detail {
+
+//------------------------------------------------
+//
+// The Bidi Rule
+//
+// https://datatracker.ietf.org/doc/html/rfc5893
+//
+
+// the bidi classes the rule tells apart
+enum bidi_class : unsigned char
+{
+    bidi_l = 0,
+    bidi_r,
+    bidi_al,
+    bidi_an,
+    bidi_en,
+    bidi_es,
+    bidi_cs,
+    bidi_et,
+    bidi_on,
+    bidi_bn,
+    bidi_nsm,
+
+    // B, S, WS and the explicit
+    // formatting classes
+    bidi_other
+};
+
+/** Return the bidi class of a code point
+*/
+BOOST_PUNYCODE_DECL
+unsigned
+bidi_class_lookup(char32_t cp) noexcept;
+
+inline
+unsigned
+get_bidi_class(char32_t cp) noexcept
+{
+    // most of a host name is
+    // letters, digits and hyphens
+    if((cp | 0x20) - 'a' < 26u)
+        return bidi_l;
+    if(cp - '0' < 10u)
+        return bidi_en;
+    if(cp == '-')
+        return bidi_es;
+    return bidi_class_lookup(cp);
+}
+
+constexpr
+unsigned
+bidi_bit(unsigned c) noexcept
+{
+    return 1u << c;
+}
+
+/*  The rule is checked as the code points of
+    each label go by, keeping the set of classes
+    seen and the first and last ones. It only
+    applies to a domain with an RTL label, one
+    with a character of class R, AL or AN, so
+    the result is known once every label is.
+    Empty labels are passed over.
+*/
+class bidi_rule
+{
+    static constexpr unsigned rtl_classes =
+        bidi_bit(bidi_r) |
+        bidi_bit(bidi_al) |
+        bidi_bit(bidi_an);
+
+    // allowed in either direction
+    static constexpr unsigned neutral =
+        bidi_bit(bidi_en) |
+        bidi_bit(bidi_es) |
+        bidi_bit(bidi_cs) |
+        bidi_bit(bidi_et) |
+        bidi_bit(bidi_on) |
+        bidi_bit(bidi_bn) |
+        bidi_bit(bidi_nsm);
+
+    // classes in the label so far
+    unsigned seen_ = 0;
+    unsigned char first_ = bidi_other;
+    // the last class other than NSM
+    unsigned char last_ = bidi_other;
+
+    // the domain has an RTL label, and
+    // a label which breaks the rule
+    bool rtl_ = false;
+    bool bad_ = false;
+
+    bool
+    label_ok() const noexcept
+    {
+        unsigned const last = bidi_bit(last_);
+        switch(first_)
+        {
+        case bidi_l:
+            // rules 5 and 6
+            return
+                (seen_ & ~(neutral |
+                    bidi_bit(bidi_l))) == 0 &&
+                (last & (bidi_bit(bidi_l) |
+                    bidi_bit(bidi_en))) != 0;
+
+        case bidi_r:
+        case bidi_al:
+            // rules 2, 3 and 4
+            return
+                (seen_ & ~(neutral |
+                    rtl_classes)) == 0 &&
+                (last & (rtl_classes |
+                    bidi_bit(bidi_en))) != 0 &&
+                (~seen_ & (bidi_bit(bidi_en) |
+                    bidi_bit(bidi_an))) != 0;
+
+        default:
+            // rule 1
+            return false;
+        }
+    }
+
+public:
+    void
+    push(char32_t cp) noexcept
+    {
+        auto const c = get_bidi_class(cp);
+        if(seen_ == 0)
+            first_ = static_cast<unsigned char>(c);
+        seen_ |= bidi_bit(c);
+        if(c != bidi_nsm)
+            last_ = static_cast<unsigned char>(c);
+    }
+
+    void
+    end_label() noexcept
+    {
+        if(seen_ == 0)
+            return;
+        if(seen_ & rtl_classes)
+            rtl_ = true;
+        if(! bad_ && ! label_ok())
+            bad_ = true;
+        seen_ = 0;
+        last_ = bidi_other;
+    }
+
+    // true if the labels ended so far
+    // are a domain which breaks the rule
+    bool
+    failed() const noexcept
+    {
+        return rtl_ && bad_;
+    }
+};
+
+} // detail
+} // punycode
+} // boost
+
+#endif
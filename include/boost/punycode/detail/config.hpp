@@ -44,6 +44,17 @@ namespace punycode {
 
 //------------------------------------------------
 
+// Upper limit on the length of an input accepted
+// by encode, decode, and utf8_to_idna. Encoding is
+// quadratic in the number of distinct code points,
+// so callers fed untrusted strings may set this to
+// bound the work done per call. Zero means no limit.
+#ifndef BOOST_PUNYCODE_MAX_INPUT_LENGTH
+# define BOOST_PUNYCODE_MAX_INPUT_LENGTH 0
+#endif
+
+//------------------------------------------------
+
 // source location
 #ifdef BOOST_PUNYCODE_NO_SOURCE_LOCATION
 # define BOOST_PUNYCODE_POS ::boost::source_location()
@@ -0,0 +1,34 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#ifndef BOOST_PUNYCODE_DETAIL_IDNA_CLASSIFY_HPP
+#define BOOST_PUNYCODE_DETAIL_IDNA_CLASSIFY_HPP
+
+#include <boost/punycode/detail/config.hpp>
+#include <boost/punycode/detail/simd.hpp>
+#include <boost/core/detail/string_view.hpp>
+
+namespace boost {
+namespace punycode {
+namespace detail {
+
+// idna_classify with an explicit instruction
+// set, which is lowered to what the processor
+// has. Tests use it to check every kernel.
+BOOST_PUNYCODE_DECL
+unsigned
+idna_classify(
+    core::string_view domain,
+    simd_level level) noexcept;
+
+} // detail
+} // punycode
+} // boost
+
+#endif
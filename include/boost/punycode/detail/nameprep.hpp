@@ -0,0 +1,483 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#ifndef BOOST_PUNYCODE_DETAIL_NAMEPREP_HPP
+#define BOOST_PUNYCODE_DETAIL_NAMEPREP_HPP
+
+#include <boost/punycode/detail/config.hpp>
+#include <boost/punycode/detail/stringprep_b2.hpp>
+#include <boost/assert.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+namespace boost {
+namespace punycode {
+namespace detail {
+
+//------------------------------------------------
+//
+// NAMEPREP
+//
+// https://datatracker.ietf.org/doc/html/rfc3491
+//
+
+/*  NFKC is applied a segment at a time. A segment
+    starts at a code point which is NFKC_QC Yes with
+    a combining class of zero, which nothing before
+    it can combine with, and runs to the next one.
+    A segment which passes the quick check is passed
+    through; any other is normalized on its own.
+
+    Segments are bounded, as the Stream-Safe Text
+    Format of UAX #15 bounds them: one which would
+    be longer than nameprep_segment_size once
+    decomposed is split, and each part normalized.
+    Only runs of some 30 combining marks are long
+    enough to see it.
+*/
+
+// most code points held by a segment,
+// once it is decomposed
+constexpr std::size_t nameprep_segment_size = 32;
+
+/** Return true if a code point of nameprep output ends a label
+
+    Labels are split after nameprep, which maps
+    characters such as U+FF0E to a dot. RFC 3490
+    takes U+3002, U+FF0E and U+FF61 as dots too,
+    and nameprep maps the last two to '.' and to
+    U+3002.
+*/
+constexpr
+bool
+is_label_dot(char32_t cp) noexcept
+{
+    return cp == '.' || cp == 0x3002;
+}
+
+/** Return the NFKC data of a code point
+
+    This is from Unicode 3.2, which nameprep
+    uses: the combining class in bits 0-7, bit 8
+    when NFKC_Quick_Check is not Yes, the size
+    of the full decomposition in bits 9-13, or
+    zero if there is none, and bit 14 when the
+    NFKC has a character of tables C.1.2, C.2.2
+    or C.3 to C.9 of RFC 3454, which RFC 3491
+    prohibits.
+*/
+BOOST_PUNYCODE_DECL
+std::uint32_t
+nameprep_nfkc_lookup(char32_t cp) noexcept;
+
+/** Normalize a segment to NFKC in place
+
+    The segment must fit in
+    nameprep_segment_size code points once
+    decomposed, and so must the storage at p.
+    Returns the new size.
+*/
+BOOST_PUNYCODE_DECL
+std::size_t
+nameprep_nfkc(
+    char32_t* p,
+    std::size_t n) noexcept;
+
+/** Return true if a code point is unassigned in Unicode 3.2, or prohibited
+
+    These are the code points of table A.1 of
+    RFC 3454 and those nameprep prohibits, one
+    lookup in a two stage bitset.
+*/
+BOOST_PUNYCODE_DECL
+bool
+nameprep_unassigned(char32_t cp) noexcept;
+
+class nameprep_iterator_base
+{
+protected:
+    // code points from the mapping of
+    // one input, in reverse order
+    char32_t cp_[4];
+    unsigned char m_ = 0;
+
+    // the segment being read
+    char32_t seg_[nameprep_segment_size];
+    unsigned char n_ = 0;
+    unsigned char pos_ = 0;
+
+    // the first code point of the next
+    // segment, once it has been mapped
+    char32_t next_ = 0;
+    std::uint32_t next_v_ = 0;
+    bool has_next_ = false;
+
+    // input stopped at a prohibited code point
+    bool prohibited_ = false;
+
+    // unassigned code points are prohibited
+    bool reject_unassigned_ = false;
+
+    // the number of input code points read
+    std::size_t read_ = 0;
+
+    static constexpr bool
+    map_to_nothing(char32_t cp) noexcept;
+
+    static
+    std::uint32_t
+    nfkc_data(char32_t cp) noexcept
+    {
+        // ascii is neither changed
+        // nor prohibited
+        if(cp < 0x80)
+            return 0;
+        return nameprep_nfkc_lookup(cp);
+    }
+
+    static
+    bool
+    is_prohibited(std::uint32_t v) noexcept
+    {
+        return (v & 0x4000) != 0;
+    }
+
+    // true if a segment starts at a code
+    // point with this data
+    static
+    bool
+    is_boundary(std::uint32_t v) noexcept
+    {
+        return (v & 0x1ff) == 0;
+    }
+
+    // size of the full decomposition
+    static
+    std::size_t
+    decomposed_size(std::uint32_t v) noexcept
+    {
+        auto const n = (v >> 9) & 0x1f;
+        return n ? n : 1;
+    }
+
+    struct writer
+    {
+        nameprep_iterator_base& self;
+
+        void operator()(
+            char32_t cp) noexcept
+        {
+            self.cp_[0] = cp;
+            self.m_ = 1;
+        }
+
+        void operator()(
+            char32_t cp0,
+            char32_t cp1) noexcept
+        {
+            self.cp_[1] = cp0;
+            self.cp_[0] = cp1;
+            self.m_ = 2;
+        }
+
+        void operator()(
+            char32_t cp0,
+            char32_t cp1,
+            char32_t cp2) noexcept
+        {
+            self.cp_[2] = cp0;
+            self.cp_[1] = cp1;
+            self.cp_[0] = cp2;
+            self.m_ = 3;
+        }
+
+        void operator()(
+            char32_t cp0,
+            char32_t cp1,
+            char32_t cp2,
+            char32_t cp3) noexcept
+        {
+            self.cp_[3] = cp0;
+            self.cp_[2] = cp1;
+            self.cp_[1] = cp2;
+            self.cp_[0] = cp3;
+            self.m_ = 4;
+        }
+    };
+};
+
+//------------------------------------------------
+
+// https://datatracker.ietf.org/doc/html/rfc3454#appendix-B.1
+constexpr bool
+nameprep_iterator_base::
+map_to_nothing(char32_t cp) noexcept
+{
+    switch(cp)
+    {
+    case 0x00AD:
+    case 0x034F:
+    case 0x1806:
+    case 0x180B:
+    case 0x180C:
+    case 0x180D:
+    case 0x200B:
+    case 0x200C:
+    case 0x200D:
+    case 0x2060:
+    case 0xFE00:
+    case 0xFE01:
+    case 0xFE02:
+    case 0xFE03:
+    case 0xFE04:
+    case 0xFE05:
+    case 0xFE06:
+    case 0xFE07:
+    case 0xFE08:
+    case 0xFE09:
+    case 0xFE0A:
+    case 0xFE0B:
+    case 0xFE0C:
+    case 0xFE0D:
+    case 0xFE0E:
+    case 0xFE0F:
+    case 0xFEFF:
+        return true;
+    default:
+        break;
+    }
+    return false;
+}
+
+//------------------------------------------------
+
+/** Iterate over a utf32 sequence, applying nameprep.
+
+    This is the mapping of B.1 and B.2 followed
+    by normalization to NFKC. A prohibited code
+    point ends the sequence early, which
+    prohibited() then reports.
+*/
+template<class InputIt>
+class nameprep_iterator
+    : private nameprep_iterator_base
+{
+    // VFALCO typecheck on InputIt
+
+    InputIt it_;
+    InputIt end_; // VFALCO only needed for debug?
+
+public:
+    using value_type        = char32_t;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = value_type const*;
+    using reference         = value_type const&;
+    using iterator_category =
+        std::forward_iterator_tag;
+
+    nameprep_iterator(nameprep_iterator const&) = default;
+    nameprep_iterator& operator=(nameprep_iterator const&) = default;
+
+    nameprep_iterator() = default;
+
+    nameprep_iterator(
+        InputIt it,
+        InputIt end,
+        bool allow_unassigned = true)
+        : it_(it)
+        , end_(end)
+    {
+        reject_unassigned_ = ! allow_unassigned;
+        get();
+    }
+
+    explicit
+    nameprep_iterator(
+        InputIt end)
+        : it_(end)
+        , end_(end)
+    {
+    }
+
+    bool
+    operator==(
+        nameprep_iterator const& other) const noexcept
+    {
+        BOOST_ASSERT(end_ == other.end_);
+        return
+            it_ == other.it_ &&
+            m_ == other.m_ &&
+            has_next_ == other.has_next_ &&
+            n_ == other.n_ &&
+            pos_ == other.pos_;
+    }
+
+    bool
+    operator!=(
+        nameprep_iterator const& other) const noexcept
+    {
+        return ! (*this == other);
+    }
+
+    char32_t
+    operator*() const noexcept
+    {
+        BOOST_ASSERT(pos_ < n_);
+        return seg_[pos_];
+    }
+
+    nameprep_iterator&
+    operator++()
+    {
+        BOOST_ASSERT(pos_ < n_);
+        if(++pos_ < n_)
+            return *this;
+        get();
+        return *this;
+    }
+
+    nameprep_iterator
+    operator++(int)
+    {
+        auto tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    // true if the input has a code point
+    // nameprep prohibits, where it stopped
+    bool
+    prohibited() const noexcept
+    {
+        return prohibited_;
+    }
+
+    // the index of the input code point
+    // where it stopped, if prohibited()
+    std::size_t
+    prohibited_index() const noexcept
+    {
+        BOOST_ASSERT(prohibited_);
+        return read_ - 1;
+    }
+
+    // true at the end of the output, which
+    // is cheaper than comparing to the end
+    bool
+    done() const noexcept
+    {
+        return pos_ == n_;
+    }
+
+private:
+    // the next code point after mapping
+    bool
+    map(char32_t& cp)
+    {
+        if(m_ > 0)
+        {
+            cp = cp_[--m_];
+            return true;
+        }
+        while(it_ != end_)
+        {
+            auto const c = *it_;
+            ++it_;
+            ++read_;
+            if( reject_unassigned_ && c >= 0x80 &&
+                nameprep_unassigned(c))
+            {
+                // past the code space,
+                // which is prohibited
+                cp = 0x110000;
+                return true;
+            }
+            if(map_to_nothing(c))
+                continue;
+            stringprep_b2(c, writer{*this});
+            cp = cp_[--m_];
+            return true;
+        }
+        return false;
+    }
+
+    // end at a prohibited code point,
+    // as at the end of the input
+    void
+    stop()
+    {
+        prohibited_ = true;
+        it_ = end_;
+        m_ = 0;
+        n_ = 0;
+    }
+
+    // read and normalize the next segment
+    void
+    get()
+    {
+        pos_ = 0;
+        n_ = 0;
+        char32_t cp;
+        std::uint32_t v;
+        if(has_next_)
+        {
+            cp = next_;
+            v = next_v_;
+            has_next_ = false;
+        }
+        else if(map(cp))
+        {
+            v = nfkc_data(cp);
+        }
+        else
+        {
+            return;
+        }
+        if(is_prohibited(v))
+            return stop();
+
+        bool stable = (v & 0x100) == 0;
+        unsigned last = v & 0xff;
+        std::size_t size = decomposed_size(v);
+        seg_[n_++] = cp;
+        while(map(cp))
+        {
+            v = nfkc_data(cp);
+            if(is_prohibited(v))
+                return stop();
+            auto const more = decomposed_size(v);
+            if( is_boundary(v) ||
+                size + more > nameprep_segment_size)
+            {
+                next_ = cp;
+                next_v_ = v;
+                has_next_ = true;
+                break;
+            }
+            unsigned const ccc = v & 0xff;
+            if( (v & 0x100) ||
+                (ccc != 0 && last > ccc))
+                stable = false;
+            last = ccc;
+            size += more;
+            seg_[n_++] = cp;
+        }
+        if(! stable)
+            n_ = static_cast<unsigned char>(
+                nameprep_nfkc(seg_, n_));
+    }
+};
+
+} // detail
+} // punycode
+} // boost
+
+#endif
@@ -0,0 +1,43 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#ifndef BOOST_PUNYCODE_DETAIL_SIMD_HPP
+#define BOOST_PUNYCODE_DETAIL_SIMD_HPP
+
+#include <boost/punycode/detail/config.hpp>
+
+namespace boost {
+namespace punycode {
+namespace detail {
+
+// instruction sets the bulk kernels are built for,
+// in increasing order of capability
+enum class simd_level
+{
+    none,
+    sse4,
+    avx2,
+    avx512
+};
+
+/** Return the best instruction set this processor supports
+
+    The answer is computed once. Defining
+    BOOST_PUNYCODE_NO_SIMD when building the
+    library makes this always return `none`.
+*/
+BOOST_PUNYCODE_DECL
+simd_level
+cpu_simd_level() noexcept;
+
+} // detail
+} // punycode
+} // boost
+
+#endif
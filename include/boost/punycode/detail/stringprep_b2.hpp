@@ -7,8 +7,12 @@
 // Official repository: https://github.com/cppalliance/punycode
 //
 
+#ifndef BOOST_PUNYCODE_DETAIL_STRINGPREP_B2_HPP
+#define BOOST_PUNYCODE_DETAIL_STRINGPREP_B2_HPP
+
 namespace boost {
 namespace punycode {
+namespace detail {
 
 /** B.2 Mapping for case-folding used with NFKC
 
@@ -1399,6 +1403,8 @@ case 0x1D7BB: return f(0x03C3); // Additional folding
     }
 }
 
+} // detail
 } // punycode
 } // boost
 
+#endif
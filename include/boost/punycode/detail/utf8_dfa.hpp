@@ -0,0 +1,175 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#ifndef BOOST_PUNYCODE_DETAIL_UTF8_DFA_HPP
+#define BOOST_PUNYCODE_DETAIL_UTF8_DFA_HPP
+
+#include <boost/punycode/detail/config.hpp>
+#include <cstdint>
+#include <cstring>
+
+namespace boost {
+namespace punycode {
+namespace detail {
+
+/*  A validating utf8 decoder as a finite automaton,
+    after Bjoern Hoehrmann. Every octet belongs to one
+    of twelve classes, and the class together with the
+    current state selects the next state. States are
+    stored premultiplied by the number of classes, so
+    each transition is a single load.
+
+    Overlong forms, surrogates, values above U+10FFFF
+    and truncated or stray continuation octets all
+    lead to the reject state, which is a sink.
+*/
+template<class = void>
+struct utf8_dfa_tables
+{
+    static constexpr std::uint8_t classes[256] = {
+         0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+         0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+         0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+         0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+         0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+         0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+         0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+         0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+         1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+         9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9, 9,
+         7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+         7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7, 7,
+         8, 8, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+         2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+        10, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 4, 3, 3,
+        11, 6, 6, 6, 5, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8 };
+
+    static constexpr std::uint8_t states[108] = {
+         0, 12, 24, 36, 60, 96, 84, 12, 12, 12, 48, 72,
+        12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+        12,  0, 12, 12, 12, 12, 12,  0, 12,  0, 12, 12,
+        12, 24, 12, 12, 12, 12, 12, 24, 12, 24, 12, 12,
+        12, 12, 12, 12, 12, 12, 12, 24, 12, 12, 12, 12,
+        12, 24, 12, 12, 12, 12, 12, 12, 12, 24, 12, 12,
+        12, 12, 12, 12, 12, 12, 12, 36, 12, 36, 12, 12,
+        12, 36, 12, 12, 12, 12, 12, 36, 12, 36, 12, 12,
+        12, 36, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12 };
+};
+
+template<class T>
+constexpr std::uint8_t utf8_dfa_tables<T>::classes[256];
+
+template<class T>
+constexpr std::uint8_t utf8_dfa_tables<T>::states[108];
+
+// every state part way through a
+// sequence is above utf8_reject
+enum : std::uint32_t
+{
+    utf8_accept = 0,
+    utf8_reject = 12
+};
+
+// advance the automaton by one octet,
+// accumulating the code point in cp
+inline
+std::uint32_t
+utf8_dfa_step(
+    std::uint32_t state,
+    char32_t& cp,
+    unsigned char c) noexcept
+{
+    std::uint32_t const type =
+        utf8_dfa_tables<>::classes[c];
+    cp = state != utf8_accept
+        ? (cp << 6) | (c & 0x3fu)
+        : (0xffu >> type) & c;
+    return utf8_dfa_tables<>::states[state + type];
+}
+
+// true if the eight octets at p are all ascii
+inline
+bool
+utf8_ascii8(
+    unsigned char const* p) noexcept
+{
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return (v & 0x8080808080808080ull) == 0;
+}
+
+/** Decode utf8 in [p, end) to dest
+
+    Returns the number of code points written,
+    or SIZE_MAX if the input is not well-formed.
+    `dest` needs room for `end - p` code points.
+*/
+inline
+std::size_t
+utf8_decode_dfa(
+    unsigned char const* p,
+    unsigned char const* const end,
+    char32_t* const dest) noexcept
+{
+    auto d = dest;
+    std::uint32_t state = utf8_accept;
+    char32_t cp = 0;
+    while(p != end)
+    {
+        if( state == utf8_accept &&
+            end - p >= 8 &&
+            utf8_ascii8(p))
+        {
+            for(int i = 0; i < 8; ++i)
+                *d++ = p[i];
+            p += 8;
+            continue;
+        }
+        state = utf8_dfa_step(state, cp, *p++);
+        if(state == utf8_accept)
+            *d++ = cp;
+        else if(state == utf8_reject)
+            return SIZE_MAX;
+    }
+    if(state != utf8_accept)
+        return SIZE_MAX;
+    return static_cast<std::size_t>(d - dest);
+}
+
+/** Return true if [p, end) is well-formed utf8
+*/
+inline
+bool
+utf8_validate_dfa(
+    unsigned char const* p,
+    unsigned char const* const end) noexcept
+{
+    std::uint32_t state = utf8_accept;
+    char32_t cp = 0;
+    while(p != end)
+    {
+        if( state == utf8_accept &&
+            end - p >= 8 &&
+            utf8_ascii8(p))
+        {
+            p += 8;
+            continue;
+        }
+        state = utf8_dfa_step(state, cp, *p++);
+        if(state == utf8_reject)
+            return false;
+    }
+    return state == utf8_accept;
+}
+
+} // detail
+} // punycode
+} // boost
+
+#endif
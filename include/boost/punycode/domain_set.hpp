@@ -0,0 +1,177 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#ifndef BOOST_PUNYCODE_DOMAIN_SET_HPP
+#define BOOST_PUNYCODE_DOMAIN_SET_HPP
+
+#include <boost/punycode/detail/config.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/system/result.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace boost {
+namespace punycode {
+
+namespace detail {
+struct domain_node;
+} // detail
+
+/** An immutable set of domains, matching hosts and their parents
+
+    Each domain of the set lists itself and every
+    domain below it, so that "example.com" holds
+    "www.example.com" too. A domain which begins
+    with "*." lists only the domains below it.
+    Domains may be in Unicode or in ACE form,
+    and are kept as their IDNA, so that
+    "bücher.de" and "xn--bcher-kva.de" are the
+    same domain.
+
+    The set is a trie of labels, read from the
+    right, laid out level by level in one block
+    of memory, its image. The children of a node
+    are a contiguous table, placed by a hash of
+    their label, so that finding one of them,
+    even among the millions of children of
+    "com", takes a probe or two. The image can
+    be written to a file and used in place, as
+    when the file is mapped into memory, without
+    being built again.
+
+    Default constructed, the set is empty.
+*/
+class domain_set
+{
+    std::shared_ptr<void const> owner_;
+    char const* image_ = nullptr;
+    std::size_t image_size_ = 0;
+    detail::domain_node const* nodes_ = nullptr;
+    char const* pool_ = nullptr;
+    std::size_t size_ = 0;
+
+    BOOST_PUNYCODE_DECL
+    static
+    system::result<domain_set>
+    make(
+        void const* data,
+        std::size_t size,
+        std::shared_ptr<void const> owner);
+
+    BOOST_PUNYCODE_DECL
+    bool
+    match(core::string_view idna) const noexcept;
+
+public:
+    /** Constructor
+
+        The set is empty.
+    */
+    domain_set() = default;
+
+    /** Return a set of domains
+
+        Each of the `n` domains is utf8, and may
+        begin with "*." for a wildcard. A trailing
+        dot is ignored. Domains listed below
+        another domain of the set add nothing, and
+        are left out of the image.
+
+        Fails with `errc::invalid_argument` if a
+        domain has an empty label, or a wildcard
+        other than its first label, and as @ref
+        utf8_to_idna does if a domain has no IDNA.
+        Fails with `errc::value_too_large` if the
+        set would have a node with more than
+        16777215 children, or an image larger
+        than 4GB.
+    */
+    BOOST_PUNYCODE_DECL
+    static
+    system::result<domain_set>
+    build(
+        core::string_view const* domains,
+        std::size_t n);
+
+    /** Return a set using an image in place
+
+        The image is one which @ref image returned.
+        It is checked, but not copied, and must
+        outlive the set and its copies. Its
+        address must be a multiple of 4, as that
+        of a mapped file is.
+
+        Fails with `errc::invalid_argument` if the
+        image is misaligned, or is not a valid
+        image of the same version and byte order.
+    */
+    static
+    system::result<domain_set>
+    from_image(
+        void const* data,
+        std::size_t size)
+    {
+        return make(data, size, nullptr);
+    }
+
+    /** Return a set read from a file
+
+        The file holds an image, which is read
+        whole into memory, and checked as by
+        @ref from_image. Fails with the error of
+        the system if the file cannot be read.
+    */
+    BOOST_PUNYCODE_DECL
+    static
+    system::result<domain_set>
+    load(char const* path);
+
+    /** Return the image of the set
+
+        The image may be written to a file, and
+        the set used again by @ref from_image or
+        @ref load. It is empty for an empty set.
+    */
+    core::string_view
+    image() const noexcept
+    {
+        return core::string_view(
+            image_, image_size_);
+    }
+
+    /// Return the number of domains the set was built from
+    std::size_t
+    size() const noexcept
+    {
+        return size_;
+    }
+
+    /** Return true if a host or any domain above it is in the set
+
+        The host is utf8, in any form. When it is
+        its own IDNA, as an ascii host in lower
+        case is, its labels are matched in place.
+        Otherwise it is converted a label at a time
+        into a buffer on the stack, as by @ref
+        idna_view, so that no memory is allocated.
+        A host without an IDNA, or whose IDNA is
+        longer than the 253 octets of a DNS name,
+        is not contained. A trailing dot is
+        ignored.
+    */
+    BOOST_PUNYCODE_DECL
+    bool
+    contains(core::string_view host) const noexcept;
+};
+
+} // punycode
+} // boost
+
+#endif
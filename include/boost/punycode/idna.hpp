@@ -11,21 +11,304 @@
 #define BOOST_PUNYCODE_IDNA_HPP
 
 #include <boost/punycode/detail/config.hpp>
+#include <boost/punycode/label_info.hpp>
 #include <boost/core/detail/string_view.hpp>
 #include <boost/system/result.hpp>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <vector>
 
 namespace boost {
 namespace punycode {
 
 /** Return an IDNA for the given utf8-encoded domain.
+
+    The result is built in `storage`, which is moved
+    into the returned value. When the capacity of
+    `storage` is at least the size of the result, no
+    memory is allocated; callers converting in a loop
+    can move the result back into their buffer after
+    each call and convert without allocating.
+
+    Fails with `errc::illegal_byte_sequence` if the
+    domain is not well-formed utf8, with
+    `errc::value_too_large` if it, or a label to
+    be encoded after nameprep, is longer than
+    BOOST_PUNYCODE_MAX_INPUT_LENGTH, and with
+    `errc::invalid_argument` if it has a character
+    nameprep prohibits, or has a right-to-left
+    label and breaks the bidi rule of RFC 5893.
+*/
+BOOST_PUNYCODE_DECL
+system::result<std::string>
+utf8_to_idna(
+    core::string_view domain,
+    std::string&& storage = std::string());
+
+/** Options for converting a domain to its IDNA
+*/
+struct idna_options
+{
+    /** Allow code points unassigned in Unicode 3.2
+
+        Queries may have them, as RFC 3490 allows,
+        and stored strings must not. Clearing this
+        rejects them as nameprep rejects the
+        characters it prohibits.
+    */
+    bool allow_unassigned = true;
+};
+
+/** Return an IDNA for the given utf8-encoded domain, or where it fails.
+
+    This converts as @ref utf8_to_idna does,
+    with the given options. When nameprep stops
+    at a code point it prohibits, or which is
+    unassigned and not allowed, the conversion
+    fails with `errc::invalid_argument` and
+    `offset` is set to that of the first octet
+    of the code point, in the same pass.
+    Otherwise `offset` is set to the size of
+    the domain.
+*/
+BOOST_PUNYCODE_DECL
+system::result<std::string>
+utf8_to_idna(
+    core::string_view domain,
+    idna_options const& opt,
+    std::size_t& offset,
+    std::string&& storage = std::string());
+
+/** Return an IDNA for the given utf8-encoded domain, borrowing it if unchanged.
+
+    When the domain is already its own IDNA, as
+    an ascii domain in lower case is, the returned
+    view refers to `domain` and `storage` is left
+    untouched. Otherwise the IDNA is built in
+    `storage` and the view refers to it. Callers
+    can tell the two apart by comparing the data
+    pointer of the view with that of `domain`.
+
+    Fails as @ref utf8_to_idna does.
+*/
+BOOST_PUNYCODE_DECL
+system::result<core::string_view>
+utf8_to_idna_borrowed(
+    core::string_view domain,
+    std::string& storage);
+
+/** Return an IDNA for the given utf8-encoded domain, and the properties of its labels.
+
+    This converts as @ref utf8_to_idna does,
+    and fills `labels` with a @ref label_info for
+    each label of the domain after nameprep, in
+    order, as the same pass goes over them. The
+    scripts of each code point take one table
+    lookup. On failure `labels` is left empty.
 */
 BOOST_PUNYCODE_DECL
 system::result<std::string>
 utf8_to_idna(
     core::string_view domain,
+    std::vector<label_info>& labels,
+    std::string&& storage = std::string());
+
+/** Return an IDNA for the given utf16-encoded domain.
+
+    This reads utf16 directly, without a pass
+    through utf8, and otherwise behaves like
+    @ref utf8_to_idna. Fails with
+    `errc::illegal_byte_sequence` if a surrogate
+    is not part of a pair.
+*/
+BOOST_PUNYCODE_DECL
+system::result<std::string>
+utf16_to_idna(
+    core::u16string_view domain,
     std::string&& storage = std::string());
 
+/** Write the IDNA of a utf8-encoded domain in DNS wire format
+
+    Each label of the IDNA is written after an
+    octet holding its length, and the name ends
+    with the empty root label, as in
+    "\x03www\x0dxn--bcher-kva\x02de\x00". The
+    labels are encoded straight into `dest`, and
+    each length octet is filled in once its
+    label is done. A trailing dot is ignored,
+    and "." is the root. No memory is allocated.
+
+    @return The number of octets written, at
+    most 255. Fails as @ref utf8_to_idna does, and
+    also with `errc::invalid_argument` if a label
+    is empty, with `errc::value_too_large` if a
+    label is longer than 63 octets or the name
+    longer than 255, and with
+    `errc::no_buffer_space` if the name does not
+    fit in `size` octets, which never happens
+    when `size` is at least 255. On failure the
+    contents of `dest` are unspecified.
+*/
+BOOST_PUNYCODE_DECL
+system::result<std::size_t>
+utf8_to_dns_wire(
+    core::string_view domain,
+    char* dest,
+    std::size_t size) noexcept;
+
+/** Properties of a domain, found by @ref idna_classify
+*/
+enum idna_class : unsigned
+{
+    /// An octet is not ascii
+    has_non_ascii   = 1,
+
+    /// An ascii letter is upper case
+    has_upper       = 2,
+
+    /// A label begins with "xn--", in any case
+    has_xn_label    = 4,
+
+    /** The domain is not an LDH host name
+
+        An ascii octet is not a letter, digit,
+        hyphen or dot, a label begins or ends
+        with a hyphen, or a label is empty or
+        longer than 63 octets. The last label
+        may be empty when it is not the only
+        one, as in "example.com.".
+    */
+    has_invalid_ldh = 8
+};
+
+/** Return the @ref idna_class flags of a domain
+
+    The domain is examined in one pass, with the
+    widest vector instructions the processor
+    supports. When the result is zero, the domain
+    is its own IDNA, so that converting it may be
+    skipped. Domains without `has_non_ascii` or
+    `has_upper` are their own IDNA as well, but
+    may not be valid host names.
+*/
+BOOST_PUNYCODE_DECL
+unsigned
+idna_classify(
+    core::string_view domain) noexcept;
+
+/** Return true if two utf8 domains have the same IDNA
+
+    The domains are compared label by label,
+    stopping at the first label which differs.
+    Labels which are both ascii are compared
+    ignoring case, and labels which are both
+    Unicode are compared after nameprep. Only
+    when one label is an ACE label and the other
+    is Unicode is the Unicode one encoded. No
+    memory is allocated.
+
+    A domain which is not well-formed utf8, has
+    a label longer than 63 octets in ACE form or
+    than BOOST_PUNYCODE_MAX_INPUT_LENGTH, has a
+    character nameprep prohibits or breaks the
+    bidi rule, is only equivalent to the same
+    octets.
+*/
+BOOST_PUNYCODE_DECL
+bool
+idna_equivalent(
+    core::string_view a,
+    core::string_view b) noexcept;
+
+/** Return the offset of the first code point nameprep rejects
+
+    Nameprep prohibits the characters of tables
+    C.1.2, C.2.2 and C.3 to C.9 of RFC 3454, such
+    as controls, private use and non-ascii spaces,
+    in its output. The offset is that of the
+    first octet of the first input code point
+    which is, or is mapped to, such a character,
+    or the size of the domain when there is none.
+
+    Stored strings must not have code points
+    unassigned in Unicode 3.2 either, which are
+    rejected too unless `allow_unassigned` is set,
+    as it is for queries. Conversion allows them
+    unless @ref idna_options says otherwise.
+
+    Each code point takes one lookup in a two
+    stage bitset. Fails with
+    `errc::illegal_byte_sequence` if the domain is
+    not well-formed utf8.
+*/
+BOOST_PUNYCODE_DECL
+system::result<std::size_t>
+nameprep_find_prohibited(
+    core::string_view domain,
+    bool allow_unassigned = true) noexcept;
+
+/** Return the confusable skeleton of a utf8-encoded domain
+
+    Domains which look alike have the same
+    skeleton, the one of UTS #39: "раураl.com"
+    in Cyrillic and "paypal.com" both have
+    "paypal.corn". It is taken of the domain
+    after nameprep, so that case and width do
+    not matter, and labels which begin with
+    "xn--" are decoded first. The skeleton is
+    only for comparing, and need not be a
+    valid domain.
+
+    The result is built in `storage`, as for
+    @ref utf8_to_idna.
+
+    Fails with `errc::illegal_byte_sequence` if the
+    domain is not well-formed utf8, with
+    `errc::value_too_large` if it is longer than
+    BOOST_PUNYCODE_MAX_INPUT_LENGTH, and with
+    `errc::invalid_argument` if it has a character
+    nameprep prohibits, or a label beginning with
+    "xn--" which is not the punycode of a label
+    of at most 63 octets.
+
+    @see https://www.unicode.org/reports/tr39/#Confusable_Detection
+*/
+BOOST_PUNYCODE_DECL
+system::result<std::string>
+skeleton(
+    core::string_view domain,
+    std::string&& storage = std::string());
+
+/** Return a hash of the confusable skeleton of a utf8-encoded domain
+
+    This is the 64-bit FNV-1a of the @ref
+    skeleton, which is streamed through the
+    hash and never stored. A domain without a
+    skeleton hashes its own octets. A set of
+    the hashes of protected names can then be
+    probed with the hash of each new domain,
+    and a match confirmed by comparing the
+    skeletons.
+*/
+BOOST_PUNYCODE_DECL
+std::uint64_t
+skeleton_hash(
+    core::string_view domain) noexcept;
+
+/** Hash the confusable skeletons of many utf8-encoded domains
+
+    Each `hashes[i]` is set to the @ref
+    skeleton_hash of `domains[i]`, for `i`
+    less than `n`.
+*/
+BOOST_PUNYCODE_DECL
+void
+skeleton_hash(
+    core::string_view const* domains,
+    std::size_t n,
+    std::uint64_t* hashes) noexcept;
+
 } // punycode
 } // boost
 
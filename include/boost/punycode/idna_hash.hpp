@@ -0,0 +1,112 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#ifndef BOOST_PUNYCODE_IDNA_HASH_HPP
+#define BOOST_PUNYCODE_IDNA_HASH_HPP
+
+#include <boost/punycode/detail/config.hpp>
+#include <boost/punycode/idna.hpp>
+#include <boost/punycode/idna_view.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/system/system_error.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost {
+namespace punycode {
+
+namespace detail {
+
+// FNV-1a, one octet at a time
+struct fnv1a
+{
+    std::uint64_t h = 0xcbf29ce484222325ull;
+
+    void
+    operator()(char c) noexcept
+    {
+        h ^= static_cast<unsigned char>(c);
+        h *= 0x100000001b3ull;
+    }
+};
+
+} // detail
+
+/*  The canonical form of a host is the IDNA
+    which idna_view produces for it. A host
+    without one, because it is not well-formed
+    utf8, has a label too long for DNS, has a
+    character nameprep prohibits or breaks the
+    bidi rule, is its own canonical form. Such
+    a host only matches the same octets, since
+    a canonical IDNA is ascii with labels of 63
+    octets or fewer.
+*/
+
+/** A hash function for hosts
+
+    Hosts which convert to the same IDNA have
+    the same hash, so "Bücher.de", "bücher.de"
+    and "xn--bcher-kva.de" all collide. The IDNA is
+    streamed through the hash and never stored,
+    so hashing does not allocate.
+
+    The function is transparent; containers using
+    it together with @ref idna_equal can be probed
+    with any string view, in any form.
+*/
+struct idna_hash
+{
+    using is_transparent = void;
+
+    std::size_t
+    operator()(core::string_view host) const noexcept
+    {
+        detail::fnv1a f;
+        try
+        {
+            idna_view const v(host);
+            for(auto it = v.begin(); it != v.end(); ++it)
+                f(*it);
+        }
+        catch(system::system_error const&)
+        {
+            f = {};
+            for(char c : host)
+                f(c);
+        }
+        return static_cast<std::size_t>(f.h);
+    }
+};
+
+/** An equality predicate for hosts
+
+    Two hosts are equal when they convert to
+    the same IDNA, as by @ref idna_equivalent,
+    which stops at the first label that differs
+    and does not allocate. The predicate is
+    transparent, like @ref idna_hash.
+*/
+struct idna_equal
+{
+    using is_transparent = void;
+
+    bool
+    operator()(
+        core::string_view a,
+        core::string_view b) const noexcept
+    {
+        return idna_equivalent(a, b);
+    }
+};
+
+} // punycode
+} // boost
+
+#endif
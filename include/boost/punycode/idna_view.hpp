@@ -0,0 +1,303 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#ifndef BOOST_PUNYCODE_IDNA_VIEW_HPP
+#define BOOST_PUNYCODE_IDNA_VIEW_HPP
+
+#include <boost/punycode/detail/bidi.hpp>
+#include <boost/punycode/detail/config.hpp>
+#include <boost/punycode/detail/except.hpp>
+#include <boost/punycode/detail/nameprep.hpp>
+#include <boost/punycode/punycode.hpp>
+#include <boost/punycode/utf8_input.hpp>
+#include <boost/assert.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+namespace boost {
+namespace punycode {
+
+namespace detail {
+
+// output iterator into a fixed buffer,
+// which throws instead of overflowing
+class label_output
+{
+    char* dest_;
+    char* end_;
+
+public:
+    using value_type        = char;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = value_type const*;
+    using reference         = value_type const&;
+    using iterator_category =
+        std::output_iterator_tag;
+
+    label_output(
+        char* dest,
+        char* end) noexcept
+        : dest_(dest)
+        , end_(end)
+    {
+    }
+
+    char*
+    base() const noexcept
+    {
+        return dest_;
+    }
+
+    label_output&
+    operator=(char c)
+    {
+        if(dest_ == end_)
+            punycode::detail::throw_length_error(
+                BOOST_PUNYCODE_POS);
+        *dest_++ = c;
+        return *this;
+    }
+
+    label_output&
+    operator*() noexcept
+    {
+        return *this;
+    }
+
+    label_output&
+    operator++() noexcept
+    {
+        return *this;
+    }
+
+    label_output&
+    operator++(int) noexcept
+    {
+        return *this;
+    }
+};
+
+} // detail
+
+/** A lazy range of the IDNA of a utf8 domain
+
+    The characters are the ones @ref utf8_to_idna
+    returns, produced one label at a time into a
+    buffer inside the iterator, so that iterating
+    never allocates. A label whose ACE form is
+    longer than the 63 octets DNS allows throws,
+    as does input which is not well-formed utf8
+    or has a character nameprep prohibits. So
+    does a domain which breaks the bidi rule,
+    at the first label which shows it.
+    The view refers to the domain, which must
+    outlive it and its iterators.
+*/
+class idna_view
+{
+    core::string_view s_;
+
+public:
+    class iterator;
+
+    // longest label in ACE form, per RFC 1035
+    static constexpr std::size_t max_label = 63;
+
+    explicit
+    idna_view(
+        core::string_view s) noexcept
+        : s_(s)
+    {
+    }
+
+    iterator
+    begin() const;
+
+    iterator
+    end() const noexcept;
+};
+
+class idna_view::iterator
+{
+    using nameprep = detail::nameprep_iterator<
+        utf8_input>;
+
+    // labels are split after nameprep,
+    // which can map to a dot
+    nameprep it_;
+
+    // the label and the character in it,
+    // where the end is label SIZE_MAX
+    std::size_t label_ = SIZE_MAX;
+    std::size_t i_ = 0;
+    std::size_t n_ = 0;
+    detail::bidi_rule bidi_;
+
+    // a label and its trailing dot
+    char buf_[max_label + 1];
+
+    friend class idna_view;
+
+    iterator(
+        char const* pos,
+        char const* end)
+        : it_(utf8_input(pos, end), utf8_input(end))
+    {
+        if(more())
+        {
+            label_ = 0;
+            load();
+        }
+    }
+
+public:
+    using value_type        = char;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = value_type const*;
+    using reference         = value_type;
+    using iterator_category =
+        std::forward_iterator_tag;
+
+    iterator() = default;
+
+    bool
+    operator==(
+        iterator const& other) const noexcept
+    {
+        return
+            label_ == other.label_ &&
+            i_ == other.i_;
+    }
+
+    bool
+    operator!=(
+        iterator const& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    char
+    operator*() const noexcept
+    {
+        BOOST_ASSERT(i_ < n_);
+        return buf_[i_];
+    }
+
+    iterator&
+    operator++()
+    {
+        BOOST_ASSERT(i_ < n_);
+        if(++i_ < n_)
+            return *this;
+        i_ = 0;
+        n_ = 0;
+        if(more())
+        {
+            ++label_;
+            load();
+        }
+        else
+        {
+            label_ = SIZE_MAX;
+        }
+        return *this;
+    }
+
+    iterator
+    operator++(int)
+    {
+        auto tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+private:
+    // true if there is another label, or
+    // nameprep stopped at a prohibited
+    // code point, which load reports
+    bool
+    more() const noexcept
+    {
+        return ! it_.done() || it_.prohibited();
+    }
+
+    // produce the next label, as encode_idna
+    // does for the whole domain
+    void
+    load()
+    {
+        // nameprep once, instead of on each of
+        // the passes the encoder makes. A label
+        // with more code points than this is too
+        // long in any form.
+        char32_t u[max_label];
+        std::size_t n = 0;
+        bool ascii = true;
+        for(; ! it_.done() &&
+            ! detail::is_label_dot(*it_); ++it_)
+        {
+            if(n == max_label)
+                detail::throw_length_error(
+                    BOOST_PUNYCODE_POS);
+            if(*it_ >= 0x80)
+                ascii = false;
+            bidi_.push(*it_);
+            u[n++] = *it_;
+        }
+        bidi_.end_label();
+        if(it_.prohibited() || bidi_.failed())
+            detail::throw_invalid_argument(
+                BOOST_PUNYCODE_POS);
+        detail::label_output out(
+            buf_, buf_ + max_label);
+        if(ascii)
+        {
+            for(std::size_t i = 0; i < n; ++i)
+                *out++ = static_cast<char>(u[i]);
+        }
+        else
+        {
+            *out++ = 'x';
+            *out++ = 'n';
+            *out++ = '-';
+            *out++ = '-';
+            out = punycode::encode(out, &u[0], &u[0] + n);
+        }
+        n_ = out.base() - buf_;
+        if(! it_.done())
+        {
+            buf_[n_++] = '.';
+            ++it_;
+        }
+    }
+};
+
+inline
+idna_view::iterator
+idna_view::
+begin() const
+{
+    return iterator(
+        s_.data(), s_.data() + s_.size());
+}
+
+inline
+idna_view::iterator
+idna_view::
+end() const noexcept
+{
+    return iterator();
+}
+
+} // punycode
+} // boost
+
+#endif
@@ -0,0 +1,121 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#ifndef BOOST_PUNYCODE_LABEL_INFO_HPP
+#define BOOST_PUNYCODE_LABEL_INFO_HPP
+
+#include <boost/punycode/detail/config.hpp>
+#include <cstdint>
+
+namespace boost {
+namespace punycode {
+
+/** Scripts of a label, as the bits of @ref label_info::scripts
+
+    These are the scripts which UAX #31 recommends
+    for identifiers. Any other script is reported
+    as `script_other`.
+*/
+enum idna_script : std::uint32_t
+{
+    script_arabic       = 1u << 0,
+    script_armenian     = 1u << 1,
+    script_bengali      = 1u << 2,
+    script_bopomofo     = 1u << 3,
+    script_cyrillic     = 1u << 4,
+    script_devanagari   = 1u << 5,
+    script_ethiopic     = 1u << 6,
+    script_georgian     = 1u << 7,
+    script_greek        = 1u << 8,
+    script_gujarati     = 1u << 9,
+    script_gurmukhi     = 1u << 10,
+    script_hangul       = 1u << 11,
+    script_han          = 1u << 12,
+    script_hebrew       = 1u << 13,
+    script_hiragana     = 1u << 14,
+    script_katakana     = 1u << 15,
+    script_khmer        = 1u << 16,
+    script_kannada      = 1u << 17,
+    script_lao          = 1u << 18,
+    script_latin        = 1u << 19,
+    script_malayalam    = 1u << 20,
+    script_myanmar      = 1u << 21,
+    script_oriya        = 1u << 22,
+    script_sinhala      = 1u << 23,
+    script_tamil        = 1u << 24,
+    script_telugu       = 1u << 25,
+    script_thaana       = 1u << 26,
+    script_thai         = 1u << 27,
+    script_tibetan      = 1u << 28,
+    script_other        = 1u << 29
+};
+
+/** The restriction levels of UTS #39
+
+    Each level allows what the ones before it do.
+
+    @see https://www.unicode.org/reports/tr39/#Restriction_Level_Detection
+*/
+enum class restriction_level : unsigned char
+{
+    /// Only ascii
+    ascii_only,
+
+    /// Characters of one script, counting Common and Inherited as any
+    single_script,
+
+    /// Latin with Han and Hiragana or Katakana, Han and Bopomofo, or Han and Hangul
+    highly_restrictive,
+
+    /// Latin with one other recommended script, except Cyrillic or Greek
+    moderately_restrictive,
+
+    /// Any mix of scripts
+    minimally_restrictive,
+
+    /// A character outside the General Security Profile
+    unrestricted
+};
+
+/** Properties of a label, found while it is converted
+
+    These are of the label after nameprep, which
+    is what a user sees once the IDNA is shown
+    as Unicode.
+*/
+struct label_info
+{
+    /** The @ref idna_script bits of the label
+
+        A character whose Script_Extensions has
+        several scripts adds them all. Common and
+        Inherited, such as digits and hyphens,
+        add none.
+    */
+    std::uint32_t scripts = 0;
+
+    /** The restriction level of the label
+
+        Characters are allowed as in the General
+        Security Profile. Scripts outside the
+        recommended ones are told apart here,
+        although @ref scripts only has
+        `script_other` for them.
+    */
+    restriction_level level =
+        restriction_level::ascii_only;
+
+    /// Decimal digits of more than one numbering system, as "1" and "১"
+    bool has_digits_mixed = false;
+};
+
+} // punycode
+} // boost
+
+#endif
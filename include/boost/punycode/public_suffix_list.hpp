@@ -0,0 +1,145 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#ifndef BOOST_PUNYCODE_PUBLIC_SUFFIX_LIST_HPP
+#define BOOST_PUNYCODE_PUBLIC_SUFFIX_LIST_HPP
+
+#include <boost/punycode/detail/config.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/system/result.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace punycode {
+
+/** The rules of the Public Suffix List
+
+    The list is compiled when it is loaded into
+    a trie of labels, read from the right, whose
+    labels are in the form @ref utf8_to_idna
+    returns. Rules written in Unicode are
+    converted once, so that domains are matched
+    on their IDNA without converting them again.
+    A lookup walks the labels of a domain from
+    the right, in place, with a binary search
+    among the children of each node, and does
+    not allocate.
+
+    Default constructed, the list is empty and
+    only the implicit rule "*" applies, which
+    makes the last label the public suffix.
+
+    @see https://publicsuffix.org/list/
+*/
+class public_suffix_list
+{
+    struct node
+    {
+        // the label, in pool_
+        std::uint32_t label = 0;
+
+        // the children, sorted by label
+        std::uint32_t first = 0;
+        std::uint16_t count = 0;
+
+        unsigned char size = 0;
+        unsigned char flags = 0;
+    };
+
+    std::vector<node> nodes_;
+    std::string pool_;
+    std::size_t rules_ = 0;
+
+    BOOST_PUNYCODE_DECL
+    std::size_t
+    find(core::string_view domain) const noexcept;
+
+public:
+    /** Constructor
+
+        The list has no rules.
+    */
+    public_suffix_list() = default;
+
+    /** Return a list compiled from the text of the Public Suffix List
+
+        Each line holds a rule up to the first
+        space, and lines which are empty or begin
+        with "//" are skipped. A rule may begin
+        with "*." for a wildcard, or with "!" for
+        an exception, and is otherwise a domain
+        in utf8.
+
+        Fails with `errc::invalid_argument` if a
+        rule has a wildcard other than its first
+        label, and as @ref utf8_to_idna does if a
+        rule has no IDNA.
+    */
+    BOOST_PUNYCODE_DECL
+    static
+    system::result<public_suffix_list>
+    parse(core::string_view text);
+
+    /** Return a list compiled from a file
+
+        The file is read whole, and compiled as
+        by @ref parse. Fails with the error of the
+        system if the file cannot be read.
+    */
+    BOOST_PUNYCODE_DECL
+    static
+    system::result<public_suffix_list>
+    load(char const* path);
+
+    /// Return the number of rules
+    std::size_t
+    size() const noexcept
+    {
+        return rules_;
+    }
+
+    /** Return the public suffix of a domain
+
+        The domain is an IDNA, as @ref
+        utf8_to_idna returns, whose labels are
+        compared with those of the rules octet
+        for octet. The result is a suffix of the
+        domain, which is the whole of it when the
+        domain is itself a public suffix. A
+        trailing dot is kept in the result, and
+        is otherwise ignored.
+    */
+    core::string_view
+    public_suffix(
+        core::string_view domain) const noexcept
+    {
+        return domain.substr(find(domain));
+    }
+
+    /** Return the registrable domain of a domain
+
+        This is the public suffix with the label
+        before it, sometimes called eTLD+1. The
+        result is empty when the domain is a
+        public suffix, and has no registrable
+        domain.
+    */
+    BOOST_PUNYCODE_DECL
+    core::string_view
+    registrable_domain(
+        core::string_view domain) const noexcept;
+};
+
+} // punycode
+} // boost
+
+#endif
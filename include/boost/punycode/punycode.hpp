@@ -16,11 +16,13 @@
 
 #include <boost/punycode/detail/config.hpp>
 #include <boost/punycode/detail/except.hpp>
+#include <boost/punycode/transcode.hpp>
 #include <boost/assert.hpp>
 #include <cstdint>
 #include <cstring>
 #include <iterator>
 #include <limits.h>
+#include <memory>
 
 namespace boost {
 namespace punycode {
@@ -141,11 +143,25 @@ decode_digit(
     return SIZE_MAX;
 }
 
+// true if an input of length n is over the
+// limit set with BOOST_PUNYCODE_MAX_INPUT_LENGTH
+constexpr inline bool
+exceeds_max_input(
+    std::size_t n) noexcept
+{
+    return
+        BOOST_PUNYCODE_MAX_INPUT_LENGTH != 0 &&
+        n > BOOST_PUNYCODE_MAX_INPUT_LENGTH;
+}
+
 //----------------------------------------------------------
 
 } // detail
 
 /** Punycode encode a utf32 range
+
+    @throws system_error if the range holds more
+    than BOOST_PUNYCODE_MAX_INPUT_LENGTH code points.
 */
 template<
     class OutputIt,
@@ -170,7 +186,9 @@ encode(
     auto src = first;
     while(src != last)
     {
-        ++srclen;
+        if(detail::exceeds_max_input(++srclen))
+            punycode::detail::throw_length_error(
+                BOOST_PUNYCODE_POS);
         auto const cp = *src++;
         if(cp < 0x80)
         {
@@ -243,6 +261,50 @@ fail:
     return dest;
 }
 
+/** Punycode encode a utf8 string
+
+    The string is decoded to utf32 in one bulk
+    pass first, on the stack when it is short,
+    so that the rescans done by the encoder read
+    contiguous code points.
+
+    @throws system_error if `s` is not well-formed
+    utf8, or if it holds more than
+    BOOST_PUNYCODE_MAX_INPUT_LENGTH code points.
+*/
+template<class OutputIt>
+OutputIt
+encode(
+    OutputIt dest,
+    core::string_view s)
+{
+    char32_t buf[256];
+    std::unique_ptr<char32_t[]> p;
+    char32_t* u = buf;
+    if(s.size() > sizeof(buf) / sizeof(buf[0]))
+    {
+        p.reset(new char32_t[s.size()]);
+        u = p.get();
+    }
+    auto const rv = utf8_to_utf32(s, u);
+    if(rv.has_error())
+        punycode::detail::throw_system_error(
+            rv.error(), BOOST_PUNYCODE_POS);
+    return encode(dest, u, u + *rv);
+}
+
+/** Punycode decode to a utf32 buffer
+
+    On entry `*dstlen` holds the capacity of
+    `dest`, and on exit the number of code points
+    written. Decoding stops early at the first
+    malformed digit or when `dest` is full.
+
+    @throws system_error if the input holds a byte
+    above 0x7f, if the basic code points do not fit
+    in `dest`, or if `srclen` is more than
+    BOOST_PUNYCODE_MAX_INPUT_LENGTH.
+*/
 inline
 void
 decode(
@@ -252,6 +314,10 @@ decode(
     char32_t* dest,
     size_t* const dstlen)
 {
+    if(detail::exceeds_max_input(srclen))
+        punycode::detail::throw_length_error(
+            BOOST_PUNYCODE_POS);
+
     char const* const begin = src;
     char const* const end = begin + srclen;
 
@@ -280,8 +346,11 @@ decode(
 
     /* Copy basic code points to output. */
     auto di = delim_pos;
+    if(di > *dstlen)
+        punycode::detail::throw_length_error(
+            BOOST_PUNYCODE_POS);
 
-    for(auto i = 0; i < di; i++)
+    for(std::size_t i = 0; i < di; i++)
         dest[i] = src[i];
 
     std::size_t i = 0;
@@ -300,6 +369,9 @@ decode(
             di < *dstlen;
             k += detail::base)
         {
+            // truncated variable length integer
+            if(csrc == end)
+                goto fail;
             auto const digit =
                 detail::decode_digit(*csrc++);
             if(digit == SIZE_MAX)
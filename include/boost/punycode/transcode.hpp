@@ -0,0 +1,160 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#ifndef BOOST_PUNYCODE_TRANSCODE_HPP
+#define BOOST_PUNYCODE_TRANSCODE_HPP
+
+#include <boost/punycode/detail/config.hpp>
+#include <boost/punycode/detail/simd.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/system/result.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace punycode {
+
+/** Return true if `s` is well-formed utf8
+
+    Overlong forms, surrogates, values above
+    U+10FFFF, and truncated or stray continuation
+    octets are all rejected. The check runs with
+    the widest vector instructions the processor
+    supports.
+*/
+BOOST_PUNYCODE_DECL
+bool
+is_valid_utf8(
+    core::string_view s) noexcept;
+
+/** Decode a utf8 string to utf32
+
+    `dest` must have room for `s.size()` code
+    points, which is always enough. On failure
+    the contents of `dest` are unspecified.
+
+    @return The number of code points written,
+    or `errc::illegal_byte_sequence` if `s` is
+    not well-formed utf8.
+*/
+BOOST_PUNYCODE_DECL
+system::result<std::size_t>
+utf8_to_utf32(
+    core::string_view s,
+    char32_t* dest) noexcept;
+
+/** Encode utf32 to utf8
+
+    Runs of ascii are narrowed and runs in the
+    basic multilingual plane are encoded several
+    code points at a time.
+
+    @return The number of octets written,
+    `errc::illegal_byte_sequence` if a code point
+    is a surrogate or above U+10FFFF, or
+    `errc::no_buffer_space` if the output does
+    not fit in `size` octets. On failure the
+    contents of `dest` are unspecified.
+*/
+BOOST_PUNYCODE_DECL
+system::result<std::size_t>
+utf32_to_utf8(
+    char32_t const* src,
+    std::size_t n,
+    char* dest,
+    std::size_t size) noexcept;
+
+/** Return the number of octets needed to encode utf32 as utf8
+
+    This is the size @ref utf32_to_utf8 needs,
+    found by comparing whole registers of code
+    points against the length thresholds.
+*/
+BOOST_PUNYCODE_DECL
+std::size_t
+utf8_length(
+    char32_t const* src,
+    std::size_t n) noexcept;
+
+/** Return the number of code points in a utf8 string
+
+    This counts the octets which are not
+    continuations, without validating. For
+    well-formed input it is the number of code
+    points @ref utf8_to_utf32 produces.
+*/
+BOOST_PUNYCODE_DECL
+std::size_t
+utf32_length(
+    core::string_view s) noexcept;
+
+namespace detail {
+
+// where an encode stopped: at the end
+// of the input, or at a code point which
+// is invalid or for which there is no room
+struct utf8_encode_result
+{
+    char32_t const* in;
+    char* out;
+};
+
+// true if cp is a unicode scalar value
+inline
+bool
+is_scalar_value(char32_t cp) noexcept
+{
+    return cp < 0xd800 ||
+        (cp > 0xdfff && cp <= 0x10ffff);
+}
+
+// as above, with an explicit instruction set,
+// which is lowered to what the processor has.
+// the decode returns SIZE_MAX on failure.
+
+BOOST_PUNYCODE_DECL
+bool
+is_valid_utf8(
+    core::string_view s,
+    simd_level level) noexcept;
+
+BOOST_PUNYCODE_DECL
+std::size_t
+utf8_to_utf32(
+    core::string_view s,
+    char32_t* dest,
+    simd_level level) noexcept;
+
+BOOST_PUNYCODE_DECL
+std::size_t
+utf8_length(
+    char32_t const* src,
+    std::size_t n,
+    simd_level level) noexcept;
+
+BOOST_PUNYCODE_DECL
+std::size_t
+utf32_length(
+    core::string_view s,
+    simd_level level) noexcept;
+
+BOOST_PUNYCODE_DECL
+utf8_encode_result
+utf32_to_utf8(
+    char32_t const* first,
+    char32_t const* last,
+    char* dest,
+    char* end,
+    simd_level level) noexcept;
+
+} // detail
+
+} // punycode
+} // boost
+
+#endif
@@ -0,0 +1,146 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#ifndef BOOST_PUNYCODE_UTF16_INPUT_HPP
+#define BOOST_PUNYCODE_UTF16_INPUT_HPP
+
+#include <boost/punycode/detail/config.hpp>
+#include <boost/punycode/detail/except.hpp>
+#include <boost/assert.hpp>
+#include <iterator>
+
+namespace boost {
+namespace punycode {
+
+// utf32 forward iterator which reads
+// utf16 code points. A surrogate which
+// is not part of a pair throws.
+class utf16_input
+{
+    static char32_t const invalid =
+        0xffffffff;
+
+    char16_t const* s_;
+    char16_t const* end_;
+    char32_t cp_;
+
+public:
+    using value_type        = char32_t;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = value_type const*;
+    using reference         = value_type const&;
+    using iterator_category =
+        std::forward_iterator_tag;
+
+    utf16_input(
+        char16_t const* s,
+        char16_t const* end)
+        : s_(s)
+        , end_(end)
+    {
+        next();
+    }
+
+    explicit
+    utf16_input(
+        char16_t const* s) noexcept
+        : s_(s)
+        , end_(s)
+        , cp_(invalid)
+    {
+    }
+
+    bool
+    operator==(
+        utf16_input const& other) const noexcept
+    {
+        return
+            s_ == other.s_ &&
+            end_ == other.end_ &&
+            cp_ == other.cp_;
+    }
+
+    bool
+    operator!=(
+        utf16_input const& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    char32_t
+    operator*() const noexcept
+    {
+        BOOST_ASSERT(cp_ != invalid);
+        return cp_;
+    }
+
+    utf16_input&
+    operator++()
+    {
+        BOOST_ASSERT(cp_ != invalid);
+        next();
+        return *this;
+    }
+
+    utf16_input
+    operator++(int)
+    {
+        auto tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+private:
+    // decode one code point, advancing in.
+    // everything outside the surrogate range
+    // takes the first, predictable branch.
+    static
+    char32_t
+    parse_utf16(
+        char16_t const*& in,
+        char16_t const* end)
+    {
+        if(in >= end)
+            punycode::detail::throw_invalid_argument(
+                BOOST_PUNYCODE_POS);
+        char32_t const c0 = *in;
+        if(c0 - 0xd800u >= 0x800u)
+        {
+            ++in;
+            return c0;
+        }
+        // a high surrogate, then a low one
+        if( c0 > 0xdbff ||
+            end - in < 2 ||
+            in[1] - 0xdc00u >= 0x400u)
+            punycode::detail::throw_invalid_argument(
+                BOOST_PUNYCODE_POS);
+        char32_t const c1 = in[1];
+        in += 2;
+        return 0x10000 +
+            ((c0 - 0xd800) << 10) +
+            (c1 - 0xdc00);
+    }
+
+    void
+    next()
+    {
+        if(s_ == end_)
+        {
+            cp_ = invalid;
+            return;
+        }
+        cp_ = parse_utf16(s_, end_);
+    }
+};
+
+} // punycode
+} // boost
+
+#endif
@@ -0,0 +1,121 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#ifndef BOOST_PUNYCODE_UTF16_OUTPUT_HPP
+#define BOOST_PUNYCODE_UTF16_OUTPUT_HPP
+
+#include <boost/punycode/detail/config.hpp>
+#include <boost/assert.hpp>
+#include <cstddef>
+#include <iterator>
+
+namespace boost {
+namespace punycode {
+
+// utf32 output iterator which
+// emits utf16 code units
+class utf16_output
+{
+    char16_t* dest_;
+    char16_t* end_ = nullptr;
+
+    bool
+    fits(std::size_t n) const noexcept
+    {
+        return ! end_ || static_cast<
+            std::size_t>(end_ - dest_) >= n;
+    }
+
+public:
+    using value_type        = char32_t;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = value_type const*;
+    using reference         = value_type const&;
+    using iterator_category =
+        std::output_iterator_tag;
+
+    /** Constructor
+
+        The caller is responsible for
+        providing enough room.
+    */
+    explicit utf16_output(
+        char16_t* dest) noexcept
+        : dest_(dest)
+    {
+    }
+
+    /** Constructor
+
+        Output is checked against
+        `end` by assertion.
+    */
+    utf16_output(
+        char16_t* dest,
+        char16_t* end) noexcept
+        : dest_(dest)
+        , end_(end)
+    {
+    }
+
+    // return the position of the next code unit
+    char16_t*
+    base() const noexcept
+    {
+        return dest_;
+    }
+
+    utf16_output&
+    operator=(char32_t cp) noexcept;
+
+    utf16_output&
+    operator*() noexcept
+    {
+        return *this;
+    }
+
+    utf16_output&
+    operator++() noexcept
+    {
+        return *this;
+    }
+
+    utf16_output&
+    operator++(int) noexcept
+    {
+        return *this;
+    }
+};
+
+inline
+utf16_output&
+utf16_output::
+operator=(char32_t cp) noexcept
+{
+    BOOST_ASSERT(cp < 0xd800 ||
+        (cp > 0xdfff && cp <= 0x10ffff));
+    if(cp < 0x10000)
+    {
+        BOOST_ASSERT(fits(1));
+        *dest_++ = static_cast<char16_t>(cp);
+    }
+    else
+    {
+        BOOST_ASSERT(fits(2));
+        cp -= 0x10000;
+        *dest_++ = static_cast<char16_t>(0xd800 + (cp >> 10));
+        *dest_++ = static_cast<char16_t>(0xdc00 + (cp & 0x3ff));
+    }
+    return *this;
+}
+
+} // punycode
+} // boost
+
+#endif
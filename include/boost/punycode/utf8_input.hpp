@@ -12,6 +12,7 @@
 
 #include <boost/punycode/detail/config.hpp>
 #include <boost/punycode/detail/except.hpp>
+#include <boost/punycode/detail/utf8_dfa.hpp>
 #include <boost/punycode/ascii_count.hpp>
 #include <boost/assert.hpp>
 #include <cstdint>
@@ -23,7 +24,8 @@ namespace boost {
 namespace punycode {
 
 // utf32 forward iterator which
-// reads utf8 code points
+// reads utf8 code points. Input which
+// is not well-formed utf8 throws.
 class utf8_input
 {
     static char32_t const invalid =
@@ -41,6 +43,13 @@ public:
     using iterator_category =
         std::forward_iterator_tag;
 
+    utf8_input() noexcept
+        : s_(nullptr)
+        , end_(nullptr)
+        , cp_(invalid)
+    {
+    }
+
     utf8_input(
         char const* s,
         char const* end)
@@ -100,74 +109,41 @@ public:
     }
 
 private:
-    static
-    constexpr
-    unsigned char
-    mask(char c)
-    {
-        return static_cast<
-            unsigned char>(
-                0xff & c);
-    }
-
+    // decode one code point, advancing in0.
+    // ascii takes one predictable branch; other
+    // octets step the automaton in detail/utf8_dfa.hpp
+    // until it accepts or rejects, so the checks
+    // for every kind of malformed input are the
+    // same two table loads per octet.
     static
     char32_t
     parse_utf8(
         char const*& in0,
         char const* end)
     {
+        namespace d = punycode::detail;
         if(in0 >= end)
             punycode::detail::throw_invalid_argument(
                 BOOST_PUNYCODE_POS);
-        char32_t cp;
-        char const* in = in0;
-
-        auto const u = mask(*in);
-        if(u < 0x80)
+        auto const p = reinterpret_cast<
+            unsigned char const*>(in0);
+        if(p[0] < 0x80)
         {
-            ++in;
-            cp = u;
+            ++in0;
+            return p[0];
         }
-        else if((u >> 5) == 0x06)
-        {
-            if(end - in < 2)
-                punycode::detail::throw_invalid_argument(
-                    BOOST_PUNYCODE_POS);
-            cp =
-                ((u << 6) & 0x7ff) +
-                (mask(in[1]) & 0x3f);
-            in += 2;
-                 
-        }
-        else if((u >> 4) == 0x0e)
-        {
-            if(end - in < 3)
-                punycode::detail::throw_invalid_argument(
-                    BOOST_PUNYCODE_POS);
-            cp =
-                ((u << 12) & 0xffff) +
-                ((mask(in[1]) << 6) & 0xfff) +
-                (mask(in[2]) & 0x3f);
-            in += 3;
-        }
-        else if((u >> 3) == 0x1e)
-        {
-            if(end - in < 4)
-                punycode::detail::throw_invalid_argument(
-                    BOOST_PUNYCODE_POS);
-            cp =
-                ((u << 18) & 0x1fffff) +
-                ((mask(in[1]) << 12) & 0x3ffff) +
-                ((mask(in[2]) << 6) & 0xfff) +
-                (mask(in[3]) & 0x3f);
-            in += 4;
-        }
-        else
-        {
+        auto const n = end - in0;
+        char32_t cp = 0;
+        std::uint32_t state = d::utf8_dfa_step(
+            d::utf8_accept, cp, p[0]);
+        std::ptrdiff_t len = 1;
+        while(state > d::utf8_reject && len < n)
+            state = d::utf8_dfa_step(
+                state, cp, p[len++]);
+        if(state != d::utf8_accept)
             punycode::detail::throw_invalid_argument(
                 BOOST_PUNYCODE_POS);
-        }
-        in0 = in;
+        in0 += len;
         return cp;
     }
 
@@ -12,6 +12,8 @@
 
 #include <boost/punycode/detail/config.hpp>
 #include <boost/punycode/detail/except.hpp>
+#include <boost/punycode/transcode.hpp>
+#include <boost/assert.hpp>
 #include <cstddef>
 #include <iterator>
 
@@ -23,8 +25,14 @@ namespace punycode {
 class utf8_output
 {
     char* dest_;
+    char* end_ = nullptr;
 
-    // VFALCO should track end_ for assertions
+    bool
+    fits(std::size_t n) const noexcept
+    {
+        return ! end_ || static_cast<
+            std::size_t>(end_ - dest_) >= n;
+    }
 
 public:
     using value_type        = char32_t;
@@ -34,15 +42,58 @@ public:
     using iterator_category =
         std::output_iterator_tag;
 
+    /** Constructor
+
+        The caller is responsible for
+        providing enough room.
+    */
     explicit utf8_output(
         char* dest) noexcept
         : dest_(dest)
     {
     }
 
+    /** Constructor
+
+        Output is checked against `end`: by
+        assertion for single code points, and
+        by exception for @ref write.
+    */
+    utf8_output(
+        char* dest,
+        char* end) noexcept
+        : dest_(dest)
+        , end_(end)
+    {
+    }
+
+    // return the position of the next octet
+    char*
+    base() const noexcept
+    {
+        return dest_;
+    }
+
     utf8_output&
     operator=(char32_t cp) noexcept;
 
+    /** Encode a run of code points
+
+        This is much faster than assigning each
+        code point in turn.
+
+        @throw system_error with
+        `errc::illegal_byte_sequence` if a code
+        point is a surrogate or above U+10FFFF, or
+        `errc::no_buffer_space` if the output has
+        an end and the run does not fit. What was
+        encoded before the failure is kept.
+    */
+    utf8_output&
+    write(
+        char32_t const* p,
+        std::size_t n);
+
     utf8_output&
     operator*() noexcept
     {
@@ -66,24 +117,28 @@ inline
 utf8_output&
 utf8_output::
 operator=(char32_t cp) noexcept
-{               
+{
     if(cp < 0x80)
     {
+        BOOST_ASSERT(fits(1));
         *dest_++ = static_cast<char>(cp);
     }
     else if(cp < 0x800)
     {
+        BOOST_ASSERT(fits(2));
         *dest_++ = static_cast<char>( (cp >> 6)          | 0xc0);
         *dest_++ = static_cast<char>( (cp & 0x3f)        | 0x80);
     }
     else if(cp < 0x10000)
     {
+        BOOST_ASSERT(fits(3));
         *dest_++ = static_cast<char>( (cp >> 12)         | 0xe0);
         *dest_++ = static_cast<char>(((cp >> 6) & 0x3f)  | 0x80);
         *dest_++ = static_cast<char>( (cp       & 0x3f)  | 0x80);
     }
     else
     {
+        BOOST_ASSERT(fits(4));
         *dest_++ = static_cast<char>( (cp >> 18)         | 0xf0);
         *dest_++ = static_cast<char>(((cp >> 12) & 0x3f) | 0x80);
         *dest_++ = static_cast<char>(((cp >> 6)  & 0x3f) | 0x80);
@@ -92,6 +147,31 @@ operator=(char32_t cp) noexcept
     return *this;
 }
 
+inline
+utf8_output&
+utf8_output::
+write(
+    char32_t const* p,
+    std::size_t n)
+{
+    // without an end, four octets a
+    // code point is always enough
+    auto const rv = detail::utf32_to_utf8(
+        p, p + n, dest_,
+        end_ ? end_ : dest_ + 4 * n,
+        detail::cpu_simd_level());
+    dest_ = rv.out;
+    if(rv.in != p + n)
+    {
+        if(! detail::is_scalar_value(*rv.in))
+            detail::throw_errc(
+                system::errc::illegal_byte_sequence);
+        detail::throw_errc(
+            system::errc::no_buffer_space);
+    }
+    return *this;
+}
+
 } // punycode
 } // boost
 
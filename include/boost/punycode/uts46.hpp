@@ -0,0 +1,124 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#ifndef BOOST_PUNYCODE_UTS46_HPP
+#define BOOST_PUNYCODE_UTS46_HPP
+
+#include <boost/punycode/detail/config.hpp>
+#include <boost/core/detail/string_view.hpp>
+#include <boost/system/result.hpp>
+#include <string>
+
+namespace boost {
+namespace punycode {
+
+/** Options for UTS #46 processing
+
+    The defaults are the strictest settings,
+    which are the ones the conformance tests
+    of UTS #46 use.
+
+    @see https://www.unicode.org/reports/tr46/
+*/
+struct uts46_options
+{
+    /** Map the deviation characters
+
+        Transitional processing maps "ß" to "ss",
+        final sigma to sigma, and drops the zero
+        width joiners, as IDNA2003 did. It is
+        deprecated by UTS #46.
+    */
+    bool transitional = false;
+
+    /// Reject labels with hyphens in the third and fourth positions, or at either end
+    bool check_hyphens = true;
+
+    /// Allow only ascii letters, digits and hyphens
+    bool use_std3_rules = true;
+
+    /// Reject empty labels, labels over 63 octets and domains over 253
+    bool verify_dns_length = true;
+
+    /** Apply the bidi rule of RFC 5893
+
+        A domain with a right-to-left label, one
+        with a character of bidi class R, AL or
+        AN, must have every label satisfy the six
+        conditions of the rule.
+    */
+    bool check_bidi = true;
+
+    /** Apply the CONTEXTJ rules of RFC 5892
+
+        The zero width joiner and non-joiner are
+        only allowed after a virama, and the
+        non-joiner also between characters which
+        join, as in Arabic and Syriac script.
+    */
+    bool check_joiners = true;
+
+    /** Apply the CONTEXTO rules of RFC 5892
+
+        These restrict the middle dot, the Greek
+        lower numeral sign, Hebrew geresh and
+        gershayim, the Katakana middle dot and the
+        Arabic-Indic digits to their contexts, as
+        IDNA2008 registration does. UTS #46 leaves
+        them out, so the default is false.
+    */
+    bool check_contexto = false;
+};
+
+/** Return the UTS #46 ToASCII of a utf8-encoded domain
+
+    The domain is mapped with the IDNA mapping
+    table, normalized to NFC, and validated;
+    labels with non-ascii characters are then
+    converted to punycode. Labels which begin
+    with "xn--" are decoded and validated too.
+
+    The result is built in `storage`, as for
+    @ref utf8_to_idna.
+
+    Fails with `errc::illegal_byte_sequence` if the
+    domain is not well-formed utf8, with
+    `errc::value_too_large` if it is longer than
+    BOOST_PUNYCODE_MAX_INPUT_LENGTH, and with
+    `errc::invalid_argument` if processing records
+    any error.
+*/
+BOOST_PUNYCODE_DECL
+system::result<std::string>
+uts46_to_ascii(
+    core::string_view domain,
+    uts46_options const& opt = {},
+    std::string&& storage = std::string());
+
+/** Return the UTS #46 ToUnicode of a utf8-encoded domain
+
+    The domain is processed as by @ref
+    uts46_to_ascii, except that the labels are
+    left in Unicode, and labels which begin with
+    "xn--" are replaced by their decoding. The
+    DNS length limits are not checked.
+
+    Fails as @ref uts46_to_ascii does.
+*/
+BOOST_PUNYCODE_DECL
+system::result<std::string>
+uts46_to_unicode(
+    core::string_view domain,
+    uts46_options const& opt = {},
+    std::string&& storage = std::string());
+
+} // punycode
+} // boost
+
+#endif
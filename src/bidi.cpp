@@ -0,0 +1,29 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#include <boost/punycode/detail/bidi.hpp>
+#include "src/detail/unicode_tables.hpp"
+
+namespace boost {
+namespace punycode {
+namespace detail {
+
+unsigned
+bidi_class_lookup(char32_t cp) noexcept
+{
+    // past the code space, as utf32
+    // input may be, is never allowed
+    if(cp >= 0x110000)
+        return bidi_other;
+    return bidi_lookup(cp);
+}
+
+} // detail
+} // punycode
+} // boost
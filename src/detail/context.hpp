@@ -0,0 +1,224 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#ifndef BOOST_PUNYCODE_SRC_DETAIL_CONTEXT_HPP
+#define BOOST_PUNYCODE_SRC_DETAIL_CONTEXT_HPP
+
+#include "src/detail/unicode_tables.hpp"
+#include <cstdint>
+
+/*  Contextual rules of IDNA2008
+
+    https://datatracker.ietf.org/doc/html/rfc5892#appendix-A
+
+    Each rule looks at most one code point back,
+    or forward past characters of Joining_Type T,
+    or asks whether the label has some character
+    at all. So the rules are decided as the code
+    points of a label go by: what a code point
+    needs of the ones after it is remembered
+    until they arrive, and what it needs of the
+    whole label until the label ends.
+*/
+
+namespace boost {
+namespace punycode {
+namespace detail {
+
+// properties from context_lookup
+enum : unsigned
+{
+    context_t           = 1,    // Joining_Type T
+    context_left        = 2,    // Joining_Type L or D
+    context_right       = 4,    // Joining_Type R or D
+    context_greek       = 8,
+    context_hebrew      = 16,
+    context_kana_han    = 32,   // Hiragana, Katakana or Han
+    context_virama      = 64
+};
+
+inline
+unsigned
+context_data(char32_t cp) noexcept
+{
+    // ascii takes no part
+    if(cp < 0x80)
+        return 0;
+    return context_lookup(cp);
+}
+
+class context_rule
+{
+    // what the next code point must be
+    enum : unsigned char
+    {
+        need_none,
+        need_right,     // R or D, after any T
+        need_l,         // the letter l
+        need_greek
+    };
+
+    bool joiners_;
+    bool contexto_;
+
+    // the code point before, and its properties
+    char32_t prev_ = 0;
+    unsigned prev_v_ = 0;
+    // the last code point not of Joining_Type
+    // T had Joining_Type L or D
+    bool left_ = false;
+    unsigned char need_ = need_none;
+
+    // for the rules on the whole label
+    bool dot_ = false;          // KATAKANA MIDDLE DOT
+    bool kana_han_ = false;
+    bool digits_ = false;       // ARABIC-INDIC DIGITs
+    bool ext_digits_ = false;   // EXTENDED ARABIC-INDIC DIGITs
+
+    bool bad_ = false;
+
+    void
+    check_need(
+        char32_t cp,
+        unsigned v) noexcept
+    {
+        switch(need_)
+        {
+        case need_right:
+            if(v & context_t)
+                return;
+            if(! (v & context_right))
+                bad_ = true;
+            break;
+
+        case need_l:
+            if(cp != 'l')
+                bad_ = true;
+            break;
+
+        case need_greek:
+            if(! (v & context_greek))
+                bad_ = true;
+            break;
+
+        default:
+            break;
+        }
+        need_ = need_none;
+    }
+
+public:
+    /** Constructor
+
+        @param joiners Apply the CONTEXTJ rules,
+        of U+200C and U+200D.
+
+        @param contexto Apply the CONTEXTO rules.
+    */
+    context_rule(
+        bool joiners,
+        bool contexto) noexcept
+        : joiners_(joiners)
+        , contexto_(contexto)
+    {
+    }
+
+    void
+    push(char32_t cp) noexcept
+    {
+        auto const v = context_data(cp);
+        if(need_ != need_none)
+            check_need(cp, v);
+        switch(cp)
+        {
+        // ZERO WIDTH NON-JOINER, A.1
+        case 0x200c:
+            if(! joiners_ || (prev_v_ & context_virama))
+                break;
+            if(left_)
+                need_ = need_right;
+            else
+                bad_ = true;
+            break;
+
+        // ZERO WIDTH JOINER, A.2
+        case 0x200d:
+            if( joiners_ &&
+                ! (prev_v_ & context_virama))
+                bad_ = true;
+            break;
+
+        // MIDDLE DOT, A.3
+        case 0x00b7:
+            if(! contexto_)
+                break;
+            if(prev_ == 'l')
+                need_ = need_l;
+            else
+                bad_ = true;
+            break;
+
+        // GREEK LOWER NUMERAL SIGN, A.4
+        case 0x0375:
+            if(contexto_)
+                need_ = need_greek;
+            break;
+
+        // HEBREW PUNCTUATION GERESH
+        // and GERSHAYIM, A.5 and A.6
+        case 0x05f3:
+        case 0x05f4:
+            if( contexto_ &&
+                ! (prev_v_ & context_hebrew))
+                bad_ = true;
+            break;
+
+        // KATAKANA MIDDLE DOT, A.7
+        case 0x30fb:
+            dot_ = true;
+            break;
+
+        default:
+            // A.8 and A.9
+            if(cp - 0x660 < 10u)
+                digits_ = true;
+            else if(cp - 0x6f0 < 10u)
+                ext_digits_ = true;
+            break;
+        }
+        if(v & context_kana_han)
+            kana_han_ = true;
+        if(! (v & context_t))
+            left_ = (v & context_left) != 0;
+        prev_ = cp;
+        prev_v_ = v;
+    }
+
+    /** End a label, returning true if it satisfied the rules
+    */
+    bool
+    end_label() noexcept
+    {
+        bool ok = ! bad_ && need_ == need_none;
+        if(contexto_)
+        {
+            if( (dot_ && ! kana_han_) ||
+                (digits_ && ext_digits_))
+                ok = false;
+        }
+        *this = context_rule(joiners_, contexto_);
+        return ok;
+    }
+};
+
+} // detail
+} // punycode
+} // boost
+
+#endif
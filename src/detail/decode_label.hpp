@@ -0,0 +1,95 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#ifndef BOOST_PUNYCODE_SRC_DETAIL_DECODE_LABEL_HPP
+#define BOOST_PUNYCODE_SRC_DETAIL_DECODE_LABEL_HPP
+
+#include <boost/punycode/punycode.hpp>
+#include <boost/punycode/transcode.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace boost {
+namespace punycode {
+namespace detail {
+
+/*  Decode the punycode after "xn--", failing on
+    anything RFC 3492 says a decoder must reject.
+    Returns the number of code points written
+    to dest, which has room for n, or SIZE_MAX.
+*/
+inline
+std::size_t
+decode_label(
+    char32_t const* src,
+    std::size_t n,
+    char32_t* dest) noexcept
+{
+    // the basic code points end at the last delimiter
+    std::size_t b = 0;
+    for(std::size_t j = 0; j < n; ++j)
+    {
+        if(src[j] >= 0x80)
+            return SIZE_MAX;
+        if(src[j] == '-')
+            b = j;
+    }
+    std::size_t out = 0;
+    for(; out < b; ++out)
+        dest[out] = src[out];
+
+    std::size_t i = 0;
+    std::size_t bias = initial_bias;
+    std::uint32_t cp = initial_n;
+    for(std::size_t in = b > 0 ? b + 1 : 0; in < n;)
+    {
+        auto const i0 = i;
+        std::size_t w = 1;
+        for(std::size_t k = base;;
+            k += base)
+        {
+            if(in == n)
+                return SIZE_MAX;
+            auto const digit =
+                decode_digit(src[in++]);
+            if( digit == SIZE_MAX ||
+                digit > (SIZE_MAX - i) / w)
+                return SIZE_MAX;
+            i += digit * w;
+            std::size_t const t =
+                k <= bias ? tmin :
+                k >= bias + tmax ? tmax :
+                k - bias;
+            if(digit < t)
+                break;
+            if(w > SIZE_MAX / (base - t))
+                return SIZE_MAX;
+            w *= base - t;
+        }
+        bias = adapt(i - i0, out + 1, i0 == 0);
+        if(i / (out + 1) > 0x10ffff - cp)
+            return SIZE_MAX;
+        cp += static_cast<std::uint32_t>(i / (out + 1));
+        i %= out + 1;
+        if(! is_scalar_value(cp))
+            return SIZE_MAX;
+        std::memmove(dest + i + 1, dest + i,
+            (out - i) * sizeof(char32_t));
+        dest[i++] = cp;
+        ++out;
+    }
+    return out;
+}
+
+} // detail
+} // punycode
+} // boost
+
+#endif
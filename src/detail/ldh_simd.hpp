@@ -0,0 +1,306 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+/*  Host name classification
+
+    The scalar part is included once. The kernel
+    is compiled for each instruction set the file
+    is included with, in the same way as
+    src/detail/utf8_simd.hpp.
+*/
+
+#include <boost/punycode/idna.hpp>
+#include "src/detail/simd.hpp"
+#include <cstring>
+
+#ifndef BOOST_PUNYCODE_SRC_DETAIL_LDH_SIMD_COMMON
+#define BOOST_PUNYCODE_SRC_DETAIL_LDH_SIMD_COMMON
+
+namespace boost {
+namespace punycode {
+namespace detail {
+
+// the octets of one block which are in each
+// class, as bit i for octet i. Octets past
+// the end of the input are in none of them.
+struct ldh_masks
+{
+    std::uint64_t live;
+    std::uint64_t non_ascii;
+    std::uint64_t upper;
+    std::uint64_t alnum;
+    std::uint64_t hyphen;
+    std::uint64_t dot;
+    std::uint64_t x;        // x or X
+    std::uint64_t n;        // n or N
+};
+
+/*  Turns the masks of consecutive blocks into
+    idna_classify flags. The patterns which look
+    behind, such as a hyphen before a dot or the
+    "xn--" at the start of a label, shift in the
+    masks of the block before, so that they are
+    found across the boundary between blocks.
+*/
+class ldh_classifier
+{
+    // longest label, per RFC 1035
+    static constexpr std::size_t max_label = 63;
+
+    unsigned const w_;
+    std::uint64_t const full_;
+    unsigned flags_ = 0;
+    std::size_t pos_ = 0;
+    std::size_t label_ = 0;
+
+    // masks of the block before. The input
+    // begins as if it followed a dot.
+    std::uint64_t dot_;
+    std::uint64_t start_ = 0;
+    std::uint64_t hyphen_ = 0;
+    std::uint64_t x_ = 0;
+    std::uint64_t n_ = 0;
+
+    // m shifted up k octets, with the top
+    // k octets of the block before below
+    std::uint64_t
+    up(
+        std::uint64_t m,
+        std::uint64_t prev,
+        unsigned k) const noexcept
+    {
+        return ((m << k) | (prev >> (w_ - k))) & full_;
+    }
+
+public:
+    explicit
+    ldh_classifier(unsigned width) noexcept
+        : w_(width)
+        , full_(all(width))
+        , dot_(std::uint64_t(1) << (width - 1))
+    {
+    }
+
+    // the mask of the first n octets
+    static
+    std::uint64_t
+    all(unsigned n) noexcept
+    {
+        return n < 64 ?
+            (std::uint64_t(1) << n) - 1 :
+            ~std::uint64_t(0);
+    }
+
+    BOOST_FORCEINLINE
+    void
+    block(ldh_masks const& m) noexcept
+    {
+        // octets which begin a label
+        auto const start = up(m.dot, dot_, 1);
+        if(m.non_ascii)
+            flags_ |= has_non_ascii;
+        if(m.upper)
+            flags_ |= has_upper;
+        auto const bad =
+            (m.live & ~(m.alnum | m.hyphen |
+                m.dot | m.non_ascii)) |
+            (m.hyphen & start) |
+            (m.dot & start) |
+            (m.dot & up(m.hyphen, hyphen_, 1));
+        if(bad)
+            flags_ |= has_invalid_ldh;
+        if( m.hyphen &
+            up(m.hyphen, hyphen_, 1) &
+            up(m.n, n_, 2) &
+            up(m.x, x_, 3) &
+            up(start, start_, 3))
+            flags_ |= has_xn_label;
+        for(auto d = m.dot; d; d &= d - 1)
+        {
+            auto const at = pos_ + ctz(d);
+            if(at - label_ > max_label)
+                flags_ |= has_invalid_ldh;
+            label_ = at + 1;
+        }
+        dot_ = m.dot;
+        start_ = start;
+        hyphen_ = m.hyphen;
+        x_ = m.x;
+        n_ = m.n;
+        pos_ += w_;
+    }
+
+    // skip a block of lower case letters and
+    // digits, given their mask. Such a block
+    // changes no flag, and no pattern can span
+    // it, so the masks before become empty.
+    bool
+    plain(std::uint64_t lower_alnum) noexcept
+    {
+        if(lower_alnum != full_)
+            return false;
+        dot_ = 0;
+        start_ = 0;
+        hyphen_ = 0;
+        x_ = 0;
+        n_ = 0;
+        pos_ += w_;
+        return true;
+    }
+
+    // the last label may be empty,
+    // for the root, but not the only one
+    unsigned
+    finish(
+        std::size_t size,
+        unsigned char last) noexcept
+    {
+        if( size == 0 ||
+            last == '-' ||
+            size - label_ > max_label)
+            flags_ |= has_invalid_ldh;
+        return flags_;
+    }
+};
+
+// masks of up to 64 octets, one at a time
+inline
+ldh_masks
+ldh_block_scalar(
+    unsigned char const* p,
+    std::size_t n) noexcept
+{
+    ldh_masks m = {};
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        unsigned const c = p[i];
+        unsigned const f = c | 0x20;
+        auto const bit = std::uint64_t(1) << i;
+        m.live |= bit;
+        if(c >= 0x80)
+            m.non_ascii |= bit;
+        if(c - 'A' < 26u)
+            m.upper |= bit;
+        if(f - 'a' < 26u || c - '0' < 10u)
+            m.alnum |= bit;
+        if(c == '-')
+            m.hyphen |= bit;
+        if(c == '.')
+            m.dot |= bit;
+        if(f == 'x')
+            m.x |= bit;
+        if(f == 'n')
+            m.n |= bit;
+    }
+    return m;
+}
+
+inline
+unsigned
+ldh_classify_scalar(
+    unsigned char const* p,
+    std::size_t n) noexcept
+{
+    unsigned char const last = n ? p[n - 1] : 0;
+    ldh_classifier c(64);
+    std::size_t i = n;
+    for(; i >= 64; p += 64, i -= 64)
+    {
+        // the run of lower case letters and digits
+        unsigned k = 0;
+        while( k < 64 && (
+            static_cast<unsigned char>(p[k] - 'a') < 26u ||
+            static_cast<unsigned char>(p[k] - '0') < 10u))
+            ++k;
+        if(! c.plain(ldh_classifier::all(k)))
+            c.block(ldh_block_scalar(p, 64));
+    }
+    if(i > 0)
+        c.block(ldh_block_scalar(p, i));
+    return c.finish(n, last);
+}
+
+} // detail
+} // punycode
+} // boost
+
+#endif
+
+#ifdef BOOST_PUNYCODE_SIMD_NS
+
+namespace boost {
+namespace punycode {
+namespace detail {
+namespace BOOST_PUNYCODE_SIMD_NS {
+
+BOOST_PUNYCODE_SIMD_TARGET
+inline
+ldh_masks
+ldh_block(
+    reg v,
+    std::uint64_t live) noexcept
+{
+    // setting bit 5 folds case for letters
+    reg const f = bit_or(v, splat(0x20));
+    ldh_masks m;
+    m.live = live;
+    m.non_ascii = top_bits(v);
+    m.upper = below(sub8(v, splat('A')), 26);
+    m.alnum =
+        below(sub8(f, splat('a')), 26) |
+        below(sub8(v, splat('0')), 10);
+    m.hyphen = equal(v, '-');
+    m.dot = equal(v, '.');
+    m.x = equal(f, 'x');
+    m.n = equal(f, 'n');
+    return m;
+}
+
+/** Return the idna_classify flags of [p, p + n)
+*/
+BOOST_PUNYCODE_SIMD_TARGET
+inline
+unsigned
+ldh_classify(
+    unsigned char const* p,
+    std::size_t const n) noexcept
+{
+    unsigned char const last = n ? p[n - 1] : 0;
+    ldh_classifier c(width);
+    std::size_t i = n;
+    for(; i >= width; p += width, i -= width)
+    {
+        reg const v = load(p);
+        if(! c.plain(
+            below(sub8(v, splat('a')), 26) |
+            below(sub8(v, splat('0')), 10)))
+            c.block(ldh_block(v,
+                ldh_classifier::all(width)));
+    }
+    if(i > 0)
+    {
+        // the padding is in no class
+        unsigned char tail[width] = {};
+        std::memcpy(tail, p, i);
+        c.block(ldh_block(load(tail),
+            ldh_classifier::all(
+                static_cast<unsigned>(i))));
+    }
+    return c.finish(n, last);
+}
+
+} // BOOST_PUNYCODE_SIMD_NS
+} // detail
+} // punycode
+} // boost
+
+#undef BOOST_PUNYCODE_SIMD_NS
+#undef BOOST_PUNYCODE_SIMD_TARGET
+
+#endif
@@ -0,0 +1,323 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#ifndef BOOST_PUNYCODE_SRC_DETAIL_NFC_HPP
+#define BOOST_PUNYCODE_SRC_DETAIL_NFC_HPP
+
+#include "src/detail/u32_buffer.hpp"
+#include "src/detail/unicode_tables.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/*  Normalization Forms C and KC
+
+    https://www.unicode.org/reports/tr15/
+
+    NFC is the one of the current Unicode, for
+    UTS #46. Nothing below U+0300 has a combining
+    class, a decomposition which does not
+    recompose, or composes with what comes before
+    it, so such code points skip the tables.
+
+    NFKC is the one of Unicode 3.2, for nameprep,
+    where the same holds below U+00A0.
+*/
+
+namespace boost {
+namespace punycode {
+namespace detail {
+
+// Hangul syllables, which decompose
+// and compose by arithmetic
+constexpr char32_t hangul_s = 0xac00;
+constexpr char32_t hangul_l = 0x1100;
+constexpr char32_t hangul_v = 0x1161;
+constexpr char32_t hangul_t = 0x11a7;
+constexpr unsigned hangul_l_count = 19;
+constexpr unsigned hangul_v_count = 21;
+constexpr unsigned hangul_t_count = 28;
+constexpr unsigned hangul_n_count =
+    hangul_v_count * hangul_t_count;
+constexpr unsigned hangul_s_count =
+    hangul_l_count * hangul_n_count;
+
+// the canonical combining class
+inline
+unsigned
+nfc_ccc(char32_t cp) noexcept
+{
+    if(cp < 0x300)
+        return 0;
+    return nfc_lookup(cp) & 0xff;
+}
+
+// true if General_Category is Mark
+inline
+bool
+nfc_is_mark(char32_t cp) noexcept
+{
+    if(cp < 0x300)
+        return false;
+    return (nfc_lookup(cp) & 0x200) != 0;
+}
+
+/** Return true if [p, p + n) is known to be NFC
+
+    This is the quick check of UAX #15, where
+    Maybe counts as No. A false result means the
+    string must be normalized to tell.
+*/
+inline
+bool
+nfc_quick_check(
+    char32_t const* p,
+    std::size_t n) noexcept
+{
+    unsigned last = 0;
+    for(auto const end = p + n; p != end; ++p)
+    {
+        if(*p < 0x300)
+        {
+            last = 0;
+            continue;
+        }
+        auto const v = nfc_lookup(*p);
+        unsigned const ccc = v & 0xff;
+        if(v & 0x100)
+            return false;
+        if(ccc != 0 && last > ccc)
+            return false;
+        last = ccc;
+    }
+    return true;
+}
+
+// the primary composite of a and b in
+// a sorted table of pairs, or zero
+inline
+char32_t
+compose_pair(
+    std::uint64_t const* table,
+    std::size_t size,
+    char32_t a,
+    char32_t b) noexcept
+{
+    if( a - hangul_l < hangul_l_count &&
+        b - hangul_v < hangul_v_count)
+        return hangul_s + ((a - hangul_l) *
+            hangul_v_count + (b - hangul_v)) *
+                hangul_t_count;
+    if( a - hangul_s < hangul_s_count &&
+        (a - hangul_s) % hangul_t_count == 0 &&
+        b - hangul_t - 1 < hangul_t_count - 1)
+        return a + (b - hangul_t);
+    auto const key =
+        (std::uint64_t(a) << 42) |
+        (std::uint64_t(b) << 21);
+    auto const last = table + size;
+    auto const it = std::lower_bound(
+        table, last, key);
+    if( it == last ||
+        (*it >> 21) != (key >> 21))
+        return 0;
+    return static_cast<char32_t>(
+        *it & 0x1fffff);
+}
+
+inline
+char32_t
+nfc_compose(
+    char32_t a,
+    char32_t b) noexcept
+{
+    return compose_pair(nfc_compose_table,
+        nfc_compose_size, a, b);
+}
+
+// write the Hangul syllable cp decomposed
+// to d, returning the number of jamo
+inline
+std::size_t
+hangul_decompose(
+    char32_t cp,
+    char32_t* d) noexcept
+{
+    auto const i = cp - hangul_s;
+    d[0] = hangul_l + i / hangul_n_count;
+    d[1] = hangul_v +
+        (i % hangul_n_count) / hangul_t_count;
+    d[2] = hangul_t + i % hangul_t_count;
+    return d[2] == hangul_t ? 2 : 3;
+}
+
+/** Compose the decomposed [d, d + size) in place
+
+    Each run of marks is put in canonical
+    order, then the string is composed as in
+    the sample code of UAX #15. Returns the
+    new size.
+*/
+template<
+    class Ccc,
+    class Compose>
+std::size_t
+recompose(
+    char32_t* d,
+    std::size_t size,
+    Ccc ccc_of,
+    Compose compose)
+{
+    // a stable sort by class
+    for(std::size_t i = 1; i < size; ++i)
+    {
+        auto const ccc = ccc_of(d[i]);
+        if(ccc == 0)
+            continue;
+        auto j = i;
+        auto const cp = d[i];
+        while(j > 0 && ccc_of(d[j - 1]) > ccc)
+        {
+            d[j] = d[j - 1];
+            --j;
+        }
+        d[j] = cp;
+    }
+
+    if(size == 0)
+        return 0;
+    std::size_t starter = 0;
+    unsigned last = ccc_of(d[0]);
+    if(last != 0)
+        last = 256;
+    std::size_t w = 1;
+    for(std::size_t i = 1; i < size; ++i)
+    {
+        auto const cp = d[i];
+        auto const ccc = ccc_of(cp);
+        if(last < ccc || last == 0)
+        {
+            auto const c = compose(d[starter], cp);
+            if(c != 0)
+            {
+                d[starter] = c;
+                continue;
+            }
+        }
+        if(ccc == 0)
+            starter = w;
+        last = ccc;
+        d[w++] = cp;
+    }
+    return w;
+}
+
+/** Normalize [p, p + n) to NFC in out
+
+    The string is fully decomposed, put in
+    canonical order, and recomposed.
+*/
+inline
+void
+nfc_normalize(
+    char32_t const* p,
+    std::size_t n,
+    u32_buffer& out)
+{
+    // decompose
+    out.clear();
+    for(auto const end = p + n; p != end; ++p)
+    {
+        char32_t const cp = *p;
+        if(cp - hangul_s < hangul_s_count)
+        {
+            out.commit(hangul_decompose(
+                cp, out.prepare(3)));
+            continue;
+        }
+        auto const v = cp < 0x300 ? 0 : nfc_lookup(cp);
+        auto const len = (v >> 10) & 7;
+        if(len == 0)
+            out.push_back(cp);
+        else
+            out.append(nfc_pool + (v >> 13), len);
+    }
+    out.resize(recompose(
+        out.data(), out.size(),
+        nfc_ccc, nfc_compose));
+}
+
+//------------------------------------------------
+
+inline
+unsigned
+nfkc_ccc(char32_t cp) noexcept
+{
+    if(cp < 0xa0)
+        return 0;
+    return nfkc_lookup(cp) & 0xff;
+}
+
+inline
+char32_t
+nfkc_compose(
+    char32_t a,
+    char32_t b) noexcept
+{
+    return compose_pair(nfkc_compose_table,
+        nfkc_compose_size, a, b);
+}
+
+/** Normalize [p, p + n) to NFKC in place
+
+    The full decomposition is built in d,
+    which must have room for it. Returns the
+    new size, which is no more than that of
+    the decomposition.
+*/
+inline
+std::size_t
+nfkc_normalize(
+    char32_t* p,
+    std::size_t n,
+    char32_t* d) noexcept
+{
+    std::size_t size = 0;
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        char32_t const cp = p[i];
+        if(cp - hangul_s < hangul_s_count)
+        {
+            size += hangul_decompose(cp, d + size);
+            continue;
+        }
+        auto const v = cp < 0xa0 ? 0 : nfkc_lookup(cp);
+        auto const len = (v >> 9) & 0x1f;
+        if(len == 0)
+        {
+            d[size++] = cp;
+            continue;
+        }
+        std::memcpy(d + size, nfkc_pool + (v >> 15),
+            len * sizeof(char32_t));
+        size += len;
+    }
+    size = recompose(d, size,
+        nfkc_ccc, nfkc_compose);
+    std::memcpy(p, d,
+        size * sizeof(char32_t));
+    return size;
+}
+
+} // detail
+} // punycode
+} // boost
+
+#endif
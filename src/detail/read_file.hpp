@@ -0,0 +1,47 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#ifndef BOOST_PUNYCODE_SRC_DETAIL_READ_FILE_HPP
+#define BOOST_PUNYCODE_SRC_DETAIL_READ_FILE_HPP
+
+#include <boost/system/error_code.hpp>
+#include <cerrno>
+#include <cstdio>
+#include <string>
+
+namespace boost {
+namespace punycode {
+namespace detail {
+
+// append the whole of a file to s
+inline
+system::error_code
+read_file(
+    char const* path,
+    std::string& s)
+{
+    std::FILE* f = std::fopen(path, "rb");
+    if(! f)
+        return system::error_code(
+            errno, system::generic_category());
+    char buf[4096];
+    std::size_t n;
+    while((n = std::fread(buf, 1, sizeof(buf), f)) > 0)
+        s.append(buf, n);
+    int const ev = std::ferror(f) ? EIO : 0;
+    std::fclose(f);
+    return system::error_code(
+        ev, system::generic_category());
+}
+
+} // detail
+} // punycode
+} // boost
+
+#endif
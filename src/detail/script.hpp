@@ -0,0 +1,136 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#ifndef BOOST_PUNYCODE_SRC_DETAIL_SCRIPT_HPP
+#define BOOST_PUNYCODE_SRC_DETAIL_SCRIPT_HPP
+
+#include <boost/punycode/label_info.hpp>
+#include "src/detail/unicode_tables.hpp"
+#include <cstdint>
+
+/*  Restriction levels of UTS #39
+
+    https://www.unicode.org/reports/tr39/#Restriction_Level_Detection
+
+    The resolved script set of a label is the
+    intersection of the augmented Script_Extensions
+    of its characters, where Common and Inherited
+    are every script. It is kept as the label goes
+    by, along with the same intersection over the
+    characters without Latin, which decides the
+    levels between single script and minimally
+    restrictive, as ICU does.
+*/
+
+namespace boost {
+namespace punycode {
+namespace detail {
+
+// properties from script_lookup
+constexpr std::uint64_t script_recommended  = 0x1fffffff;
+constexpr std::uint64_t script_hanb         = 1ull << 30;
+constexpr std::uint64_t script_jpan         = 1ull << 31;
+constexpr std::uint64_t script_kore         = 1ull << 32;
+constexpr std::uint64_t script_allowed      = 1ull << 33;
+constexpr std::uint64_t script_digit        = 1ull << 34;
+
+// the scripts outside the recommended ones
+// which a label of Allowed characters can
+// resolve to alone, one bit each
+constexpr std::uint64_t script_extra = ~0ull << 39;
+
+// the bits of a script set, and those of the
+// resolved one, where script_other stands for
+// any of the others and is never resolved
+constexpr std::uint64_t script_bits =
+    0x1ffffffffull | script_extra;
+constexpr std::uint64_t script_resolved =
+    script_bits & ~std::uint64_t(script_other);
+
+class script_classifier
+{
+    // the union, and the resolved
+    // script sets with and without Latin
+    std::uint32_t seen_ = 0;
+    std::uint64_t resolved_ = script_resolved;
+    std::uint64_t non_latin_ = script_resolved;
+
+    // the zero of the last decimal digit
+    char32_t zero_ = 0;
+    bool digits_ = false;
+    bool digits_mixed_ = false;
+
+    bool ascii_ = true;
+    bool allowed_ = true;
+
+    restriction_level
+    level() const noexcept
+    {
+        if(! allowed_)
+            return restriction_level::unrestricted;
+        if(ascii_)
+            return restriction_level::ascii_only;
+        if(resolved_ != 0)
+            return restriction_level::single_script;
+        if(non_latin_ & (
+                script_hanb | script_jpan | script_kore))
+            return restriction_level::highly_restrictive;
+        if( non_latin_ != 0 &&
+            ! (non_latin_ & (
+                script_cyrillic | script_greek)))
+            return restriction_level::moderately_restrictive;
+        return restriction_level::minimally_restrictive;
+    }
+
+public:
+    void
+    push(char32_t cp) noexcept
+    {
+        auto const v = script_lookup(cp);
+        if(cp >= 0x80)
+            ascii_ = false;
+        if(! (v & script_allowed))
+            allowed_ = false;
+        if(auto const s = v & script_bits)
+        {
+            seen_ |= static_cast<std::uint32_t>(
+                s & (script_recommended | script_other));
+            resolved_ &= s;
+            if(! (s & script_latin))
+                non_latin_ &= s;
+        }
+        if(v & script_digit)
+        {
+            char32_t const zero = cp -
+                static_cast<char32_t>((v >> 35) & 0xf);
+            if(digits_ && zero != zero_)
+                digits_mixed_ = true;
+            zero_ = zero;
+            digits_ = true;
+        }
+    }
+
+    // end a label, returning what was found
+    label_info
+    end_label() noexcept
+    {
+        label_info info;
+        info.scripts = seen_;
+        info.level = level();
+        info.has_digits_mixed = digits_mixed_;
+        *this = script_classifier();
+        return info;
+    }
+};
+
+} // detail
+} // punycode
+} // boost
+
+#endif
@@ -0,0 +1,89 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#include "src/detail/simd.hpp"
+
+namespace boost {
+namespace punycode {
+namespace detail {
+
+static
+simd_level
+detect_simd_level() noexcept
+{
+#if ! defined(BOOST_PUNYCODE_HAS_X86_SIMD)
+    return simd_level::none;
+#elif defined(_MSC_VER) && ! defined(__clang__)
+    int r[4];
+    __cpuid(r, 0);
+    int const max_leaf = r[0];
+    __cpuid(r, 1);
+    bool const sse4 =
+        (r[2] & (1 << 9)) != 0 &&   // ssse3
+        (r[2] & (1 << 19)) != 0 &&  // sse4.1
+        (r[2] & (1 << 23)) != 0;    // popcnt
+    if(! sse4)
+        return simd_level::none;
+    // the os must save the wide registers
+    bool const osxsave = (r[2] & (1 << 27)) != 0;
+    if(! osxsave || max_leaf < 7)
+        return simd_level::sse4;
+    auto const xcr0 = _xgetbv(0);
+    if((xcr0 & 0x6) != 0x6)
+        return simd_level::sse4;
+    __cpuidex(r, 7, 0);
+    // the wide kernels also use bmi and bmi2
+    bool const bmi =
+        (r[1] & (1 << 3)) != 0 &&
+        (r[1] & (1 << 8)) != 0;
+    if(! bmi)
+        return simd_level::sse4;
+    if( (xcr0 & 0xe6) == 0xe6 &&
+        (r[1] & (1 << 16)) != 0 &&  // avx512f
+        (r[1] & (1 << 30)) != 0)    // avx512bw
+        return simd_level::avx512;
+    if((r[1] & (1 << 5)) != 0)      // avx2
+        return simd_level::avx2;
+    return simd_level::sse4;
+#else
+    // these also check that the os
+    // saves the wide registers
+    __builtin_cpu_init();
+    // the wide kernels also use bmi and bmi2
+    bool const bmi =
+        __builtin_cpu_supports("bmi") &&
+        __builtin_cpu_supports("bmi2");
+    // every level counts with popcnt
+    if(! __builtin_cpu_supports("popcnt"))
+        return simd_level::none;
+    if( bmi &&
+        __builtin_cpu_supports("avx512f") &&
+        __builtin_cpu_supports("avx512bw"))
+        return simd_level::avx512;
+    if( bmi &&
+        __builtin_cpu_supports("avx2"))
+        return simd_level::avx2;
+    if( __builtin_cpu_supports("ssse3") &&
+        __builtin_cpu_supports("sse4.1"))
+        return simd_level::sse4;
+    return simd_level::none;
+#endif
+}
+
+simd_level
+cpu_simd_level() noexcept
+{
+    static simd_level const level =
+        detect_simd_level();
+    return level;
+}
+
+} // detail
+} // punycode
+} // boost
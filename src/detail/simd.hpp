@@ -0,0 +1,901 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#ifndef BOOST_PUNYCODE_SRC_DETAIL_SIMD_HPP
+#define BOOST_PUNYCODE_SRC_DETAIL_SIMD_HPP
+
+#include <boost/punycode/detail/simd.hpp>
+#include <boost/punycode/transcode.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/*  Each instruction set gets its own namespace
+    holding the same small vocabulary of register
+    operations. The kernels are written once against
+    that vocabulary and compiled once per namespace,
+    with the matching target attribute, so a single
+    binary carries every variant and picks one at
+    run time from cpu_simd_level().
+*/
+
+#if ! defined(BOOST_PUNYCODE_NO_SIMD) && ( \
+    defined(__x86_64__) || defined(_M_X64) || \
+    defined(__i386__) || defined(_M_IX86))
+# define BOOST_PUNYCODE_HAS_X86_SIMD
+# if defined(_MSC_VER) && ! defined(__clang__)
+#  include <intrin.h>
+#  define BOOST_PUNYCODE_TARGET_SSE4
+#  define BOOST_PUNYCODE_TARGET_AVX2
+#  define BOOST_PUNYCODE_TARGET_AVX512
+# else
+// gcc 12 warns about the deliberately undefined
+// registers inside its own avx-512 intrinsics
+#  if defined(__GNUC__) && ! defined(__clang__)
+#   pragma GCC diagnostic push
+#   pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#  endif
+#  include <immintrin.h>
+#  if defined(__GNUC__) && ! defined(__clang__)
+#   pragma GCC diagnostic pop
+#  endif
+#  define BOOST_PUNYCODE_TARGET_SSE4 \
+    __attribute__((target("ssse3,sse4.1,popcnt")))
+#  define BOOST_PUNYCODE_TARGET_AVX2 \
+    __attribute__((target("avx2,bmi,bmi2,popcnt")))
+#  define BOOST_PUNYCODE_TARGET_AVX512 \
+    __attribute__((target("avx512f,avx512bw,bmi,bmi2,popcnt")))
+# endif
+#endif
+
+namespace boost {
+namespace punycode {
+namespace detail {
+
+// decode one code point of input already known
+// to be well-formed, and return the next octet
+inline
+unsigned char const*
+utf8_decode_valid(
+    unsigned char const* p,
+    char32_t*& d) noexcept
+{
+    std::uint32_t const c = p[0];
+    if(c < 0x80)
+    {
+        *d++ = c;
+        return p + 1;
+    }
+    if(c < 0xe0)
+    {
+        *d++ =
+            ((c & 0x1fu) << 6) |
+            (p[1] & 0x3fu);
+        return p + 2;
+    }
+    if(c < 0xf0)
+    {
+        *d++ =
+            ((c & 0x0fu) << 12) |
+            ((p[1] & 0x3fu) << 6) |
+            (p[2] & 0x3fu);
+        return p + 3;
+    }
+    *d++ =
+        ((c & 0x07u) << 18) |
+        ((p[1] & 0x3fu) << 12) |
+        ((p[2] & 0x3fu) << 6) |
+        (p[3] & 0x3fu);
+    return p + 4;
+}
+
+// length, lead mask and final shift of a
+// sequence, by high nibble of its lead
+template<class = void>
+struct utf8_lead
+{
+    static constexpr std::uint8_t len[16] = {
+        1, 1, 1, 1, 1, 1, 1, 1,
+        1, 1, 1, 1, 2, 2, 3, 4 };
+    static constexpr std::uint8_t mask[16] = {
+        0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f,
+        0x7f, 0x7f, 0x7f, 0x7f, 0x1f, 0x1f, 0x0f, 0x07 };
+    static constexpr std::uint8_t shift[16] = {
+        18, 18, 18, 18, 18, 18, 18, 18,
+        18, 18, 18, 18, 12, 12,  6,  0 };
+};
+
+template<class T>
+constexpr std::uint8_t utf8_lead<T>::len[16];
+
+template<class T>
+constexpr std::uint8_t utf8_lead<T>::mask[16];
+
+template<class T>
+constexpr std::uint8_t utf8_lead<T>::shift[16];
+
+// as above, without branches, for use when
+// at least four octets can be read at p
+inline
+unsigned char const*
+utf8_decode_valid4(
+    unsigned char const* p,
+    char32_t*& d) noexcept
+{
+    using T = utf8_lead<>;
+    unsigned const hi = p[0] >> 4;
+    // assemble four octets as if they were one
+    // sequence, then shift off the ones which
+    // are not part of it
+    *d++ = (
+        (static_cast<std::uint32_t>(p[0] & T::mask[hi]) << 18) |
+        ((p[1] & 0x3fu) << 12) |
+        ((p[2] & 0x3fu) << 6) |
+        (p[3] & 0x3fu)) >> T::shift[hi];
+    return p + T::len[hi];
+}
+
+// encode [p, last) to [d, end), stopping
+// at a code point which is not a scalar
+// value or for which there is no room
+inline
+utf8_encode_result
+utf8_encode_checked(
+    char32_t const* p,
+    char32_t const* const last,
+    char* d,
+    char* const end) noexcept
+{
+    while(p != last)
+    {
+        char32_t const cp = *p;
+        if(cp < 0x80)
+        {
+            if(d == end)
+                break;
+            *d++ = static_cast<char>(cp);
+        }
+        else if(cp < 0x800)
+        {
+            if(end - d < 2)
+                break;
+            *d++ = static_cast<char>( (cp >> 6)          | 0xc0);
+            *d++ = static_cast<char>( (cp & 0x3f)        | 0x80);
+        }
+        else if(cp < 0x10000)
+        {
+            if( end - d < 3 ||
+                (cp >= 0xd800 && cp <= 0xdfff))
+                break;
+            *d++ = static_cast<char>( (cp >> 12)         | 0xe0);
+            *d++ = static_cast<char>(((cp >> 6) & 0x3f)  | 0x80);
+            *d++ = static_cast<char>( (cp       & 0x3f)  | 0x80);
+        }
+        else
+        {
+            if(end - d < 4 || cp > 0x10ffff)
+                break;
+            *d++ = static_cast<char>( (cp >> 18)         | 0xf0);
+            *d++ = static_cast<char>(((cp >> 12) & 0x3f) | 0x80);
+            *d++ = static_cast<char>(((cp >> 6)  & 0x3f) | 0x80);
+            *d++ = static_cast<char>( (cp        & 0x3f) | 0x80);
+        }
+        ++p;
+    }
+    return { p, d };
+}
+
+// index of the lowest set bit of a nonzero mask
+inline
+unsigned
+ctz(std::uint64_t v) noexcept
+{
+#if defined(_MSC_VER) && ! defined(__clang__) && defined(_M_X64)
+    unsigned long i;
+    _BitScanForward64(&i, v);
+    return static_cast<unsigned>(i);
+#elif defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(v));
+#else
+    unsigned i = 0;
+    while(! (v & 1))
+    {
+        v >>= 1;
+        ++i;
+    }
+    return i;
+#endif
+}
+
+// number of set bits
+inline
+unsigned
+popcount(std::uint64_t v) noexcept
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_popcountll(v));
+#else
+    v = v - ((v >> 1) & 0x5555555555555555ull);
+    v = (v & 0x3333333333333333ull) +
+        ((v >> 2) & 0x3333333333333333ull);
+    v = (v + (v >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return static_cast<unsigned>(
+        (v * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+// octets needed to encode [p, last) as utf8
+inline
+std::size_t
+utf8_length_scalar(
+    char32_t const* p,
+    char32_t const* const last) noexcept
+{
+    std::size_t n = 0;
+    for(; p != last; ++p)
+        n += 1 +
+            (*p > 0x7f) +
+            (*p > 0x7ff) +
+            (*p > 0xffff);
+    return n;
+}
+
+// octets in [p, end) which are not
+// continuations, eight at a time
+inline
+std::size_t
+utf32_length_scalar(
+    unsigned char const* p,
+    unsigned char const* const end) noexcept
+{
+    std::size_t n = 0;
+    for(; end - p >= 8; p += 8)
+    {
+        std::uint64_t v;
+        std::memcpy(&v, p, sizeof(v));
+        // the top bit of each continuation
+        n += 8 - popcount(
+            v & ~(v << 1) & 0x8080808080808080ull);
+    }
+    for(; p != end; ++p)
+        n += (*p & 0xc0) != 0x80;
+    return n;
+}
+
+#ifdef BOOST_PUNYCODE_HAS_X86_SIMD
+
+namespace sse4 {
+
+using reg = __m128i;
+
+constexpr std::size_t width = 16;
+
+BOOST_PUNYCODE_TARGET_SSE4
+inline reg load(unsigned char const* p) noexcept
+{
+    return _mm_loadu_si128(
+        reinterpret_cast<reg const*>(p));
+}
+
+BOOST_PUNYCODE_TARGET_SSE4
+inline reg splat(std::uint8_t v) noexcept
+{
+    return _mm_set1_epi8(static_cast<char>(v));
+}
+
+// a 16-entry table, repeated in every lane
+BOOST_PUNYCODE_TARGET_SSE4
+inline reg table(std::uint8_t const* t) noexcept
+{
+    return load(t);
+}
+
+BOOST_PUNYCODE_TARGET_SSE4
+inline reg lookup(reg t, reg nibbles) noexcept
+{
+    return _mm_shuffle_epi8(t, nibbles);
+}
+
+BOOST_PUNYCODE_TARGET_SSE4
+inline reg bit_and(reg a, reg b) noexcept
+{
+    return _mm_and_si128(a, b);
+}
+
+BOOST_PUNYCODE_TARGET_SSE4
+inline reg bit_or(reg a, reg b) noexcept
+{
+    return _mm_or_si128(a, b);
+}
+
+BOOST_PUNYCODE_TARGET_SSE4
+inline reg bit_xor(reg a, reg b) noexcept
+{
+    return _mm_xor_si128(a, b);
+}
+
+BOOST_PUNYCODE_TARGET_SSE4
+inline reg high_nibbles(reg v) noexcept
+{
+    return bit_and(_mm_srli_epi16(v, 4), splat(0x0f));
+}
+
+BOOST_PUNYCODE_TARGET_SSE4
+inline reg low_nibbles(reg v) noexcept
+{
+    return bit_and(v, splat(0x0f));
+}
+
+BOOST_PUNYCODE_TARGET_SSE4
+inline reg subs(reg a, reg b) noexcept
+{
+    return _mm_subs_epu8(a, b);
+}
+
+// v shifted up by N octets, with the
+// top N octets of prev shifted in
+template<int N>
+BOOST_PUNYCODE_TARGET_SSE4
+inline reg prev(reg v, reg prev) noexcept
+{
+    return _mm_alignr_epi8(v, prev, 16 - N);
+}
+
+BOOST_PUNYCODE_TARGET_SSE4
+inline bool is_zero(reg v) noexcept
+{
+    return _mm_testz_si128(v, v) != 0;
+}
+
+BOOST_PUNYCODE_TARGET_SSE4
+inline bool is_ascii(reg v) noexcept
+{
+    return _mm_movemask_epi8(v) == 0;
+}
+
+// bit i set where octet i is not a continuation
+BOOST_PUNYCODE_TARGET_SSE4
+inline std::uint64_t leads(reg v) noexcept
+{
+    return ~static_cast<unsigned>(_mm_movemask_epi8(
+        _mm_cmpgt_epi8(splat(0xc0), v))) & 0xffffu;
+}
+
+BOOST_PUNYCODE_TARGET_SSE4
+inline reg sub8(reg a, reg b) noexcept
+{
+    return _mm_sub_epi8(a, b);
+}
+
+// bit i set where octet i has its top bit set
+BOOST_PUNYCODE_TARGET_SSE4
+inline std::uint64_t top_bits(reg v) noexcept
+{
+    return static_cast<unsigned>(_mm_movemask_epi8(v));
+}
+
+// bit i set where octet i equals x
+BOOST_PUNYCODE_TARGET_SSE4
+inline std::uint64_t equal(reg v, std::uint8_t x) noexcept
+{
+    return static_cast<unsigned>(_mm_movemask_epi8(
+        _mm_cmpeq_epi8(v, splat(x))));
+}
+
+// bit i set where octet i is below x, unsigned
+BOOST_PUNYCODE_TARGET_SSE4
+inline std::uint64_t below(reg v, std::uint8_t x) noexcept
+{
+    return ~static_cast<unsigned>(_mm_movemask_epi8(
+        _mm_cmpeq_epi8(_mm_max_epu8(v, splat(x)), v))) & 0xffffu;
+}
+
+// store every octet of v as a code point
+BOOST_PUNYCODE_TARGET_SSE4
+inline void widen(reg v, char32_t* d) noexcept
+{
+    auto const out = reinterpret_cast<reg*>(d);
+    _mm_storeu_si128(out + 0, _mm_cvtepu8_epi32(v));
+    _mm_storeu_si128(out + 1, _mm_cvtepu8_epi32(
+        _mm_srli_si128(v, 4)));
+    _mm_storeu_si128(out + 2, _mm_cvtepu8_epi32(
+        _mm_srli_si128(v, 8)));
+    _mm_storeu_si128(out + 3, _mm_cvtepu8_epi32(
+        _mm_srli_si128(v, 12)));
+}
+
+// the same, over 32-bit lanes of code points
+
+constexpr std::size_t lanes = width / 4;
+
+BOOST_PUNYCODE_TARGET_SSE4
+inline reg load32(char32_t const* p) noexcept
+{
+    return _mm_loadu_si128(
+        reinterpret_cast<reg const*>(p));
+}
+
+BOOST_PUNYCODE_TARGET_SSE4
+inline reg splat32(std::uint32_t v) noexcept
+{
+    return _mm_set1_epi32(static_cast<int>(v));
+}
+
+BOOST_PUNYCODE_TARGET_SSE4
+inline reg sub32(reg a, reg b) noexcept
+{
+    return _mm_sub_epi32(a, b);
+}
+
+template<int N>
+BOOST_PUNYCODE_TARGET_SSE4
+inline reg shl32(reg v) noexcept
+{
+    return _mm_slli_epi32(v, N);
+}
+
+template<int N>
+BOOST_PUNYCODE_TARGET_SSE4
+inline reg shr32(reg v) noexcept
+{
+    return _mm_srli_epi32(v, N);
+}
+
+// bit i set where lane i is above x, unsigned
+BOOST_PUNYCODE_TARGET_SSE4
+inline std::uint64_t above(reg v, std::uint32_t x) noexcept
+{
+    return static_cast<unsigned>(_mm_movemask_ps(
+        _mm_castsi128_ps(_mm_cmpeq_epi32(
+            _mm_max_epu32(v, splat32(x + 1)), v))));
+}
+
+// the i-th group of four lanes
+BOOST_PUNYCODE_TARGET_SSE4
+inline __m128i quarter(reg v, unsigned) noexcept
+{
+    return v;
+}
+
+// store the low octet of every lane
+BOOST_PUNYCODE_TARGET_SSE4
+inline void narrow(reg v, char* d) noexcept
+{
+    auto const w = _mm_packus_epi16(
+        _mm_packus_epi32(v, v), v);
+    auto const x = static_cast<std::uint32_t>(
+        _mm_cvtsi128_si32(w));
+    std::memcpy(d, &x, sizeof(x));
+}
+
+} // sse4
+
+namespace avx2 {
+
+using reg = __m256i;
+
+constexpr std::size_t width = 32;
+
+BOOST_PUNYCODE_TARGET_AVX2
+inline reg load(unsigned char const* p) noexcept
+{
+    return _mm256_loadu_si256(
+        reinterpret_cast<reg const*>(p));
+}
+
+BOOST_PUNYCODE_TARGET_AVX2
+inline reg splat(std::uint8_t v) noexcept
+{
+    return _mm256_set1_epi8(static_cast<char>(v));
+}
+
+BOOST_PUNYCODE_TARGET_AVX2
+inline reg table(std::uint8_t const* t) noexcept
+{
+    return _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<
+            __m128i const*>(t)));
+}
+
+BOOST_PUNYCODE_TARGET_AVX2
+inline reg lookup(reg t, reg nibbles) noexcept
+{
+    return _mm256_shuffle_epi8(t, nibbles);
+}
+
+BOOST_PUNYCODE_TARGET_AVX2
+inline reg bit_and(reg a, reg b) noexcept
+{
+    return _mm256_and_si256(a, b);
+}
+
+BOOST_PUNYCODE_TARGET_AVX2
+inline reg bit_or(reg a, reg b) noexcept
+{
+    return _mm256_or_si256(a, b);
+}
+
+BOOST_PUNYCODE_TARGET_AVX2
+inline reg bit_xor(reg a, reg b) noexcept
+{
+    return _mm256_xor_si256(a, b);
+}
+
+BOOST_PUNYCODE_TARGET_AVX2
+inline reg high_nibbles(reg v) noexcept
+{
+    return bit_and(_mm256_srli_epi16(v, 4), splat(0x0f));
+}
+
+BOOST_PUNYCODE_TARGET_AVX2
+inline reg low_nibbles(reg v) noexcept
+{
+    return bit_and(v, splat(0x0f));
+}
+
+BOOST_PUNYCODE_TARGET_AVX2
+inline reg subs(reg a, reg b) noexcept
+{
+    return _mm256_subs_epu8(a, b);
+}
+
+// alignr works within 128-bit lanes, so
+// first line up the lane below each lane
+template<int N>
+BOOST_PUNYCODE_TARGET_AVX2
+inline reg prev(reg v, reg prev) noexcept
+{
+    return _mm256_alignr_epi8(v,
+        _mm256_permute2x128_si256(prev, v, 0x21),
+        16 - N);
+}
+
+BOOST_PUNYCODE_TARGET_AVX2
+inline bool is_zero(reg v) noexcept
+{
+    return _mm256_testz_si256(v, v) != 0;
+}
+
+BOOST_PUNYCODE_TARGET_AVX2
+inline bool is_ascii(reg v) noexcept
+{
+    return _mm256_movemask_epi8(v) == 0;
+}
+
+BOOST_PUNYCODE_TARGET_AVX2
+inline std::uint64_t leads(reg v) noexcept
+{
+    return ~static_cast<std::uint32_t>(_mm256_movemask_epi8(
+        _mm256_cmpgt_epi8(splat(0xc0), v)));
+}
+
+BOOST_PUNYCODE_TARGET_AVX2
+inline reg sub8(reg a, reg b) noexcept
+{
+    return _mm256_sub_epi8(a, b);
+}
+
+BOOST_PUNYCODE_TARGET_AVX2
+inline std::uint64_t top_bits(reg v) noexcept
+{
+    return static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(v));
+}
+
+BOOST_PUNYCODE_TARGET_AVX2
+inline std::uint64_t equal(reg v, std::uint8_t x) noexcept
+{
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(
+        _mm256_cmpeq_epi8(v, splat(x))));
+}
+
+BOOST_PUNYCODE_TARGET_AVX2
+inline std::uint64_t below(reg v, std::uint8_t x) noexcept
+{
+    return ~static_cast<std::uint32_t>(_mm256_movemask_epi8(
+        _mm256_cmpeq_epi8(_mm256_max_epu8(v, splat(x)), v)));
+}
+
+BOOST_PUNYCODE_TARGET_AVX2
+inline void widen(reg v, char32_t* d) noexcept
+{
+    auto const out = reinterpret_cast<reg*>(d);
+    auto const lo = _mm256_castsi256_si128(v);
+    auto const hi = _mm256_extracti128_si256(v, 1);
+    _mm256_storeu_si256(out + 0, _mm256_cvtepu8_epi32(lo));
+    _mm256_storeu_si256(out + 1, _mm256_cvtepu8_epi32(
+        _mm_srli_si128(lo, 8)));
+    _mm256_storeu_si256(out + 2, _mm256_cvtepu8_epi32(hi));
+    _mm256_storeu_si256(out + 3, _mm256_cvtepu8_epi32(
+        _mm_srli_si128(hi, 8)));
+}
+
+constexpr std::size_t lanes = width / 4;
+
+BOOST_PUNYCODE_TARGET_AVX2
+inline reg load32(char32_t const* p) noexcept
+{
+    return _mm256_loadu_si256(
+        reinterpret_cast<reg const*>(p));
+}
+
+BOOST_PUNYCODE_TARGET_AVX2
+inline reg splat32(std::uint32_t v) noexcept
+{
+    return _mm256_set1_epi32(static_cast<int>(v));
+}
+
+BOOST_PUNYCODE_TARGET_AVX2
+inline reg sub32(reg a, reg b) noexcept
+{
+    return _mm256_sub_epi32(a, b);
+}
+
+template<int N>
+BOOST_PUNYCODE_TARGET_AVX2
+inline reg shl32(reg v) noexcept
+{
+    return _mm256_slli_epi32(v, N);
+}
+
+template<int N>
+BOOST_PUNYCODE_TARGET_AVX2
+inline reg shr32(reg v) noexcept
+{
+    return _mm256_srli_epi32(v, N);
+}
+
+BOOST_PUNYCODE_TARGET_AVX2
+inline std::uint64_t above(reg v, std::uint32_t x) noexcept
+{
+    return static_cast<unsigned>(_mm256_movemask_ps(
+        _mm256_castsi256_ps(_mm256_cmpeq_epi32(
+            _mm256_max_epu32(v, splat32(x + 1)), v))));
+}
+
+BOOST_PUNYCODE_TARGET_AVX2
+inline __m128i quarter(reg v, unsigned i) noexcept
+{
+    return i == 0 ?
+        _mm256_castsi256_si128(v) :
+        _mm256_extracti128_si256(v, 1);
+}
+
+// gather the low octets within each 128-bit
+// lane, then the two groups of four together
+BOOST_PUNYCODE_TARGET_AVX2
+inline void narrow(reg v, char* d) noexcept
+{
+    auto const w = _mm256_permutevar8x32_epi32(
+        _mm256_shuffle_epi8(v, _mm256_setr_epi8(
+            0, 4, 8, 12, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1,
+            0, 4, 8, 12, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1)),
+        _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(d),
+        _mm256_castsi256_si128(w));
+}
+
+} // avx2
+
+namespace avx512 {
+
+using reg = __m512i;
+
+constexpr std::size_t width = 64;
+
+BOOST_PUNYCODE_TARGET_AVX512
+inline reg load(unsigned char const* p) noexcept
+{
+    return _mm512_loadu_si512(p);
+}
+
+BOOST_PUNYCODE_TARGET_AVX512
+inline reg splat(std::uint8_t v) noexcept
+{
+    return _mm512_set1_epi8(static_cast<char>(v));
+}
+
+BOOST_PUNYCODE_TARGET_AVX512
+inline reg table(std::uint8_t const* t) noexcept
+{
+    return _mm512_broadcast_i32x4(
+        _mm_loadu_si128(reinterpret_cast<
+            __m128i const*>(t)));
+}
+
+BOOST_PUNYCODE_TARGET_AVX512
+inline reg lookup(reg t, reg nibbles) noexcept
+{
+    return _mm512_shuffle_epi8(t, nibbles);
+}
+
+BOOST_PUNYCODE_TARGET_AVX512
+inline reg bit_and(reg a, reg b) noexcept
+{
+    return _mm512_and_si512(a, b);
+}
+
+BOOST_PUNYCODE_TARGET_AVX512
+inline reg bit_or(reg a, reg b) noexcept
+{
+    return _mm512_or_si512(a, b);
+}
+
+BOOST_PUNYCODE_TARGET_AVX512
+inline reg bit_xor(reg a, reg b) noexcept
+{
+    return _mm512_xor_si512(a, b);
+}
+
+BOOST_PUNYCODE_TARGET_AVX512
+inline reg high_nibbles(reg v) noexcept
+{
+    return bit_and(_mm512_srli_epi16(v, 4), splat(0x0f));
+}
+
+BOOST_PUNYCODE_TARGET_AVX512
+inline reg low_nibbles(reg v) noexcept
+{
+    return bit_and(v, splat(0x0f));
+}
+
+BOOST_PUNYCODE_TARGET_AVX512
+inline reg subs(reg a, reg b) noexcept
+{
+    return _mm512_subs_epu8(a, b);
+}
+
+// as with avx2, but the lane below lane 0
+// is the top lane of prev
+template<int N>
+BOOST_PUNYCODE_TARGET_AVX512
+inline reg prev(reg v, reg prev) noexcept
+{
+    return _mm512_alignr_epi8(v,
+        _mm512_alignr_epi64(v, prev, 6),
+        16 - N);
+}
+
+BOOST_PUNYCODE_TARGET_AVX512
+inline bool is_zero(reg v) noexcept
+{
+    return _mm512_test_epi8_mask(v, v) == 0;
+}
+
+BOOST_PUNYCODE_TARGET_AVX512
+inline bool is_ascii(reg v) noexcept
+{
+    return _mm512_movepi8_mask(v) == 0;
+}
+
+BOOST_PUNYCODE_TARGET_AVX512
+inline std::uint64_t leads(reg v) noexcept
+{
+    return ~static_cast<std::uint64_t>(
+        _mm512_cmpgt_epi8_mask(splat(0xc0), v));
+}
+
+BOOST_PUNYCODE_TARGET_AVX512
+inline reg sub8(reg a, reg b) noexcept
+{
+    return _mm512_sub_epi8(a, b);
+}
+
+BOOST_PUNYCODE_TARGET_AVX512
+inline std::uint64_t top_bits(reg v) noexcept
+{
+    return _mm512_movepi8_mask(v);
+}
+
+BOOST_PUNYCODE_TARGET_AVX512
+inline std::uint64_t equal(reg v, std::uint8_t x) noexcept
+{
+    return _mm512_cmpeq_epi8_mask(v, splat(x));
+}
+
+BOOST_PUNYCODE_TARGET_AVX512
+inline std::uint64_t below(reg v, std::uint8_t x) noexcept
+{
+    return _mm512_cmplt_epu8_mask(v, splat(x));
+}
+
+BOOST_PUNYCODE_TARGET_AVX512
+inline void widen(reg v, char32_t* d) noexcept
+{
+    auto const out = reinterpret_cast<reg*>(d);
+    _mm512_storeu_si512(out + 0, _mm512_cvtepu8_epi32(
+        _mm512_castsi512_si128(v)));
+    _mm512_storeu_si512(out + 1, _mm512_cvtepu8_epi32(
+        _mm512_extracti32x4_epi32(v, 1)));
+    _mm512_storeu_si512(out + 2, _mm512_cvtepu8_epi32(
+        _mm512_extracti32x4_epi32(v, 2)));
+    _mm512_storeu_si512(out + 3, _mm512_cvtepu8_epi32(
+        _mm512_extracti32x4_epi32(v, 3)));
+}
+
+constexpr std::size_t lanes = width / 4;
+
+BOOST_PUNYCODE_TARGET_AVX512
+inline reg load32(char32_t const* p) noexcept
+{
+    return _mm512_loadu_si512(p);
+}
+
+BOOST_PUNYCODE_TARGET_AVX512
+inline reg splat32(std::uint32_t v) noexcept
+{
+    return _mm512_set1_epi32(static_cast<int>(v));
+}
+
+BOOST_PUNYCODE_TARGET_AVX512
+inline reg sub32(reg a, reg b) noexcept
+{
+    return _mm512_sub_epi32(a, b);
+}
+
+template<int N>
+BOOST_PUNYCODE_TARGET_AVX512
+inline reg shl32(reg v) noexcept
+{
+    return _mm512_slli_epi32(v, N);
+}
+
+template<int N>
+BOOST_PUNYCODE_TARGET_AVX512
+inline reg shr32(reg v) noexcept
+{
+    return _mm512_srli_epi32(v, N);
+}
+
+BOOST_PUNYCODE_TARGET_AVX512
+inline std::uint64_t above(reg v, std::uint32_t x) noexcept
+{
+    return _mm512_cmpgt_epu32_mask(v, splat32(x));
+}
+
+BOOST_PUNYCODE_TARGET_AVX512
+inline __m128i quarter(reg v, unsigned i) noexcept
+{
+    switch(i)
+    {
+    case 0: return _mm512_castsi512_si128(v);
+    case 1: return _mm512_extracti32x4_epi32(v, 1);
+    case 2: return _mm512_extracti32x4_epi32(v, 2);
+    default: return _mm512_extracti32x4_epi32(v, 3);
+    }
+}
+
+BOOST_PUNYCODE_TARGET_AVX512
+inline void narrow(reg v, char* d) noexcept
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(d),
+        _mm512_cvtepi32_epi8(v));
+}
+
+} // avx512
+
+#endif
+
+// the level asked for, lowered
+// to what the processor has
+inline
+simd_level
+usable(simd_level level) noexcept
+{
+    auto const cpu = cpu_simd_level();
+    return level < cpu ? level : cpu;
+}
+
+} // detail
+} // punycode
+} // boost
+
+#endif
@@ -0,0 +1,146 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#ifndef BOOST_PUNYCODE_SRC_DETAIL_U32_BUFFER_HPP
+#define BOOST_PUNYCODE_SRC_DETAIL_U32_BUFFER_HPP
+
+#include <boost/assert.hpp>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+
+namespace boost {
+namespace punycode {
+namespace detail {
+
+// a growable array of code points, kept on
+// the stack while it holds few enough
+class u32_buffer
+{
+    static constexpr std::size_t inline_size = 256;
+
+    char32_t buf_[inline_size];
+    std::unique_ptr<char32_t[]> big_;
+    char32_t* p_ = buf_;
+    std::size_t n_ = 0;
+    std::size_t cap_ = inline_size;
+
+    void
+    grow(std::size_t need)
+    {
+        auto cap = cap_ * 2;
+        while(cap < need)
+            cap *= 2;
+        std::unique_ptr<char32_t[]> p(
+            new char32_t[cap]);
+        std::memcpy(p.get(), p_,
+            n_ * sizeof(char32_t));
+        big_ = std::move(p);
+        p_ = big_.get();
+        cap_ = cap;
+    }
+
+public:
+    u32_buffer() = default;
+    u32_buffer(u32_buffer const&) = delete;
+    u32_buffer& operator=(u32_buffer const&) = delete;
+
+    char32_t*
+    data() noexcept
+    {
+        return p_;
+    }
+
+    char32_t const*
+    data() const noexcept
+    {
+        return p_;
+    }
+
+    std::size_t
+    size() const noexcept
+    {
+        return n_;
+    }
+
+    char32_t*
+    begin() noexcept
+    {
+        return p_;
+    }
+
+    char32_t*
+    end() noexcept
+    {
+        return p_ + n_;
+    }
+
+    char32_t&
+    operator[](std::size_t i) noexcept
+    {
+        BOOST_ASSERT(i < n_);
+        return p_[i];
+    }
+
+    void
+    clear() noexcept
+    {
+        n_ = 0;
+    }
+
+    // make room for n more, returning
+    // where they are to be written
+    char32_t*
+    prepare(std::size_t n)
+    {
+        if(cap_ - n_ < n)
+            grow(n_ + n);
+        return p_ + n_;
+    }
+
+    // keep n of the prepared code points
+    void
+    commit(std::size_t n) noexcept
+    {
+        BOOST_ASSERT(n <= cap_ - n_);
+        n_ += n;
+    }
+
+    void
+    resize(std::size_t n)
+    {
+        if(n > cap_)
+            grow(n);
+        n_ = n;
+    }
+
+    void
+    push_back(char32_t cp)
+    {
+        if(n_ == cap_)
+            grow(n_ + 1);
+        p_[n_++] = cp;
+    }
+
+    void
+    append(
+        char32_t const* p,
+        std::size_t n)
+    {
+        std::memcpy(prepare(n), p,
+            n * sizeof(char32_t));
+        n_ += n;
+    }
+};
+
+} // detail
+} // punycode
+} // boost
+
+#endif
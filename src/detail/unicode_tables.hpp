@@ -0,0 +1,248 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+// Generated by tools/unicode_tables.py from
+// the data files of Unicode 16.0.0, with the
+// confusables of UTS #39 16.0.0, its
+// identifier status 15.0.0, and 3.2.0 for
+// nameprep. Do not edit.
+
+#ifndef BOOST_PUNYCODE_SRC_DETAIL_UNICODE_TABLES_HPP
+#define BOOST_PUNYCODE_SRC_DETAIL_UNICODE_TABLES_HPP
+
+#include <boost/assert.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost {
+namespace punycode {
+namespace detail {
+
+// UTS #46 mapping: the status in bits 0-2, and
+// in bit 3 whether the result may need the
+// normalization pass. A mapping to one code
+// point is the signed distance to it in bits
+// 8-31, and any other has its length in bits
+// 4-8 and its offset in uts46_pool in 9-31
+extern std::uint8_t const uts46_lookup_top[];
+extern std::uint16_t const uts46_lookup_mid[];
+extern std::uint32_t const uts46_lookup_leaf[];
+
+inline
+std::uint32_t
+uts46_lookup(char32_t cp) noexcept
+{
+    BOOST_ASSERT(cp < 0x110000);
+    std::uint32_t const i = uts46_lookup_top[
+        cp >> 8];
+    std::uint32_t const j = uts46_lookup_mid[
+        (i << 5) | ((cp >> 3) & 31)];
+    return uts46_lookup_leaf[
+        (j << 3) | (cp & 7)];
+}
+
+extern char32_t const uts46_pool[];
+
+// normalization: the canonical combining class
+// in bits 0-7, NFC_Quick_Check other than Yes
+// in bit 8, a mark in bit 9, and the full
+// canonical decomposition as a length in bits
+// 10-12 and an offset in nfc_pool in 13-31
+extern std::uint8_t const nfc_lookup_top[];
+extern std::uint16_t const nfc_lookup_mid[];
+extern std::uint32_t const nfc_lookup_leaf[];
+
+inline
+std::uint32_t
+nfc_lookup(char32_t cp) noexcept
+{
+    BOOST_ASSERT(cp < 0x110000);
+    std::uint32_t const i = nfc_lookup_top[
+        cp >> 9];
+    std::uint32_t const j = nfc_lookup_mid[
+        (i << 6) | ((cp >> 3) & 63)];
+    return nfc_lookup_leaf[
+        (j << 3) | (cp & 7)];
+}
+
+extern char32_t const nfc_pool[];
+
+// primary composites, as the first code point
+// in bits 42-62, the second in 21-41 and the
+// composite in bits 0-20, sorted
+extern std::uint64_t const nfc_compose_table[];
+constexpr std::size_t nfc_compose_size = 961;
+
+// NFKC of Unicode 3.2, for nameprep: the
+// canonical combining class in bits 0-7,
+// NFKC_Quick_Check other than Yes in bit 8,
+// the full compatibility decomposition as a
+// length in bits 9-13 and an offset in
+// nfkc_pool in 15-31, and in bit 14 whether
+// the NFKC has a character nameprep
+// prohibits. Hangul syllables have the
+// length and no offset.
+extern std::uint8_t const nfkc_lookup_top[];
+extern std::uint16_t const nfkc_lookup_mid[];
+extern std::uint32_t const nfkc_lookup_leaf[];
+
+inline
+std::uint32_t
+nfkc_lookup(char32_t cp) noexcept
+{
+    BOOST_ASSERT(cp < 0x110000);
+    std::uint32_t const i = nfkc_lookup_top[
+        cp >> 9];
+    std::uint32_t const j = nfkc_lookup_mid[
+        (i << 6) | ((cp >> 3) & 63)];
+    return nfkc_lookup_leaf[
+        (j << 3) | (cp & 7)];
+}
+
+extern char32_t const nfkc_pool[];
+
+// primary composites, as in nfc_compose_table
+extern std::uint64_t const nfkc_compose_table[];
+constexpr std::size_t nfkc_compose_size = 917;
+
+// input code points nameprep prohibits, and
+// those along with the ones unassigned in
+// Unicode 3.2, which stored strings reject
+extern std::uint8_t const prohibited_bits_index[];
+extern std::uint64_t const prohibited_bits_words[];
+
+inline
+bool
+prohibited_bits(char32_t cp) noexcept
+{
+    BOOST_ASSERT(cp < 0x110000);
+    std::uint32_t const i = prohibited_bits_index[
+        cp >> 10];
+    return (prohibited_bits_words[
+        (i << 4) | ((cp >> 6) & 15)] >>
+            (cp & 63)) & 1;
+}
+
+extern std::uint8_t const prohibited_unassigned_bits_index[];
+extern std::uint64_t const prohibited_unassigned_bits_words[];
+
+inline
+bool
+prohibited_unassigned_bits(char32_t cp) noexcept
+{
+    BOOST_ASSERT(cp < 0x110000);
+    std::uint32_t const i = prohibited_unassigned_bits_index[
+        cp >> 10];
+    return (prohibited_unassigned_bits_words[
+        (i << 4) | ((cp >> 6) & 15)] >>
+            (cp & 63)) & 1;
+}
+
+// the bidi class, as the index in
+// L R AL AN EN ES CS ET ON BN NSM, or 11
+// for the classes the Bidi Rule never allows
+extern std::uint8_t const bidi_lookup_top[];
+extern std::uint16_t const bidi_lookup_mid[];
+extern std::uint8_t const bidi_lookup_leaf[];
+
+inline
+std::uint32_t
+bidi_lookup(char32_t cp) noexcept
+{
+    BOOST_ASSERT(cp < 0x110000);
+    std::uint32_t const i = bidi_lookup_top[
+        cp >> 10];
+    std::uint32_t const j = bidi_lookup_mid[
+        (i << 6) | ((cp >> 4) & 63)];
+    return bidi_lookup_leaf[
+        (j << 4) | (cp & 15)];
+}
+
+// properties for the contextual rules of
+// RFC 5892: Joining_Type T in bit 0, L or D
+// in bit 1 and R or D in bit 2, the scripts
+// Greek in bit 3, Hebrew in bit 4, and
+// Hiragana, Katakana or Han in bit 5, and
+// a combining class of Virama in bit 6
+extern std::uint8_t const context_lookup_top[];
+extern std::uint16_t const context_lookup_mid[];
+extern std::uint8_t const context_lookup_leaf[];
+
+inline
+std::uint32_t
+context_lookup(char32_t cp) noexcept
+{
+    BOOST_ASSERT(cp < 0x110000);
+    std::uint32_t const i = context_lookup_top[
+        cp >> 9];
+    std::uint32_t const j = context_lookup_mid[
+        (i << 5) | ((cp >> 4) & 31)];
+    return context_lookup_leaf[
+        (j << 4) | (cp & 15)];
+}
+
+// the prototype of UTS #39, for code points
+// which are their own NFD, as an index in
+// confusable_prototypes, or zero if it is
+// the code point. Each prototype has its
+// length in bits 0-4 and its offset in
+// confusable_pool in 5-31.
+extern std::uint8_t const confusable_lookup_top[];
+extern std::uint16_t const confusable_lookup_mid[];
+extern std::uint16_t const confusable_lookup_leaf[];
+
+inline
+std::uint32_t
+confusable_lookup(char32_t cp) noexcept
+{
+    BOOST_ASSERT(cp < 0x110000);
+    std::uint32_t const i = confusable_lookup_top[
+        cp >> 8];
+    std::uint32_t const j = confusable_lookup_mid[
+        (i << 5) | ((cp >> 3) & 31)];
+    return confusable_lookup_leaf[
+        (j << 3) | (cp & 7)];
+}
+
+extern std::uint32_t const confusable_prototypes[];
+extern char32_t const confusable_pool[];
+
+// scripts and identifier status of UTS #39:
+// a bit for each recommended script in the
+// Script_Extensions in bits 0-28, any other
+// script in bit 29, and the augmenting sets
+// Hanb, Jpan and Kore in bits 30-32, with
+// none for Common or Inherited. Bit 33 is
+// Identifier_Status Allowed, bit 34 a decimal
+// digit, and its value is in bits 35-38. The
+// other scripts of Allowed characters which a
+// label can resolve to alone have a bit each
+// from bit 39 up
+extern std::uint8_t const script_lookup_top[];
+extern std::uint16_t const script_lookup_mid[];
+extern std::uint64_t const script_lookup_leaf[];
+
+inline
+std::uint64_t
+script_lookup(char32_t cp) noexcept
+{
+    BOOST_ASSERT(cp < 0x110000);
+    std::uint32_t const i = script_lookup_top[
+        cp >> 8];
+    std::uint32_t const j = script_lookup_mid[
+        (i << 5) | ((cp >> 3) & 31)];
+    return script_lookup_leaf[
+        (j << 3) | (cp & 7)];
+}
+
+} // detail
+} // punycode
+} // boost
+
+#endif
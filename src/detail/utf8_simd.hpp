@@ -0,0 +1,490 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+/*  utf8 kernels for one instruction set
+
+    This file has no include guard. It is included
+    once per instruction set with the namespace and
+    target attribute set by the includer:
+
+        #define BOOST_PUNYCODE_SIMD_NS      avx2
+        #define BOOST_PUNYCODE_SIMD_TARGET  BOOST_PUNYCODE_TARGET_AVX2
+        #include "src/detail/utf8_simd.hpp"
+
+    and uses the register operations declared in
+    that namespace by src/detail/simd.hpp.
+*/
+
+#include <boost/punycode/detail/utf8_dfa.hpp>
+#include "src/detail/simd.hpp"
+#include <cstring>
+
+#ifndef BOOST_PUNYCODE_SRC_DETAIL_UTF8_SIMD_TABLES
+#define BOOST_PUNYCODE_SRC_DETAIL_UTF8_SIMD_TABLES
+
+namespace boost {
+namespace punycode {
+namespace detail {
+
+/*  Nibble tables for the validation algorithm of
+    Keiser and Lemire, "Validating UTF-8 In Less
+    Than One Instruction Per Byte" (2021).
+
+    Each error is a bit. The high and low nibble of
+    an octet and the high nibble of the one after it
+    each look up the set of errors they could be part
+    of, and an error is present only where all three
+    agree. Three and four octet sequences are checked
+    by requiring continuations two and three octets
+    after their leads.
+*/
+template<class = void>
+struct utf8_lookup
+{
+    enum : std::uint8_t
+    {
+        too_short       = 1 << 0,   // 11______ 0_______
+                                    // 11______ 11______
+        too_long        = 1 << 1,   // 0_______ 10______
+        overlong_3      = 1 << 2,   // 11100000 100_____
+        too_large       = 1 << 3,   // 11110100 1001____
+                                    // 11110100 101_____
+                                    // 11110101 ........
+        surrogate       = 1 << 4,   // 11101101 101_____
+        overlong_2      = 1 << 5,   // 1100000_ 10______
+        too_large_1000  = 1 << 6,   // 11110101 1000____
+        overlong_4      = 1 << 6,   // 11110000 1000____
+        two_conts       = 1 << 7,   // 10______ 10______
+        carry = too_short | too_long | two_conts
+    };
+
+    static constexpr std::uint8_t byte_1_high[16] = {
+        // 0_______ ascii
+        too_long, too_long, too_long, too_long,
+        too_long, too_long, too_long, too_long,
+        // 10______ continuation
+        two_conts, two_conts, two_conts, two_conts,
+        // 1100____ two octet lead
+        too_short | overlong_2,
+        // 1101____ two octet lead
+        too_short,
+        // 1110____ three octet lead
+        too_short | overlong_3 | surrogate,
+        // 1111____ four octet lead
+        too_short | too_large | too_large_1000 | overlong_4 };
+
+    static constexpr std::uint8_t byte_1_low[16] = {
+        // ____0000
+        carry | overlong_3 | overlong_2 | overlong_4,
+        // ____0001
+        carry | overlong_2,
+        // ____001_
+        carry,
+        carry,
+        // ____0100
+        carry | too_large,
+        // ____0101
+        carry | too_large | too_large_1000,
+        // ____011_
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        // ____1___
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000,
+        // ____1101
+        carry | too_large | too_large_1000 | surrogate,
+        carry | too_large | too_large_1000,
+        carry | too_large | too_large_1000 };
+
+    static constexpr std::uint8_t byte_2_high[16] = {
+        // ________ 0_______
+        too_short, too_short, too_short, too_short,
+        too_short, too_short, too_short, too_short,
+        // ________ 1000____
+        too_long | overlong_2 | two_conts |
+            overlong_3 | too_large_1000 | overlong_4,
+        // ________ 1001____
+        too_long | overlong_2 | two_conts |
+            overlong_3 | too_large,
+        // ________ 101_____
+        too_long | overlong_2 | two_conts |
+            surrogate | too_large,
+        too_long | overlong_2 | two_conts |
+            surrogate | too_large,
+        // ________ 11______
+        too_short, too_short, too_short, too_short };
+
+    // the last three octets of a block are a lead
+    // whose sequence runs past the block if they
+    // are above these, respectively
+    static constexpr std::uint8_t incomplete[128] = {
+        255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 255, 255, 255,
+        255, 255, 255, 255, 255, 0xef, 0xdf, 0xbf };
+};
+
+template<class T>
+constexpr std::uint8_t utf8_lookup<T>::byte_1_high[16];
+
+template<class T>
+constexpr std::uint8_t utf8_lookup<T>::byte_1_low[16];
+
+template<class T>
+constexpr std::uint8_t utf8_lookup<T>::byte_2_high[16];
+
+template<class T>
+constexpr std::uint8_t utf8_lookup<T>::incomplete[128];
+
+/*  Shuffles which pack four lanes of up to three
+    octets each into consecutive output. A lane
+    holds, from its lowest octet up, the lead of
+    a three octet sequence, the second octet or the
+    lead of a two octet sequence, the last octet,
+    and the code point itself for ascii. The key
+    has a bit per lane above 0x7f in its low four
+    bits and a bit per lane above 0x7ff in its
+    high four.
+*/
+struct utf8_pack
+{
+    std::uint8_t shuffle[256][16];
+    std::uint8_t len[256];
+
+    utf8_pack() noexcept
+    {
+        for(unsigned key = 0; key < 256; ++key)
+        {
+            unsigned n = 0;
+            for(unsigned i = 0; i < 4; ++i)
+            {
+                unsigned const at = 4 * i;
+                if(! ((key >> i) & 1))
+                {
+                    shuffle[key][n++] = at + 3;
+                    continue;
+                }
+                if((key >> (i + 4)) & 1)
+                    shuffle[key][n++] = at;
+                shuffle[key][n++] = at + 1;
+                shuffle[key][n++] = at + 2;
+            }
+            len[key] = static_cast<std::uint8_t>(n);
+            while(n < 16)
+                shuffle[key][n++] = 0x80;
+        }
+    }
+};
+
+inline
+utf8_pack const&
+utf8_pack_table() noexcept
+{
+    static utf8_pack const t;
+    return t;
+}
+
+} // detail
+} // punycode
+} // boost
+
+#endif
+
+namespace boost {
+namespace punycode {
+namespace detail {
+namespace BOOST_PUNYCODE_SIMD_NS {
+
+// nonzero where the block `in`,
+// following `prev_in`, is malformed
+BOOST_PUNYCODE_SIMD_TARGET
+inline
+reg
+utf8_check(
+    reg in,
+    reg prev_in) noexcept
+{
+    using T = utf8_lookup<>;
+    reg const prev1 = prev<1>(in, prev_in);
+    reg const special = bit_and(bit_and(
+        lookup(table(T::byte_1_high), high_nibbles(prev1)),
+        lookup(table(T::byte_1_low), low_nibbles(prev1))),
+        lookup(table(T::byte_2_high), high_nibbles(in)));
+
+    // the second and third octets after a lead
+    // of three or four must be continuations,
+    // which the lookup marks as two_conts
+    reg const third = subs(
+        prev<2>(in, prev_in), splat(0xe0 - 0x80));
+    reg const fourth = subs(
+        prev<3>(in, prev_in), splat(0xf0 - 0x80));
+    reg const must23 = bit_and(
+        bit_or(third, fourth), splat(0x80));
+    return bit_xor(must23, special);
+}
+
+BOOST_PUNYCODE_SIMD_TARGET
+inline
+reg
+utf8_incomplete(reg in) noexcept
+{
+    return subs(in, load(
+        utf8_lookup<>::incomplete + 128 - width));
+}
+
+/** Return true if [p, p + n) is well-formed utf8
+*/
+BOOST_PUNYCODE_SIMD_TARGET
+inline
+bool
+utf8_validate(
+    unsigned char const* p,
+    std::size_t n) noexcept
+{
+    reg error = splat(0);
+    reg prev_in = splat(0);
+    reg prev_incomplete = splat(0);
+    for(; n >= width; p += width, n -= width)
+    {
+        reg const in = load(p);
+        if(is_ascii(in))
+        {
+            // only a sequence left open by
+            // the block before can be wrong
+            error = bit_or(error, prev_incomplete);
+        }
+        else
+        {
+            error = bit_or(error,
+                utf8_check(in, prev_in));
+            prev_incomplete = utf8_incomplete(in);
+        }
+        prev_in = in;
+    }
+    if(n > 0)
+    {
+        // padding with ascii makes a sequence
+        // cut off by the end show up as too_short
+        unsigned char tail[width] = {};
+        std::memcpy(tail, p, n);
+        error = bit_or(error,
+            utf8_check(load(tail), prev_in));
+    }
+    else
+    {
+        error = bit_or(error, prev_incomplete);
+    }
+    return is_zero(error);
+}
+
+/** Decode [p, p + n) to dest
+
+    Returns the number of code points written,
+    or SIZE_MAX if the input is not well-formed.
+    `dest` needs room for `n` code points.
+*/
+BOOST_PUNYCODE_SIMD_TARGET
+inline
+std::size_t
+utf8_decode(
+    unsigned char const* p,
+    std::size_t n,
+    char32_t* const dest) noexcept
+{
+    if(! utf8_validate(p, n))
+        return SIZE_MAX;
+    // from here on every sequence is complete
+    // and in range, so no octet is checked again
+    auto const end = p + n;
+    auto d = dest;
+    // the slack of three lets the last
+    // sequence of a block be read whole
+    while(static_cast<std::size_t>(end - p) >= width + 3)
+    {
+        reg const in = load(p);
+        if(is_ascii(in))
+        {
+            widen(in, d);
+            d += width;
+            p += width;
+            continue;
+        }
+        // each sequence starting in the block is
+        // decoded from its own offset, so that no
+        // decode waits on the length of the last
+        for(auto m = leads(in); m; m &= m - 1)
+            utf8_decode_valid4(p + ctz(m), d);
+        p += width;
+    }
+    // skip the rest of a sequence
+    // decoded by the last block
+    while(p < end && (*p & 0xc0) == 0x80)
+        ++p;
+    while(p < end)
+    {
+        if(end - p >= 8 && utf8_ascii8(p))
+        {
+            for(int i = 0; i < 8; ++i)
+                *d++ = p[i];
+            p += 8;
+            continue;
+        }
+        p = utf8_decode_valid(p, d);
+    }
+    return static_cast<std::size_t>(d - dest);
+}
+
+// encode one group of four lanes
+// with the shuffle for its key
+BOOST_PUNYCODE_SIMD_TARGET
+inline
+char*
+utf8_pack4(
+    utf8_pack const& t,
+    __m128i v,
+    unsigned key,
+    char* d) noexcept
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(d),
+        _mm_shuffle_epi8(v, _mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(
+                t.shuffle[key]))));
+    return d + t.len[key];
+}
+
+/** Encode [first, last) to [d, end)
+*/
+BOOST_PUNYCODE_SIMD_TARGET
+inline
+utf8_encode_result
+utf8_encode(
+    char32_t const* p,
+    char32_t const* const last,
+    char* d,
+    char* const end) noexcept
+{
+    auto const& t = utf8_pack_table();
+    // a block writes at most four octets a
+    // lane, and the last group stores a whole
+    // 128-bit register wherever it starts
+    while(
+        static_cast<std::size_t>(last - p) >= lanes &&
+        static_cast<std::size_t>(end - d) >= 4 * lanes + 16)
+    {
+        reg const v = load32(p);
+        auto const big = above(v, 0x7f);
+        if(! big)
+        {
+            narrow(v, d);
+            d += lanes;
+            p += lanes;
+            continue;
+        }
+        auto const surrogate =
+            above(v, 0xd7ff) & ~above(v, 0xdfff);
+        if(above(v, 0xffff) | surrogate)
+        {
+            // rare, so the scalar encoder takes the
+            // block, and stops on an invalid lane
+            auto const rv = utf8_encode_checked(
+                p, p + lanes, d, end);
+            if(rv.in != p + lanes)
+                return rv;
+            p = rv.in;
+            d = rv.out;
+            continue;
+        }
+        auto const three = above(v, 0x7ff);
+        // below 0x800 the subtraction borrows into
+        // the top bit, which becomes the 0x40 that
+        // turns a continuation into a two octet lead
+        reg const w = bit_or(
+            bit_or(
+                bit_or(shr32<12>(v), shl32<24>(v)),
+                bit_or(
+                    bit_and(shl32<2>(v), splat32(0x3f00)),
+                    bit_and(shl32<16>(v), splat32(0x3f0000)))),
+            bit_or(
+                bit_and(shr32<17>(sub32(v, splat32(0x800))),
+                    splat32(0x4000)),
+                splat32(0x8080e0)));
+        auto const key = [big, three](unsigned i)
+        {
+            return static_cast<unsigned>(
+                ((big >> (4 * i)) & 0xf) |
+                (((three >> (4 * i)) & 0xf) << 4));
+        };
+        for(unsigned i = 0; i < lanes / 4; ++i)
+            d = utf8_pack4(t, quarter(w, i), key(i), d);
+        p += lanes;
+    }
+    return utf8_encode_checked(p, last, d, end);
+}
+
+/** Return the octets needed to encode [p, last)
+*/
+BOOST_PUNYCODE_SIMD_TARGET
+inline
+std::size_t
+utf8_length(
+    char32_t const* p,
+    char32_t const* const last) noexcept
+{
+    // one octet a lane, and one
+    // more for each threshold passed
+    std::size_t n = 0;
+    for(; static_cast<std::size_t>(
+        last - p) >= lanes; p += lanes)
+    {
+        reg const v = load32(p);
+        n += lanes +
+            popcount(above(v, 0x7f)) +
+            popcount(above(v, 0x7ff)) +
+            popcount(above(v, 0xffff));
+    }
+    return n + utf8_length_scalar(p, last);
+}
+
+/** Return the octets in [p, p + n) which are not continuations
+*/
+BOOST_PUNYCODE_SIMD_TARGET
+inline
+std::size_t
+utf32_length(
+    unsigned char const* p,
+    std::size_t n) noexcept
+{
+    std::size_t count = 0;
+    for(; n >= width; p += width, n -= width)
+        count += popcount(leads(load(p)));
+    return count + utf32_length_scalar(p, p + n);
+}
+
+} // BOOST_PUNYCODE_SIMD_NS
+} // detail
+} // punycode
+} // boost
+
+#undef BOOST_PUNYCODE_SIMD_NS
+#undef BOOST_PUNYCODE_SIMD_TARGET
@@ -0,0 +1,565 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#include <boost/punycode/domain_set.hpp>
+#include <boost/punycode/idna.hpp>
+#include <boost/punycode/idna_hash.hpp>
+#include <boost/punycode/idna_view.hpp>
+#include "src/detail/read_file.hpp"
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace boost {
+namespace punycode {
+
+//------------------------------------------------
+//
+// domain_set
+//
+
+/*  The image is a header, the nodes and then the
+    pool of labels, in the byte order of the
+    machine which built it:
+
+        magic, version, domains, nodes, pool, 0
+        nodes               16 octets each
+        labels              pool octets
+
+    The root is the first node, and the children
+    of each node follow the nodes before them,
+    level by level. They are a table of slots,
+    where each child is at the slot its hash
+    scales to, or just after the child before it
+    when that slot is taken, in order of hash.
+    With a quarter more slots than children, most
+    children are at their own slot, so a lookup
+    takes a probe or two, and a miss ends at the
+    first larger hash or empty slot. Each table
+    has a slot past every home slot and after its
+    last child, which is empty. A node listed, or a
+    wildcard, matches all below it, so it is
+    given no children.
+*/
+
+namespace detail {
+
+struct domain_node
+{
+    // of the label, from label_hash
+    std::uint32_t hash;
+
+    // the label, in the pool
+    std::uint32_t label;
+
+    // the table of children
+    std::uint32_t first;
+
+    // slots << 8 | flags << 6 | size,
+    // where a size of zero is an empty slot
+    std::uint32_t info;
+};
+
+} // detail
+
+namespace {
+
+using node = detail::domain_node;
+
+constexpr std::uint32_t image_magic = 0x53445042; // "BPDS"
+constexpr std::uint32_t image_version = 1;
+constexpr std::size_t header_size = 24;
+
+// longest name, without its trailing dot
+constexpr std::size_t max_name = 253;
+
+constexpr std::size_t max_label = 63;
+
+enum : std::uint32_t
+{
+    node_listed     = 1,
+    node_wildcard   = 2
+};
+
+// a domain while the set is built
+struct entry
+{
+    // the key, in the keys
+    std::size_t offset;
+    std::size_t size;
+
+    // the next label to place, or done
+    std::size_t rest;
+    std::uint32_t flags;
+};
+
+constexpr std::size_t done = std::size_t(-1);
+
+// a child while the set is built
+struct group
+{
+    std::uint32_t hash;
+    core::string_view label;
+    std::size_t first;
+    std::size_t last;
+};
+
+} // (anon)
+
+// a hash of the label, eight octets at a time,
+// whose high bits are even enough to interpolate
+// over. It is part of the image.
+static
+std::uint32_t
+label_hash(
+    char const* p,
+    std::size_t n) noexcept
+{
+    std::uint64_t h = 0x9e3779b97f4a7c15ull ^ n;
+    std::uint64_t w;
+    for(; n >= 8; p += 8, n -= 8)
+    {
+        std::memcpy(&w, p, 8);
+        h = (h ^ w) * 0xff51afd7ed558ccdull;
+        h ^= h >> 32;
+    }
+    w = 0;
+    for(std::size_t i = 0; i < n; ++i)
+        w |= std::uint64_t(
+            static_cast<unsigned char>(p[i])) << (8 * i);
+    h = (h ^ w) * 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 29;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 32;
+    return static_cast<std::uint32_t>(h >> 32);
+}
+
+static
+system::error_code
+make_error(system::errc::errc_t e) noexcept
+{
+    return system::error_code(
+        e, system::generic_category());
+}
+
+// the last label of s, ending at pos
+static
+std::size_t
+label_start(
+    char const* s,
+    std::size_t pos) noexcept
+{
+    while(pos > 0 && s[pos - 1] != '.')
+        --pos;
+    return pos;
+}
+
+// order keys, which are names with their labels
+// in reverse, so that a name comes before the
+// names below it and those follow together.
+// The dot which ends a label is below any octet
+static
+bool
+key_less(
+    core::string_view a,
+    core::string_view b) noexcept
+{
+    auto const rank =
+        [](char c) -> unsigned
+        {
+            return c == '.' ? 0 :
+                static_cast<unsigned char>(c) + 1u;
+        };
+    auto const n = (std::min)(a.size(), b.size());
+    for(std::size_t i = 0; i < n; ++i)
+        if(a[i] != b[i])
+            return rank(a[i]) < rank(b[i]);
+    return a.size() < b.size();
+}
+
+// the label of a key which begins at pos
+static
+core::string_view
+next_label(
+    core::string_view key,
+    std::size_t pos) noexcept
+{
+    auto const end = key.find('.', pos);
+    return key.substr(pos, end == core::string_view::npos ?
+        core::string_view::npos : end - pos);
+}
+
+// the home slot of a hash in a table
+static
+std::size_t
+home_slot(
+    std::uint32_t h,
+    std::uint32_t cap) noexcept
+{
+    return static_cast<std::size_t>(
+        (std::uint64_t(h) * cap) >> 32);
+}
+
+// the child of n with the label, or null
+static
+node const*
+find_child(
+    node const* nodes,
+    char const* pool,
+    node const& n,
+    char const* s,
+    std::size_t size) noexcept
+{
+    auto const cap = n.info >> 8;
+    if(cap == 0)
+        return nullptr;
+    auto const h = label_hash(s, size);
+    auto p = nodes + n.first + home_slot(h, cap);
+    for(;; ++p)
+    {
+        // an empty slot, or a larger hash,
+        // ends the run where h would be
+        if( (p->info & 63) == 0 ||
+            p->hash > h)
+            return nullptr;
+        if( p->hash == h &&
+            (p->info & 63) == size &&
+            std::memcmp(pool + p->label, s, size) == 0)
+            return p;
+    }
+}
+
+system::result<domain_set>
+domain_set::
+build(
+    core::string_view const* domains,
+    std::size_t n)
+{
+    if(n > 0xffffffff)
+        return make_error(
+            system::errc::value_too_large);
+
+    // the key of each domain, end to end
+    std::string keys;
+    std::vector<entry> v;
+    v.reserve(n);
+    std::string idna;
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        auto s = domains[i];
+        std::uint32_t flags = node_listed;
+        if(s.substr(0, 2) == "*.")
+        {
+            flags = node_wildcard;
+            s.remove_prefix(2);
+        }
+        if(! s.empty() && s.back() == '.')
+            s.remove_suffix(1);
+        if( s.empty() ||
+            s.find('*') != core::string_view::npos)
+            return make_error(
+                system::errc::invalid_argument);
+        auto rv = utf8_to_idna(s, std::move(idna));
+        if(! rv)
+            return rv.error();
+        idna = std::move(*rv);
+        v.push_back({ keys.size(), idna.size(), 0, flags });
+        for(std::size_t pos = idna.size();;)
+        {
+            auto const b = label_start(idna.data(), pos);
+            if(b == pos || pos - b > max_label)
+                return make_error(
+                    system::errc::invalid_argument);
+            keys.append(idna.data() + b, pos - b);
+            if(b == 0)
+                break;
+            keys.push_back('.');
+            pos = b - 1;
+        }
+    }
+    auto const key =
+        [&keys](entry const& e)
+        {
+            return core::string_view(
+                keys.data() + e.offset, e.size);
+        };
+    std::sort(v.begin(), v.end(),
+        [&key](entry const& a, entry const& b)
+        {
+            return key_less(key(a), key(b));
+        });
+
+    // lay the nodes out level by level. The
+    // domains below each node are a range of v,
+    // which its children split by their label
+    std::vector<node> nodes(1, node{});
+    std::vector<std::pair<std::size_t, std::size_t>> ranges;
+    ranges.emplace_back(0, v.size());
+    std::string pool;
+    std::unordered_map<std::string, std::uint32_t> labels;
+    std::vector<group> groups;
+    for(std::size_t k = 0; k < nodes.size(); ++k)
+    {
+        // an empty slot
+        if(k > 0 && (nodes[k].info & 63) == 0)
+            continue;
+        auto i = ranges[k].first;
+        auto const last = ranges[k].second;
+        std::uint32_t flags = 0;
+        for(; i < last && v[i].rest == done; ++i)
+            flags |= v[i].flags;
+        nodes[k].info |= flags << 6;
+        nodes[k].first = static_cast<std::uint32_t>(
+            nodes.size());
+        if(flags != 0)
+            continue;
+
+        groups.clear();
+        while(i < last)
+        {
+            auto const label = next_label(key(v[i]), v[i].rest);
+            group g{ label_hash(label.data(), label.size()),
+                label, i, i };
+            for(; i < last; ++i)
+            {
+                auto const ki = key(v[i]);
+                if(next_label(ki, v[i].rest) != label)
+                    break;
+                v[i].rest += label.size() + 1;
+                if(v[i].rest > ki.size())
+                    v[i].rest = done;
+            }
+            g.last = i;
+            groups.push_back(g);
+        }
+        if(groups.empty())
+            continue;
+        std::sort(groups.begin(), groups.end(),
+            [](group const& a, group const& b)
+            {
+                if(a.hash != b.hash)
+                    return a.hash < b.hash;
+                return a.label < b.label;
+            });
+
+        // place the children in order of hash, each
+        // at its home slot or just after the one
+        // before. Then an empty slot, after the
+        // last child and the last home slot
+        auto const cap = groups.size() + groups.size() / 4;
+        if(cap > 0xffffff)
+            return make_error(
+                system::errc::value_too_large);
+        nodes[k].info |= static_cast<std::uint32_t>(cap) << 8;
+        auto const base = nodes.size();
+        std::size_t pos = 0;
+        for(std::size_t gi = 0; gi < groups.size(); ++gi)
+        {
+            auto const& g = groups[gi];
+            auto const home = home_slot(g.hash,
+                static_cast<std::uint32_t>(cap));
+            if(gi == 0 || home > pos)
+                pos = home;
+            auto const r = labels.emplace(
+                std::string(g.label.data(), g.label.size()),
+                static_cast<std::uint32_t>(pool.size()));
+            if(r.second)
+                pool.append(g.label.data(), g.label.size());
+            nodes.resize(base + pos + 2, node{});
+            ranges.resize(nodes.size());
+            nodes[base + pos] = { g.hash, r.first->second, 0,
+                static_cast<std::uint32_t>(g.label.size()) };
+            ranges[base + pos] = { g.first, g.last };
+            ++pos;
+        }
+        if(nodes.size() < base + cap + 1)
+        {
+            nodes.resize(base + cap + 1, node{});
+            ranges.resize(nodes.size());
+        }
+        if( nodes.size() > 0xffffffff ||
+            pool.size() > 0xffffffff)
+            return make_error(
+                system::errc::value_too_large);
+    }
+
+    // the image, in words for alignment
+    std::uint32_t const header[6] = {
+        image_magic,
+        image_version,
+        static_cast<std::uint32_t>(n),
+        static_cast<std::uint32_t>(nodes.size()),
+        static_cast<std::uint32_t>(pool.size()),
+        0 };
+    auto const size = header_size +
+        nodes.size() * sizeof(node) + pool.size();
+    auto words = std::make_shared<
+        std::vector<std::uint32_t>>((size + 3) / 4);
+    auto p = reinterpret_cast<char*>(words->data());
+    std::memcpy(p, header, header_size);
+    std::memcpy(p + header_size, nodes.data(),
+        nodes.size() * sizeof(node));
+    std::memcpy(p + header_size + nodes.size() * sizeof(node),
+        pool.data(), pool.size());
+    return make(p, size, std::move(words));
+}
+
+system::result<domain_set>
+domain_set::
+make(
+    void const* data,
+    std::size_t size,
+    std::shared_ptr<void const> owner)
+{
+    auto const p = static_cast<char const*>(data);
+    if( reinterpret_cast<std::uintptr_t>(p) % 4 != 0 ||
+        size < header_size)
+        return make_error(
+            system::errc::invalid_argument);
+    std::uint32_t header[6];
+    std::memcpy(header, p, header_size);
+    if( header[0] != image_magic ||
+        header[1] != image_version ||
+        header[3] == 0 ||
+        header_size + std::uint64_t(header[3]) *
+            sizeof(node) + header[4] != size)
+        return make_error(
+            system::errc::invalid_argument);
+
+    // each label is in the image, and each table
+    // has a slot past its home slots. The last
+    // node is empty, which ends any probe
+    auto const nodes = reinterpret_cast<node const*>(
+        p + header_size);
+    if((nodes[header[3] - 1].info & 63) != 0)
+        return make_error(
+            system::errc::invalid_argument);
+    for(std::size_t i = 0; i < header[3]; ++i)
+    {
+        auto const& nd = nodes[i];
+        if( std::uint64_t(nd.label) + (nd.info & 63) > header[4] ||
+            ((nd.info >> 8) != 0 &&
+                std::uint64_t(nd.first) + (nd.info >> 8) >= header[3]))
+            return make_error(
+                system::errc::invalid_argument);
+    }
+
+    domain_set ds;
+    ds.owner_ = std::move(owner);
+    ds.image_ = p;
+    ds.image_size_ = size;
+    ds.nodes_ = nodes;
+    ds.pool_ = p + header_size +
+        std::size_t(header[3]) * sizeof(node);
+    ds.size_ = header[2];
+    return ds;
+}
+
+system::result<domain_set>
+domain_set::
+load(char const* path)
+{
+    std::string s;
+    auto const ec = detail::read_file(path, s);
+    if(ec.failed())
+        return ec;
+    // copied to words, so that
+    // the nodes are aligned
+    auto words = std::make_shared<
+        std::vector<std::uint32_t>>((s.size() + 3) / 4);
+    std::memcpy(words->data(), s.data(), s.size());
+    auto const p = words->data();
+    return make(p, s.size(), std::move(words));
+}
+
+bool
+domain_set::
+match(core::string_view s) const noexcept
+{
+    auto pos = s.size();
+    if(pos > 0 && s[pos - 1] == '.')
+        --pos;
+    if(pos > max_name)
+        return false;
+    auto n = nodes_;
+    for(;;)
+    {
+        auto const b = label_start(s.data(), pos);
+        n = find_child(nodes_, pool_, *n,
+            s.data() + b, pos - b);
+        if(! n)
+            return false;
+        if(n->info & (node_listed << 6))
+            return true;
+        if(b == 0)
+            return false;
+        if(n->info & (node_wildcard << 6))
+            return true;
+        pos = b - 1;
+    }
+}
+
+bool
+domain_set::
+contains(core::string_view host) const noexcept
+{
+    if(! nodes_)
+        return false;
+    bool ascii = true;
+    bool upper = false;
+    for(char c : host)
+    {
+        if(static_cast<unsigned char>(c) >= 0x80)
+        {
+            ascii = false;
+            break;
+        }
+        if(c >= 'A' && c <= 'Z')
+            upper = true;
+    }
+    if(ascii && ! upper)
+        return match(host);
+
+    // the IDNA and a trailing dot. That of an
+    // ascii host is the host in lower case
+    char buf[max_name + 1];
+    std::size_t n = 0;
+    if(ascii)
+    {
+        if(host.size() > sizeof(buf))
+            return false;
+        for(char c : host)
+        {
+            if(c >= 'A' && c <= 'Z')
+                c += 'a' - 'A';
+            buf[n++] = c;
+        }
+        return match(core::string_view(buf, n));
+    }
+    try
+    {
+        idna_view const v(host);
+        for(auto it = v.begin(); it != v.end(); ++it)
+        {
+            if(n == sizeof(buf))
+                return false;
+            buf[n++] = *it;
+        }
+    }
+    catch(system::system_error const&)
+    {
+        return false;
+    }
+    return match(core::string_view(buf, n));
+}
+
+} // punycode
+} // boost
@@ -7,334 +7,912 @@
 // Official repository: https://github.com/cppalliance/punycode
 //
 
-#include "src/stringprep_b2.hpp"
 #include <boost/punycode/idna.hpp>
+#include <boost/punycode/ascii_count.hpp>
+#include <boost/punycode/detail/bidi.hpp>
+#include <boost/punycode/detail/idna_classify.hpp>
+#include <boost/punycode/detail/nameprep.hpp>
+#include <boost/punycode/detail/utf8_dfa.hpp>
 #include <boost/punycode/punycode.hpp>
+#include <boost/punycode/transcode.hpp>
+#include <boost/punycode/utf16_input.hpp>
 #include <boost/punycode/utf8_count.hpp>
 #include <boost/punycode/utf8_input.hpp>
 #include <boost/punycode/utf8_output.hpp>
+#include "src/detail/ldh_simd.hpp"
+#include "src/detail/script.hpp"
+#include "src/detail/u32_buffer.hpp"
 #include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#ifdef BOOST_PUNYCODE_HAS_X86_SIMD
+# define BOOST_PUNYCODE_SIMD_NS sse4
+# define BOOST_PUNYCODE_SIMD_TARGET BOOST_PUNYCODE_TARGET_SSE4
+# include "src/detail/ldh_simd.hpp"
+# define BOOST_PUNYCODE_SIMD_NS avx2
+# define BOOST_PUNYCODE_SIMD_TARGET BOOST_PUNYCODE_TARGET_AVX2
+# include "src/detail/ldh_simd.hpp"
+# define BOOST_PUNYCODE_SIMD_NS avx512
+# define BOOST_PUNYCODE_SIMD_TARGET BOOST_PUNYCODE_TARGET_AVX512
+# include "src/detail/ldh_simd.hpp"
+#endif
 
 namespace boost {
 namespace punycode {
 
 //------------------------------------------------
-//
-// NAMEPREP
-//
-// https://datatracker.ietf.org/doc/html/rfc3491
-//
 
-class nameprep_iterator_base
+static
+bool
+is_ascii(char32_t cp)
 {
-protected:
-    enum : char32_t
-    {
-        invalid = 0xffffffff
-    };
-
-    char32_t cp_[4];
-    char i_ = 0;
-
-    static constexpr bool
-    map_to_nothing(char32_t cp) noexcept;
+    return cp < 128;
+}
 
-    struct writer
+/** Write a utf32 IDNA from a utf32 IRI after nameprep
+*/
+template<class OutputIt>
+OutputIt
+encode_idna(
+    OutputIt out,
+    char32_t const* first,
+    char32_t const* last)
+{
+    // everything may map to nothing
+    if(first == last)
+        return out;
+    auto it = first;
+    for(;;)
     {
-        nameprep_iterator_base& self;
-
-        void operator()(
-            char32_t cp) noexcept
+        auto cp = *it;
+        if(cp == '.')
+        {
+            // copy ascii
+            out = std::copy(first, it, out);
+            *out++ = '.';
+            ++it;
+            if(it == last)
+                return out;
+            first = it;
+            continue;
+        }
+        if(is_ascii(cp))
+        {
+            ++it;
+            if(it == last)
+            {
+                // copy ascii
+                out = std::copy(first, it, out);
+                return out;
+            }
+            continue;
+        }
+        for(;;)
         {
-            self.cp_[0] = cp;
-            self.i_ = 0;
+            ++it;
+            if(it == last)
+            {
+                // convert puny
+                *out++ = 'x';
+                *out++ = 'n';
+                *out++ = '-';
+                *out++ = '-';
+                out = encode(out, first, it);
+                return out;
+            }
+            cp = *it;
+            if(cp == '.')
+            {
+                // convert puny
+                *out++ = 'x';
+                *out++ = 'n';
+                *out++ = '-';
+                *out++ = '-';
+                out = encode(out, first, it);
+                *out++ = '.';
+                ++it;
+                if(it == last)
+                    return out;
+                first = it;
+                break;
+            }
         }
+    }
+}
 
-        void operator()(
-            char32_t cp0,
-            char32_t cp1) noexcept
+// size storage for the IDNA of [first, last)
+// with one counting pass, then write it
+template<class InputIt>
+static
+system::error_code
+encode_idna_into(
+    std::string& storage,
+    InputIt first,
+    InputIt last,
+    std::vector<label_info>* labels = nullptr,
+    idna_options const& opt = {},
+    std::size_t* rejected = nullptr)
+{
+    // nameprep once, instead of on each
+    // of the passes the encoder makes, and
+    // check the bidi rule on the way
+    detail::u32_buffer buf;
+    detail::bidi_rule bidi;
+    detail::script_classifier scripts;
+    detail::nameprep_iterator<InputIt> it(
+        first, last, opt.allow_unassigned);
+    detail::nameprep_iterator<InputIt> const end(last);
+    // nameprep can make a label longer than
+    // the input, and the encoding is quadratic
+    std::size_t len = 0;
+    bool ascii = true;
+    bool too_large = false;
+    for(; it != end; ++it)
+    {
+        auto const cp = *it;
+        if(detail::is_label_dot(cp))
         {
-            self.cp_[1] = cp0;
-            self.cp_[0] = cp1;
-            self.i_ = 1;
+            bidi.end_label();
+            if(labels)
+                labels->push_back(scripts.end_label());
+            buf.push_back('.');
+            len = 0;
+            ascii = true;
+            continue;
         }
+        ++len;
+        if(! is_ascii(cp))
+            ascii = false;
+        if(! ascii && detail::exceeds_max_input(len))
+            too_large = true;
+        bidi.push(cp);
+        if(labels)
+            scripts.push(cp);
+        buf.push_back(cp);
+    }
+    bidi.end_label();
+    if(labels)
+        labels->push_back(scripts.end_label());
+    if(it.prohibited() && rejected)
+        *rejected = it.prohibited_index();
+    if(it.prohibited() || bidi.failed())
+        return system::error_code(
+            system::errc::invalid_argument,
+            system::generic_category());
+    if(too_large)
+        return system::error_code(
+            system::errc::value_too_large,
+            system::generic_category());
+    char32_t const* const p = buf.data();
+    auto const n = buf.size();
+    storage.resize(encode_idna(
+        utf8_count(), p, p + n).count());
+    encode_idna(
+        utf8_output(&storage[0]), p, p + n);
+    return {};
+}
+
+// true if the domain is already its own IDNA,
+// which holds for ascii in lower case
+static
+bool
+is_own_idna(core::string_view s) noexcept
+{
+    return ! (idna_classify(s) &
+        (has_non_ascii | has_upper));
+}
+
+// the offset of code point i of valid utf8
+static
+std::size_t
+utf8_offset(
+    core::string_view s,
+    std::size_t i) noexcept
+{
+    std::size_t pos = 0;
+    for(;; ++pos)
+        if((static_cast<unsigned char>(
+                s[pos]) & 0xc0) != 0x80 && i-- == 0)
+            return pos;
+}
+
+// build the IDNA of a domain which
+// needs converting in storage
+static
+system::error_code
+convert_utf8(
+    core::string_view s,
+    std::string& storage,
+    std::vector<label_info>* labels = nullptr,
+    idna_options const& opt = {},
+    std::size_t* rejected = nullptr)
+{
+    // domains fit on the stack, where one bulk
+    // decode replaces a utf8 parse on each of
+    // the two passes over the input
+    char32_t buf[256];
+    if(s.size() <= sizeof(buf) / sizeof(buf[0]))
+    {
+        auto const rv = utf8_to_utf32(s, buf);
+        if(rv.has_error())
+            return rv.error();
+        char32_t const* const first = buf;
+        return encode_idna_into(storage,
+            first, first + *rv, labels, opt, rejected);
+    }
 
-        void operator()(
-            char32_t cp0,
-            char32_t cp1,
-            char32_t cp2) noexcept
+    // longer input is decoded as it is
+    // read, once it is known to be valid
+    if(! is_valid_utf8(s))
+        return system::error_code(
+            system::errc::illegal_byte_sequence,
+            system::generic_category());
+    return encode_idna_into(storage,
+        utf8_input(s.data(), s.data() + s.size()),
+        utf8_input(s.data() + s.size()),
+        labels, opt, rejected);
+}
+
+system::result<std::string>
+utf8_to_idna(
+    core::string_view s,
+    std::string&& storage)
+{
+    if(detail::exceeds_max_input(s.size()))
+        return system::error_code(
+            system::errc::value_too_large,
+            system::generic_category());
+    if(is_own_idna(s))
+    {
+        storage.assign(s.data(), s.size());
+        return std::move(storage);
+    }
+    auto const ec = convert_utf8(s, storage);
+    if(ec.failed())
+        return ec;
+    return std::move(storage);
+}
+
+system::result<std::string>
+utf8_to_idna(
+    core::string_view s,
+    idna_options const& opt,
+    std::size_t& offset,
+    std::string&& storage)
+{
+    offset = s.size();
+    if(detail::exceeds_max_input(s.size()))
+        return system::error_code(
+            system::errc::value_too_large,
+            system::generic_category());
+    if(is_own_idna(s))
+    {
+        storage.assign(s.data(), s.size());
+        return std::move(storage);
+    }
+    // the index of a rejected code point
+    // becomes the offset of its first octet
+    std::size_t i = SIZE_MAX;
+    auto const ec = convert_utf8(
+        s, storage, nullptr, opt, &i);
+    if(i != SIZE_MAX)
+        offset = utf8_offset(s, i);
+    if(ec.failed())
+        return ec;
+    return std::move(storage);
+}
+
+system::result<core::string_view>
+utf8_to_idna_borrowed(
+    core::string_view s,
+    std::string& storage)
+{
+    if(detail::exceeds_max_input(s.size()))
+        return system::error_code(
+            system::errc::value_too_large,
+            system::generic_category());
+    if(is_own_idna(s))
+        return s;
+    auto const ec = convert_utf8(s, storage);
+    if(ec.failed())
+        return ec;
+    return core::string_view(storage);
+}
+
+system::result<std::string>
+utf8_to_idna(
+    core::string_view s,
+    std::vector<label_info>& labels,
+    std::string&& storage)
+{
+    labels.clear();
+    if(detail::exceeds_max_input(s.size()))
+        return system::error_code(
+            system::errc::value_too_large,
+            system::generic_category());
+    if(is_own_idna(s))
+    {
+        // nameprep leaves the ascii as it is
+        detail::script_classifier scripts;
+        for(char c : s)
         {
-            self.cp_[2] = cp0;
-            self.cp_[1] = cp1;
-            self.cp_[0] = cp2;
-            self.i_ = 2;
+            if(c == '.')
+                labels.push_back(scripts.end_label());
+            else
+                scripts.push(
+                    static_cast<unsigned char>(c));
         }
+        labels.push_back(scripts.end_label());
+        storage.assign(s.data(), s.size());
+        return std::move(storage);
+    }
+    auto const ec = convert_utf8(s, storage, &labels);
+    if(ec.failed())
+    {
+        labels.clear();
+        return ec;
+    }
+    return std::move(storage);
+}
+
+//------------------------------------------------
 
-        void operator()(
-            char32_t cp0,
-            char32_t cp1,
-            char32_t cp2,
-            char32_t cp3) noexcept
+// decode utf16 to dest, returning the number of
+// code points, or SIZE_MAX if a surrogate is not
+// part of a pair. dest may be null to only check.
+static
+std::size_t
+decode_utf16(
+    char16_t const* p,
+    char16_t const* const end,
+    char32_t* dest) noexcept
+{
+    std::size_t n = 0;
+    while(p != end)
+    {
+        char32_t cp = *p++;
+        if(cp - 0xd800u < 0x800u)
         {
-            self.cp_[3] = cp0;
-            self.cp_[2] = cp1;
-            self.cp_[1] = cp2;
-            self.cp_[0] = cp3;
-            self.i_ = 3;
+            if( cp > 0xdbff || p == end ||
+                *p - 0xdc00u >= 0x400u)
+                return SIZE_MAX;
+            cp = 0x10000 +
+                ((cp - 0xd800) << 10) +
+                (*p++ - 0xdc00u);
         }
-    };
-};
+        if(dest)
+            dest[n] = cp;
+        ++n;
+    }
+    return n;
+}
+
+system::result<std::string>
+utf16_to_idna(
+    core::u16string_view s,
+    std::string&& storage)
+{
+    if(detail::exceeds_max_input(s.size()))
+        return system::error_code(
+            system::errc::value_too_large,
+            system::generic_category());
+
+    auto const first = s.data();
+    auto const last = s.data() + s.size();
+    char32_t buf[256];
+    bool const fits =
+        s.size() <= sizeof(buf) / sizeof(buf[0]);
+    auto const n = decode_utf16(
+        first, last, fits ? buf : nullptr);
+    if(n == SIZE_MAX)
+        return system::error_code(
+            system::errc::illegal_byte_sequence,
+            system::generic_category());
+    system::error_code ec;
+    if(fits)
+    {
+        char32_t const* const p = buf;
+        ec = encode_idna_into(storage, p, p + n);
+    }
+    else
+    {
+        ec = encode_idna_into(storage,
+            utf16_input(first, last),
+            utf16_input(last));
+    }
+    if(ec.failed())
+        return ec;
+    return std::move(storage);
+}
 
 //------------------------------------------------
 
-// https://datatracker.ietf.org/doc/html/rfc3454#appendix-B.1
-constexpr bool
-nameprep_iterator_base::
-map_to_nothing(char32_t cp) noexcept
+namespace detail {
+
+unsigned
+idna_classify(
+    core::string_view s,
+    simd_level level) noexcept
 {
-    switch(cp)
+    auto const p = reinterpret_cast<
+        unsigned char const*>(s.data());
+    switch(usable(level))
     {
-    case 0x00AD:
-    case 0x034F:
-    case 0x1806:
-    case 0x180B:
-    case 0x180C:
-    case 0x180D:
-    case 0x200B:
-    case 0x200C:
-    case 0x200D:
-    case 0x2060:
-    case 0xFE00:
-    case 0xFE01:
-    case 0xFE02:
-    case 0xFE03:
-    case 0xFE04:
-    case 0xFE05:
-    case 0xFE06:
-    case 0xFE07:
-    case 0xFE08:
-    case 0xFE09:
-    case 0xFE0A:
-    case 0xFE0B:
-    case 0xFE0C:
-    case 0xFE0D:
-    case 0xFE0E:
-    case 0xFE0F:
-    case 0xFEFF:
-        return true;
+#ifdef BOOST_PUNYCODE_HAS_X86_SIMD
+    case simd_level::avx512:
+        return avx512::ldh_classify(p, s.size());
+    case simd_level::avx2:
+        return avx2::ldh_classify(p, s.size());
+    case simd_level::sse4:
+        return sse4::ldh_classify(p, s.size());
+#endif
     default:
-        break;
+        return ldh_classify_scalar(p, s.size());
     }
-    return false;
+}
+
+} // detail
+
+unsigned
+idna_classify(
+    core::string_view s) noexcept
+{
+    return detail::idna_classify(
+        s, detail::cpu_simd_level());
 }
 
 //------------------------------------------------
 
-/** Iterate over a utf32 sequence, applying nameprep.
-*/
-template<class InputIt>
-class nameprep_iterator
-    : private nameprep_iterator_base
+// longest label in ACE form, per RFC 1035
+static constexpr std::size_t max_label = 63;
+
+static
+char
+ascii_lower(char c) noexcept
+{
+    if(c >= 'A' && c <= 'Z')
+        return static_cast<char>(c + ('a' - 'A'));
+    return c;
+}
+
+static
+bool
+is_ascii(core::string_view s) noexcept
 {
-    // VFALCO typecheck on InputIt
+    for(char c : s)
+        if(static_cast<unsigned char>(c) >= 0x80)
+            return false;
+    return true;
+}
 
-    InputIt it_;
-    InputIt end_; // VFALCO only needed for debug?
+// output iterator which counts every character
+// but only stores the ones which fit in dest
+class bounded_output
+{
+    char* dest_;
+    std::size_t size_;
+    std::size_t n_ = 0;
 
 public:
-    using value_type        = char32_t;
+    using value_type        = char;
     using difference_type   = std::ptrdiff_t;
     using pointer           = value_type const*;
     using reference         = value_type const&;
     using iterator_category =
-        std::forward_iterator_tag;
+        std::output_iterator_tag;
 
-    nameprep_iterator(nameprep_iterator const&) = default;
-    nameprep_iterator& operator=(nameprep_iterator const&) = default;
+    bounded_output(
+        char* dest,
+        std::size_t size) noexcept
+        : dest_(dest)
+        , size_(size)
+    {
+    }
 
-    nameprep_iterator() = default;
+    std::size_t
+    count() const noexcept
+    {
+        return n_;
+    }
 
-    nameprep_iterator(
-        InputIt it,
-        InputIt end)
-        : it_(it)
-        , end_(end)
+    bounded_output&
+    operator=(char c) noexcept
     {
-        get();
+        if(n_ < size_)
+            dest_[n_] = c;
+        ++n_;
+        return *this;
     }
 
-    explicit
-    nameprep_iterator(
-        InputIt end)
-        : it_(end)
-        , end_(end)
+    bounded_output&
+    operator*() noexcept
     {
-        cp_[0] = invalid;
-        i_ = 0;
+        return *this;
     }
 
-    bool
-    operator==(
-        nameprep_iterator const& other) const noexcept
+    bounded_output&
+    operator++() noexcept
     {
-        BOOST_ASSERT(end_ == other.end_);
-        return
-            it_ == other.it_ &&
-            i_ == other.i_;
+        return *this;
     }
 
-    bool
-    operator!=(
-        nameprep_iterator const& other) const noexcept
+    bounded_output&
+    operator++(int) noexcept
     {
-        return ! (*this == other);
+        return *this;
     }
+};
 
-    char32_t
-    operator*() const noexcept
+// the labels of a domain after nameprep, one at
+// a time. A dot in the input always ends a label,
+// as nameprep passes it through, and so does one
+// which nameprep maps another character to.
+class label_reader
+{
+    using iterator =
+        detail::nameprep_iterator<utf8_input>;
+
+    // the input after the current run
+    core::string_view rest_;
+    bool last_run_ = false;
+    bool done_ = false;
+
+    // over a run which is not ascii
+    iterator it_;
+    iterator end_;
+    bool in_run_ = false;
+
+public:
+    // the label, of at most max_label
+    // code points, and its properties
+    char32_t cp[max_label];
+    std::size_t n = 0;
+    bool ascii = true;
+
+    // the domain has no IDNA
+    bool failed = false;
+
+    explicit
+    label_reader(core::string_view s) noexcept
+        : rest_(s)
     {
-        BOOST_ASSERT(i_ > 0 || cp_[i_] != invalid);
-        return cp_[i_];
     }
 
-    nameprep_iterator&
-    operator++()
+    char32_t const*
+    begin() const noexcept
     {
-        BOOST_ASSERT(i_ > 0 || cp_[i_] != invalid);
-        if(i_ > 0)
-        {
-            --i_;
-            return *this;
-        }
-        ++it_;
-        get();
-        return *this;
+        return &cp[0];
     }
 
-    nameprep_iterator
-    operator++(int)
+    char32_t const*
+    end() const noexcept
     {
-        auto tmp = *this;
-        ++*this;
-        return tmp;
+        return &cp[0] + n;
     }
 
-private:
-    void
-    get()
+    // size of the punycode
+    std::size_t
+    puny_size() const
+    {
+        return encode(
+            ascii_count(), begin(), end()).count();
+    }
+
+    // read the next label, or return false
+    // after the last one
+    bool
+    next(detail::bidi_rule& bidi)
     {
-        while(it_ != end_)
+        if(done_)
+            return false;
+        n = 0;
+        ascii = true;
+        if(! in_run_)
         {
-            auto cp = *it_;
-            if(map_to_nothing(cp))
+            // the next run of input between dots
+            auto const dot = static_cast<char const*>(
+                std::memchr(rest_.data(), '.', rest_.size()));
+            auto const size = dot ?
+                static_cast<std::size_t>(dot - rest_.data()) :
+                rest_.size();
+            auto const run = rest_.substr(0, size);
+            last_run_ = ! dot;
+            rest_.remove_prefix(dot ? size + 1 : size);
+            if(is_ascii(run))
             {
-                ++it_;
-                continue;
+                // nameprep only lowers the case
+                if(run.size() > max_label)
+                    return fail();
+                for(char c : run)
+                {
+                    c = ascii_lower(c);
+                    bidi.push(static_cast<unsigned char>(c));
+                    cp[n++] = static_cast<unsigned char>(c);
+                }
+                bidi.end_label();
+                done_ = last_run_;
+                return true;
             }
-            return stringprep_b2(cp, writer{*this});
+            auto const p = reinterpret_cast<
+                unsigned char const*>(run.data());
+            if(! detail::utf8_validate_dfa(p, p + run.size()))
+                return fail();
+            it_ = iterator(
+                utf8_input(run.data(), run.data() + run.size()),
+                utf8_input(run.data() + run.size()));
+            end_ = iterator(utf8_input(run.data() + run.size()));
+            in_run_ = true;
+        }
+        for(; it_ != end_ &&
+            ! detail::is_label_dot(*it_); ++it_)
+        {
+            if(n == max_label)
+                return fail();
+            if(*it_ >= 0x80)
+                ascii = false;
+            bidi.push(*it_);
+            cp[n++] = *it_;
+        }
+        bidi.end_label();
+        if(it_.prohibited())
+            return fail();
+        // too long to encode, as for utf8_to_idna
+        if(! ascii && detail::exceeds_max_input(n))
+            return fail();
+        if(it_ != end_)
+        {
+            // a dot nameprep mapped to
+            ++it_;
         }
-        cp_[0] = invalid;
-        i_ = 0;
+        else
+        {
+            in_run_ = false;
+            done_ = last_run_;
+        }
+        return true;
     }
-};
 
-//------------------------------------------------
+private:
+    bool
+    fail() noexcept
+    {
+        failed = true;
+        done_ = true;
+        return true;
+    }
+};
 
+// true if two labels after nameprep have the
+// same IDNA label
 static
 bool
-is_ascii(char32_t cp)
+label_equivalent(
+    label_reader const& pa,
+    label_reader const& pb)
 {
-    return cp < 128;
+    if(pa.ascii == pb.ascii)
+    {
+        // both are the nameprep output, or both
+        // the punycode of it, which is one to one
+        if( pa.n != pb.n ||
+            ! std::equal(pa.begin(), pa.end(), pb.begin()))
+            return false;
+        if(pa.ascii)
+            return true;
+        return
+            pa.n <= max_label - 4 &&
+            pa.puny_size() <= max_label - 4;
+    }
+
+    // an ACE label and a Unicode one. The
+    // Unicode side is only encoded when it
+    // could produce the ACE suffix
+    auto const& ace = pa.ascii ? pa : pb;
+    auto const& uni = pa.ascii ? pb : pa;
+    auto const n = ace.n;
+    if(n < 4 || uni.n > n - 4)
+        return false;
+    char buf0[max_label];
+    for(std::size_t i = 0; i < n; ++i)
+        buf0[i] = static_cast<char>(ace.cp[i]);
+    if(std::memcmp(buf0, "xn--", 4) != 0)
+        return false;
+    char buf1[max_label];
+    auto const out = encode(
+        bounded_output(buf1, n - 4),
+        uni.begin(), uni.end());
+    return
+        out.count() == n - 4 &&
+        std::memcmp(buf0 + 4, buf1, n - 4) == 0;
 }
 
-/** Write a utf32 IDNA from a utf32 IRI
-*/
-template<
-    class OutputIt,
-    class InputIt>
-OutputIt
-encode_idna(
-    OutputIt out,
-    InputIt first0,
-    InputIt last0)
+bool
+idna_equivalent(
+    core::string_view a,
+    core::string_view b) noexcept
 {
-    if(first0 == last0)
-        return out;
-    nameprep_iterator<InputIt> first(first0, last0);
-    nameprep_iterator<InputIt> last(last0);
-    auto it = first;
+    // this also covers domains with no IDNA,
+    // which are only equivalent to themselves
+    if(a == b)
+        return true;
+    detail::bidi_rule ra;
+    detail::bidi_rule rb;
+    label_reader la(a);
+    label_reader lb(b);
     for(;;)
     {
-        auto cp = *it;
-        if(cp == '.')
-        {
-            // copy ascii
-            out = std::copy(first, it, out);
-            *out++ = '.';
-            ++it;
-            if(it == last)
-                return out;
-            first = it;
-            continue;
-        }
-        if(is_ascii(cp))
-        {
-            ++it;
-            if(it == last)
-            {
-                // copy ascii
-                out = std::copy(first, it, out);
-                return out;
-            }
-            continue;
-        }
+        bool const ma = la.next(ra);
+        bool const mb = lb.next(rb);
+        if(ma != mb)
+            return false;
+        if(! ma)
+            return ! ra.failed() && ! rb.failed();
+        if( la.failed || lb.failed ||
+            ! label_equivalent(la, lb))
+            return false;
+    }
+}
+
+//------------------------------------------------
+
+// longest name in wire format, per RFC 1035,
+// with its length octets and the root label
+static constexpr std::size_t max_wire = 255;
+
+static
+system::error_code
+make_error(system::errc::errc_t ev) noexcept
+{
+    return system::error_code(
+        ev, system::generic_category());
+}
+
+// wire format of a domain which is its own
+// IDNA, copying each label after its length
+static
+system::result<std::size_t>
+own_idna_to_dns_wire(
+    core::string_view s,
+    char* dest,
+    std::size_t size) noexcept
+{
+    std::size_t n = 0;
+    if(s != ".")
+    {
+        if(! s.empty() && s.back() == '.')
+            s.remove_suffix(1);
+        char const* p = s.data();
+        char const* const end = p + s.size();
         for(;;)
         {
-            ++it;
-            if(it == last)
+            auto const dot = static_cast<char const*>(
+                std::memchr(p, '.', end - p));
+            auto const len = static_cast<std::size_t>(
+                (dot ? dot : end) - p);
+            if(len == 0)
+                return make_error(
+                    system::errc::invalid_argument);
+            if( len > max_label ||
+                n + 1 + len >= max_wire)
+                return make_error(
+                    system::errc::value_too_large);
+            if(n + 1 + len <= size)
             {
-                // convert puny
-                *out++ = 'x';
-                *out++ = 'n';
-                *out++ = '-';
-                *out++ = '-';
-                out = encode(out, first, it);
-                return out;
+                dest[n] = static_cast<char>(len);
+                std::memcpy(dest + n + 1, p, len);
             }
-            cp = *it;
-            if(cp == '.')
-            {
-                // convert puny
-                *out++ = 'x';
-                *out++ = 'n';
-                *out++ = '-';
-                *out++ = '-';
-                out = encode(out, first, it);
-                *out++ = '.';
-                ++it;
-                if(it == last)
-                    return out;
-                first = it;
+            n += 1 + len;
+            if(! dot)
                 break;
-            }
+            p = dot + 1;
         }
     }
+    if(n >= size)
+        return make_error(
+            system::errc::no_buffer_space);
+    dest[n++] = '\0';
+    return n;
 }
 
-system::result<std::string>
-utf8_to_idna(
+system::result<std::size_t>
+utf8_to_dns_wire(
     core::string_view s,
-    std::string&& storage)
+    char* dest,
+    std::size_t size) noexcept
 {
-    utf8_input const first(
-        s.data(), s.data() + s.size());
-    utf8_input const last(
-        s.data() + s.size());
-    storage.resize(encode_idna(
-        utf8_count(), first, last).count());
-    encode_idna(
-        utf8_output(&storage[0]), first, last);
-    return std::move(storage);
+    if(detail::exceeds_max_input(s.size()))
+        return make_error(
+            system::errc::value_too_large);
+    if(is_own_idna(s))
+        return own_idna_to_dns_wire(s, dest, size);
+    if(! is_valid_utf8(s))
+        return make_error(
+            system::errc::illegal_byte_sequence);
+
+    // labels are split after nameprep, which
+    // can map to a dot, and each is encoded as
+    // encode_idna does, after a length octet
+    // which is patched when the label is done
+    using iterator =
+        detail::nameprep_iterator<utf8_input>;
+    iterator const last(
+        utf8_input(s.data() + s.size()));
+    iterator it(
+        utf8_input(s.data(), s.data() + s.size()),
+        utf8_input(s.data() + s.size()));
+    detail::bidi_rule bidi;
+    bounded_output out(
+        dest, (std::min)(size, max_wire));
+    bool dot = false;
+    for(;;)
+    {
+        // no label of DNS has more code points
+        char32_t u[max_label];
+        std::size_t n = 0;
+        bool ascii = true;
+        for(; it != last && ! detail::is_label_dot(*it); ++it)
+        {
+            if(n == max_label)
+                return make_error(
+                    system::errc::value_too_large);
+            if(*it >= 0x80)
+                ascii = false;
+            bidi.push(*it);
+            u[n++] = *it;
+        }
+        bidi.end_label();
+        bool const at_end = it == last;
+        if(n == 0)
+        {
+            // the label after a trailing dot,
+            // or a dot alone, is the root
+            if(at_end && dot)
+                break;
+            if(! at_end && out.count() == 0 &&
+                ++it == last)
+                break;
+            return make_error(
+                system::errc::invalid_argument);
+        }
+        auto const at = out.count();
+        *out++ = '\0';
+        if(ascii)
+        {
+            for(std::size_t i = 0; i < n; ++i)
+                *out++ = static_cast<char>(u[i]);
+        }
+        else
+        {
+            if(detail::exceeds_max_input(n))
+                return make_error(
+                    system::errc::value_too_large);
+            *out++ = 'x';
+            *out++ = 'n';
+            *out++ = '-';
+            *out++ = '-';
+            out = encode(out, u, u + n);
+        }
+        auto const len = out.count() - at - 1;
+        if( len > max_label ||
+            out.count() >= max_wire)
+            return make_error(
+                system::errc::value_too_large);
+        if(at < size)
+            dest[at] = static_cast<char>(len);
+        if(at_end)
+            break;
+        ++it;
+        dot = true;
+    }
+    if(it.prohibited() || bidi.failed())
+        return make_error(
+            system::errc::invalid_argument);
+    *out++ = '\0';
+    if(out.count() > size)
+        return make_error(
+            system::errc::no_buffer_space);
+    return out.count();
 }
 
 } // url
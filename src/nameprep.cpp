@@ -0,0 +1,89 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#include <boost/punycode/idna.hpp>
+#include <boost/punycode/detail/nameprep.hpp>
+#include <boost/punycode/detail/utf8_dfa.hpp>
+#include "src/detail/nfc.hpp"
+
+namespace boost {
+namespace punycode {
+namespace detail {
+
+std::uint32_t
+nameprep_nfkc_lookup(char32_t cp) noexcept
+{
+    // past the code space, as utf32
+    // input may be, is prohibited
+    if(cp >= 0x110000)
+        return 0x4000;
+    // the offset of the decomposition
+    // stays on this side
+    return nfkc_lookup(cp) & 0x7fff;
+}
+
+std::size_t
+nameprep_nfkc(
+    char32_t* p,
+    std::size_t n) noexcept
+{
+    // Hangul syllables count as three, so
+    // there is room for the third jamo
+    char32_t d[nameprep_segment_size];
+    return nfkc_normalize(p, n, d);
+}
+
+bool
+nameprep_unassigned(char32_t cp) noexcept
+{
+    return prohibited_unassigned_bits(cp);
+}
+
+} // detail
+
+system::result<std::size_t>
+nameprep_find_prohibited(
+    core::string_view domain,
+    bool allow_unassigned) noexcept
+{
+    auto const p = reinterpret_cast<
+        unsigned char const*>(domain.data());
+    auto const n = domain.size();
+    std::size_t i = 0;
+    while(i < n)
+    {
+        if(p[i] < 0x80)
+        {
+            ++i;
+            continue;
+        }
+        // the automaton of utf8_input
+        char32_t cp = 0;
+        auto state = detail::utf8_dfa_step(
+            detail::utf8_accept, cp, p[i]);
+        std::size_t len = 1;
+        while( state > detail::utf8_reject &&
+                i + len < n)
+            state = detail::utf8_dfa_step(
+                state, cp, p[i + len++]);
+        if(state != detail::utf8_accept)
+            return system::error_code(
+                system::errc::illegal_byte_sequence,
+                system::generic_category());
+        if(allow_unassigned ?
+                detail::prohibited_bits(cp) :
+                detail::prohibited_unassigned_bits(cp))
+            return i;
+        i += len;
+    }
+    return n;
+}
+
+} // punycode
+} // boost
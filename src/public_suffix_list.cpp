@@ -0,0 +1,297 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#include <boost/punycode/public_suffix_list.hpp>
+#include <boost/punycode/idna.hpp>
+#include "src/detail/read_file.hpp"
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <unordered_map>
+
+namespace boost {
+namespace punycode {
+
+//------------------------------------------------
+//
+// Public Suffix List
+//
+// https://github.com/publicsuffix/list/wiki/Format
+//
+
+/*  Each node of the trie is a label, and the path
+    from the root is a suffix read from the right.
+    A rule marks the node at its end. A wildcard
+    rule marks the node of the suffix after "*."
+    instead, since a wildcard is only ever the
+    first label, and an exception marks its node
+    as one. The root has the implicit rule "*".
+
+    The children of a node are contiguous, in
+    order of size and then octets, which keeps
+    most comparisons to the size alone.
+*/
+
+namespace {
+
+enum : unsigned char
+{
+    node_rule       = 1,
+    node_exception  = 2,
+    node_wildcard   = 4
+};
+
+// a node while the list is compiled
+struct build_node
+{
+    std::map<std::string, std::size_t> children;
+    unsigned char flags = 0;
+};
+
+} // (anon)
+
+static
+system::error_code
+make_error(system::errc::errc_t e) noexcept
+{
+    return system::error_code(
+        e, system::generic_category());
+}
+
+// add a rule, in the form of an IDNA
+static
+system::error_code
+insert_rule(
+    std::vector<build_node>& tree,
+    core::string_view rule,
+    unsigned char flags)
+{
+    std::size_t i = 0;
+    auto pos = rule.size();
+    for(;;)
+    {
+        auto b = pos;
+        while(b > 0 && rule[b - 1] != '.')
+            --b;
+        if(b == pos || pos - b > 63)
+            return make_error(
+                system::errc::invalid_argument);
+        std::string label(rule.data() + b, pos - b);
+        auto const it = tree[i].children.find(label);
+        if(it != tree[i].children.end())
+        {
+            i = it->second;
+        }
+        else
+        {
+            auto const j = tree.size();
+            tree[i].children.emplace(
+                std::move(label), j);
+            tree.emplace_back();
+            i = j;
+        }
+        if(b == 0)
+            break;
+        pos = b - 1;
+    }
+    tree[i].flags |= flags;
+    return {};
+}
+
+system::result<public_suffix_list>
+public_suffix_list::
+parse(core::string_view text)
+{
+    std::vector<build_node> tree(1);
+    tree[0].flags = node_wildcard;
+    std::size_t rules = 0;
+    std::string idna;
+    while(! text.empty())
+    {
+        auto n = text.find('\n');
+        if(n == core::string_view::npos)
+            n = text.size();
+        auto line = text.substr(0, n);
+        text.remove_prefix(
+            std::min(n + 1, text.size()));
+
+        // the rule is up to the first space
+        line = line.substr(0, line.find_first_of(" \t\r"));
+        if( line.empty() ||
+            line.substr(0, 2) == "//")
+            continue;
+
+        unsigned char flags = node_rule;
+        if(line.front() == '!')
+        {
+            flags = node_exception;
+            line.remove_prefix(1);
+        }
+        else if(line.substr(0, 2) == "*.")
+        {
+            flags = node_wildcard;
+            line.remove_prefix(2);
+        }
+        if(line.find('*') != core::string_view::npos)
+            return make_error(
+                system::errc::invalid_argument);
+
+        auto rv = utf8_to_idna(line, std::move(idna));
+        if(! rv)
+            return rv.error();
+        idna = std::move(*rv);
+        auto const ec = insert_rule(tree, idna, flags);
+        if(ec.failed())
+            return ec;
+        ++rules;
+    }
+
+    // lay the nodes out level by level, so that
+    // the children of each are contiguous, and
+    // keep each label in the pool once
+    public_suffix_list psl;
+    psl.rules_ = rules;
+    std::vector<std::size_t> order(1, 0);
+    std::unordered_map<std::string, std::uint32_t> labels;
+    std::vector<std::pair<std::string const*, std::size_t>> kids;
+    psl.nodes_.resize(1);
+    for(std::size_t i = 0; i < order.size(); ++i)
+    {
+        auto const& t = tree[order[i]];
+        kids.clear();
+        for(auto const& c : t.children)
+            kids.emplace_back(&c.first, c.second);
+        std::sort(kids.begin(), kids.end(),
+            [](std::pair<std::string const*, std::size_t> const& a,
+               std::pair<std::string const*, std::size_t> const& b)
+            {
+                if(a.first->size() != b.first->size())
+                    return a.first->size() < b.first->size();
+                return *a.first < *b.first;
+            });
+        if(kids.size() > 0xffff)
+            return make_error(
+                system::errc::value_too_large);
+        auto& nd = psl.nodes_[i];
+        nd.flags = t.flags;
+        nd.first = static_cast<std::uint32_t>(
+            psl.nodes_.size());
+        nd.count = static_cast<std::uint16_t>(kids.size());
+        for(auto const& k : kids)
+        {
+            node c;
+            auto const r = labels.emplace(*k.first,
+                static_cast<std::uint32_t>(psl.pool_.size()));
+            if(r.second)
+                psl.pool_.append(*k.first);
+            c.label = r.first->second;
+            c.size = static_cast<unsigned char>(
+                k.first->size());
+            psl.nodes_.push_back(c);
+            order.push_back(k.second);
+        }
+    }
+    psl.pool_.shrink_to_fit();
+    return psl;
+}
+
+system::result<public_suffix_list>
+public_suffix_list::
+load(char const* path)
+{
+    std::string text;
+    auto const ec = detail::read_file(path, text);
+    if(ec.failed())
+        return ec;
+    return parse(text);
+}
+
+std::size_t
+public_suffix_list::
+find(core::string_view s) const noexcept
+{
+    auto const p = s.data();
+    auto pos = s.size();
+    if(pos > 0 && p[pos - 1] == '.')
+        --pos;
+    std::size_t best = pos;
+    node const* n = nodes_.empty() ?
+        nullptr : nodes_.data();
+    for(;;)
+    {
+        // the label before pos
+        auto b = pos;
+        while(b > 0 && p[b - 1] != '.')
+            --b;
+        if(! n || (n->flags & node_wildcard))
+            best = b;
+        if(! n)
+            break;
+
+        // the child with this label
+        auto const size = pos - b;
+        auto lo = nodes_.data() + n->first;
+        auto hi = lo + n->count;
+        n = nullptr;
+        while(lo < hi)
+        {
+            auto const mid = lo + (hi - lo) / 2;
+            int c = mid->size < size ? -1 :
+                mid->size > size ? 1 :
+                std::memcmp(
+                    pool_.data() + mid->label,
+                    p + b, size);
+            if(c < 0)
+            {
+                lo = mid + 1;
+            }
+            else if(c > 0)
+            {
+                hi = mid;
+            }
+            else
+            {
+                n = mid;
+                break;
+            }
+        }
+        if(! n)
+            break;
+        if(n->flags & node_exception)
+        {
+            // the rule without its first label
+            return (std::min)(pos + 1, s.size());
+        }
+        if(n->flags & node_rule)
+            best = b;
+        if(b == 0)
+            break;
+        pos = b - 1;
+    }
+    return best;
+}
+
+core::string_view
+public_suffix_list::
+registrable_domain(
+    core::string_view s) const noexcept
+{
+    auto const i = find(s);
+    if(i < 2)
+        return {};
+    auto b = i - 1;
+    while(b > 0 && s[b - 1] != '.')
+        --b;
+    if(b == i - 1)
+        return {};
+    return s.substr(b);
+}
+
+} // punycode
+} // boost
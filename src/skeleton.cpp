@@ -0,0 +1,436 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#include <boost/punycode/idna.hpp>
+#include <boost/punycode/idna_hash.hpp>
+#include <boost/punycode/detail/nameprep.hpp>
+#include <boost/punycode/transcode.hpp>
+#include <boost/punycode/utf8_input.hpp>
+#include <boost/punycode/utf8_output.hpp>
+#include "src/detail/decode_label.hpp"
+#include "src/detail/nfc.hpp"
+#include "src/detail/unicode_tables.hpp"
+#include <cstring>
+
+namespace boost {
+namespace punycode {
+
+//------------------------------------------------
+//
+// UTS #39 skeleton
+//
+// https://www.unicode.org/reports/tr39/#Confusable_Detection
+//
+
+/*  The skeleton of a string is its NFD with each
+    code point replaced by its prototype, put in
+    NFD again. The prototypes are stored in NFD,
+    so the second NFD only has to put the marks
+    where one prototype meets the next in
+    canonical order. All of it is done as the
+    code points of each label leave nameprep,
+    without a buffer for the domain.
+*/
+
+namespace {
+
+// the longest run of marks put in order. A
+// longer one is ordered in parts, as the
+// Stream-Safe Text Format of UAX #15 would
+constexpr std::size_t max_marks = 32;
+
+// puts each run of marks in canonical
+// order on the way to a function
+class canonical_order
+{
+    char32_t mark_[max_marks];
+    unsigned char ccc_[max_marks];
+    std::size_t n_ = 0;
+
+public:
+    template<class Function>
+    void
+    flush(Function&& f)
+    {
+        for(std::size_t i = 0; i < n_; ++i)
+            f(mark_[i]);
+        n_ = 0;
+    }
+
+    template<class Function>
+    void
+    put(char32_t cp, Function&& f)
+    {
+        auto const ccc = detail::nfc_ccc(cp);
+        if(ccc == 0)
+        {
+            flush(f);
+            f(cp);
+            return;
+        }
+        if(n_ == max_marks)
+            flush(f);
+        // a stable insertion by class
+        auto i = n_++;
+        for(; i > 0 && ccc_[i - 1] > ccc; --i)
+        {
+            mark_[i] = mark_[i - 1];
+            ccc_[i] = ccc_[i - 1];
+        }
+        mark_[i] = cp;
+        ccc_[i] = static_cast<unsigned char>(ccc);
+    }
+};
+
+template<class Sink>
+class skeleton_writer
+{
+    Sink& sink_;
+
+    // the first NFD, before mapping, and the
+    // second, where prototypes meet. Nameprep
+    // output is NFKC, whose decomposition may
+    // need ordering too
+    canonical_order decomposed_;
+    canonical_order mapped_;
+
+    // replace with the prototype
+    void
+    map(char32_t cp)
+    {
+        auto const i = detail::confusable_lookup(cp);
+        if(i == 0)
+            return mapped_.put(cp, sink_);
+        auto const v = detail::confusable_prototypes[i];
+        auto p = detail::confusable_pool + (v >> 5);
+        for(auto const end = p + (v & 0x1f); p != end; ++p)
+            mapped_.put(*p, sink_);
+    }
+
+    void
+    put(char32_t cp)
+    {
+        decomposed_.put(cp,
+            [this](char32_t c)
+            {
+                map(c);
+            });
+    }
+
+public:
+    explicit
+    skeleton_writer(Sink& sink) noexcept
+        : sink_(sink)
+    {
+    }
+
+    // decompose to NFD
+    void
+    push(char32_t cp)
+    {
+        if(cp < 0x80)
+            return put(cp);
+        if(cp - detail::hangul_s < detail::hangul_s_count)
+        {
+            char32_t d[3];
+            auto const n = detail::hangul_decompose(cp, d);
+            for(std::size_t i = 0; i < n; ++i)
+                put(d[i]);
+            return;
+        }
+        auto const v = detail::nfc_lookup(cp);
+        auto const len = (v >> 10) & 7;
+        if(len == 0)
+            return put(cp);
+        auto p = detail::nfc_pool + (v >> 13);
+        for(auto const end = p + len; p != end; ++p)
+            put(*p);
+    }
+
+    void
+    finish()
+    {
+        decomposed_.flush(
+            [this](char32_t c)
+            {
+                map(c);
+            });
+        mapped_.flush(sink_);
+    }
+};
+
+// appends the utf8 of the skeleton
+struct string_sink
+{
+    std::string& s;
+
+    void
+    operator()(char32_t cp)
+    {
+        char buf[4];
+        utf8_output out(buf);
+        out = cp;
+        s.append(buf, out.base());
+    }
+};
+
+// hashes the utf8 of the skeleton
+struct hash_sink
+{
+    detail::fnv1a f;
+
+    void
+    operator()(char32_t cp) noexcept
+    {
+        char buf[4];
+        utf8_output out(buf);
+        out = cp;
+        for(char const* p = buf; p != out.base(); ++p)
+            f(*p);
+    }
+};
+
+} // (anon)
+
+static
+bool
+is_ascii(core::string_view s) noexcept
+{
+    for(char c : s)
+        if(static_cast<unsigned char>(c) >= 0x80)
+            return false;
+    return true;
+}
+
+// true if the label begins with "xn--", in any case
+static
+bool
+is_ace(core::string_view s) noexcept
+{
+    return
+        s.size() >= 4 &&
+        (s[0] | 0x20) == 'x' &&
+        (s[1] | 0x20) == 'n' &&
+        s[2] == '-' &&
+        s[3] == '-';
+}
+
+// no label of DNS is longer
+static constexpr std::size_t max_label = 63;
+
+// feed the nameprep of [first, last) to w,
+// returning false at a prohibited code point
+template<class InputIt, class Sink>
+static
+bool
+prep_label(
+    InputIt first,
+    InputIt last,
+    skeleton_writer<Sink>& w)
+{
+    detail::nameprep_iterator<InputIt> it(first, last);
+    detail::nameprep_iterator<InputIt> const end(last);
+    for(; it != end; ++it)
+        w.push(*it);
+    return ! it.prohibited();
+}
+
+// feed the label an ACE label decodes to, or
+// return false if it is not the punycode of one
+template<class Sink>
+static
+bool
+ace_skeleton(
+    char32_t const* src,
+    std::size_t n,
+    skeleton_writer<Sink>& w)
+{
+    if(n > max_label)
+        return false;
+    char32_t dest[max_label];
+    auto const m = detail::decode_label(
+        src + 4, n - 4, dest);
+    if(m == SIZE_MAX || m == 0)
+        return false;
+    char32_t const* const first = dest;
+    return prep_label(first, first + m, w);
+}
+
+// feed the nameprep of the utf8 between two dots
+// to w. It can map to a dot, which ends a label
+// as it does in utf8_to_idna, so that each label
+// of the output which is an ACE label is decoded
+template<class Sink>
+static
+bool
+prep_labels(
+    core::string_view s,
+    skeleton_writer<Sink>& w)
+{
+    using iterator =
+        detail::nameprep_iterator<utf8_input>;
+    iterator it(
+        utf8_input(s.data(), s.data() + s.size()),
+        utf8_input(s.data() + s.size()));
+    iterator const end(
+        utf8_input(s.data() + s.size()));
+    for(;;)
+    {
+        // the start of the label is held back
+        // until it is known not to be ACE
+        char32_t buf[max_label];
+        std::size_t n = 0;
+        bool held = true;
+        bool ascii = true;
+        for(; it != end &&
+            ! detail::is_label_dot(*it); ++it)
+        {
+            auto const cp = *it;
+            if(cp >= 0x80)
+                ascii = false;
+            if(held && n < max_label)
+            {
+                buf[n++] = cp;
+                continue;
+            }
+            if(held)
+            {
+                for(std::size_t i = 0; i < n; ++i)
+                    w.push(buf[i]);
+                held = false;
+            }
+            w.push(cp);
+        }
+        if(it.prohibited())
+            return false;
+        bool const ace = ascii && n >= 4 &&
+            buf[0] == 'x' && buf[1] == 'n' &&
+            buf[2] == '-' && buf[3] == '-';
+        if(ace)
+        {
+            if( ! held ||
+                ! ace_skeleton(buf, n, w))
+                return false;
+        }
+        else if(held)
+        {
+            for(std::size_t i = 0; i < n; ++i)
+                w.push(buf[i]);
+        }
+        if(it == end)
+            return true;
+        w.push('.');
+        ++it;
+    }
+}
+
+template<class Sink>
+static
+bool
+label_skeleton(
+    core::string_view s,
+    skeleton_writer<Sink>& w)
+{
+    if(! is_ascii(s))
+        return prep_labels(s, w);
+    if(! is_ace(s))
+    {
+        // nameprep only lowers the case of ascii
+        for(char c : s)
+        {
+            if(c >= 'A' && c <= 'Z')
+                c += 'a' - 'A';
+            w.push(static_cast<unsigned char>(c));
+        }
+        return true;
+    }
+    if(s.size() > max_label)
+        return false;
+    char32_t src[max_label];
+    for(std::size_t i = 0; i < s.size(); ++i)
+        src[i] = static_cast<unsigned char>(s[i]);
+    return ace_skeleton(src, s.size(), w);
+}
+
+template<class Sink>
+static
+system::error_code
+domain_skeleton(
+    core::string_view s,
+    Sink& sink)
+{
+    if(detail::exceeds_max_input(s.size()))
+        return system::error_code(
+            system::errc::value_too_large,
+            system::generic_category());
+    if(! is_valid_utf8(s))
+        return system::error_code(
+            system::errc::illegal_byte_sequence,
+            system::generic_category());
+    skeleton_writer<Sink> w(sink);
+    for(;;)
+    {
+        auto const dot = static_cast<char const*>(
+            std::memchr(s.data(), '.', s.size()));
+        auto const n = dot ?
+            static_cast<std::size_t>(dot - s.data()) :
+            s.size();
+        if(! label_skeleton(s.substr(0, n), w))
+            return system::error_code(
+                system::errc::invalid_argument,
+                system::generic_category());
+        if(! dot)
+            break;
+        w.push('.');
+        s.remove_prefix(n + 1);
+    }
+    w.finish();
+    return {};
+}
+
+system::result<std::string>
+skeleton(
+    core::string_view domain,
+    std::string&& storage)
+{
+    storage.clear();
+    string_sink sink{storage};
+    auto const ec = domain_skeleton(domain, sink);
+    if(ec.failed())
+        return ec;
+    return std::move(storage);
+}
+
+std::uint64_t
+skeleton_hash(
+    core::string_view domain) noexcept
+{
+    hash_sink sink;
+    if(domain_skeleton(domain, sink).failed())
+    {
+        // the domain stands for itself
+        sink.f = {};
+        for(char c : domain)
+            sink.f(c);
+    }
+    return sink.f.h;
+}
+
+void
+skeleton_hash(
+    core::string_view const* domains,
+    std::size_t n,
+    std::uint64_t* hashes) noexcept
+{
+    for(std::size_t i = 0; i < n; ++i)
+        hashes[i] = skeleton_hash(domains[i]);
+}
+
+} // punycode
+} // boost
@@ -0,0 +1,205 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#include <boost/punycode/transcode.hpp>
+#include <boost/punycode/detail/utf8_dfa.hpp>
+#include "src/detail/simd.hpp"
+
+#ifdef BOOST_PUNYCODE_HAS_X86_SIMD
+# define BOOST_PUNYCODE_SIMD_NS sse4
+# define BOOST_PUNYCODE_SIMD_TARGET BOOST_PUNYCODE_TARGET_SSE4
+# include "src/detail/utf8_simd.hpp"
+# define BOOST_PUNYCODE_SIMD_NS avx2
+# define BOOST_PUNYCODE_SIMD_TARGET BOOST_PUNYCODE_TARGET_AVX2
+# include "src/detail/utf8_simd.hpp"
+# define BOOST_PUNYCODE_SIMD_NS avx512
+# define BOOST_PUNYCODE_SIMD_TARGET BOOST_PUNYCODE_TARGET_AVX512
+# include "src/detail/utf8_simd.hpp"
+#endif
+
+namespace boost {
+namespace punycode {
+
+namespace detail {
+
+bool
+is_valid_utf8(
+    core::string_view s,
+    simd_level level) noexcept
+{
+    auto const p = reinterpret_cast<
+        unsigned char const*>(s.data());
+    switch(usable(level))
+    {
+#ifdef BOOST_PUNYCODE_HAS_X86_SIMD
+    case simd_level::avx512:
+        return avx512::utf8_validate(p, s.size());
+    case simd_level::avx2:
+        return avx2::utf8_validate(p, s.size());
+    case simd_level::sse4:
+        return sse4::utf8_validate(p, s.size());
+#endif
+    default:
+        return utf8_validate_dfa(p, p + s.size());
+    }
+}
+
+std::size_t
+utf8_to_utf32(
+    core::string_view s,
+    char32_t* dest,
+    simd_level level) noexcept
+{
+    auto const p = reinterpret_cast<
+        unsigned char const*>(s.data());
+    switch(usable(level))
+    {
+#ifdef BOOST_PUNYCODE_HAS_X86_SIMD
+    case simd_level::avx512:
+        return avx512::utf8_decode(p, s.size(), dest);
+    case simd_level::avx2:
+        return avx2::utf8_decode(p, s.size(), dest);
+    case simd_level::sse4:
+        return sse4::utf8_decode(p, s.size(), dest);
+#endif
+    default:
+        return utf8_decode_dfa(p, p + s.size(), dest);
+    }
+}
+
+utf8_encode_result
+utf32_to_utf8(
+    char32_t const* first,
+    char32_t const* last,
+    char* dest,
+    char* end,
+    simd_level level) noexcept
+{
+    switch(usable(level))
+    {
+#ifdef BOOST_PUNYCODE_HAS_X86_SIMD
+    case simd_level::avx512:
+        return avx512::utf8_encode(first, last, dest, end);
+    case simd_level::avx2:
+        return avx2::utf8_encode(first, last, dest, end);
+    case simd_level::sse4:
+        return sse4::utf8_encode(first, last, dest, end);
+#endif
+    default:
+        return utf8_encode_checked(first, last, dest, end);
+    }
+}
+
+std::size_t
+utf8_length(
+    char32_t const* src,
+    std::size_t n,
+    simd_level level) noexcept
+{
+    switch(usable(level))
+    {
+#ifdef BOOST_PUNYCODE_HAS_X86_SIMD
+    case simd_level::avx512:
+        return avx512::utf8_length(src, src + n);
+    case simd_level::avx2:
+        return avx2::utf8_length(src, src + n);
+    case simd_level::sse4:
+        return sse4::utf8_length(src, src + n);
+#endif
+    default:
+        return utf8_length_scalar(src, src + n);
+    }
+}
+
+std::size_t
+utf32_length(
+    core::string_view s,
+    simd_level level) noexcept
+{
+    auto const p = reinterpret_cast<
+        unsigned char const*>(s.data());
+    switch(usable(level))
+    {
+#ifdef BOOST_PUNYCODE_HAS_X86_SIMD
+    case simd_level::avx512:
+        return avx512::utf32_length(p, s.size());
+    case simd_level::avx2:
+        return avx2::utf32_length(p, s.size());
+    case simd_level::sse4:
+        return sse4::utf32_length(p, s.size());
+#endif
+    default:
+        return utf32_length_scalar(p, p + s.size());
+    }
+}
+
+} // detail
+
+bool
+is_valid_utf8(
+    core::string_view s) noexcept
+{
+    return detail::is_valid_utf8(
+        s, detail::cpu_simd_level());
+}
+
+system::result<std::size_t>
+utf8_to_utf32(
+    core::string_view s,
+    char32_t* dest) noexcept
+{
+    auto const n = detail::utf8_to_utf32(
+        s, dest, detail::cpu_simd_level());
+    if(n == SIZE_MAX)
+        return system::error_code(
+            system::errc::illegal_byte_sequence,
+            system::generic_category());
+    return n;
+}
+
+std::size_t
+utf8_length(
+    char32_t const* src,
+    std::size_t n) noexcept
+{
+    return detail::utf8_length(
+        src, n, detail::cpu_simd_level());
+}
+
+std::size_t
+utf32_length(
+    core::string_view s) noexcept
+{
+    return detail::utf32_length(
+        s, detail::cpu_simd_level());
+}
+
+system::result<std::size_t>
+utf32_to_utf8(
+    char32_t const* src,
+    std::size_t n,
+    char* dest,
+    std::size_t size) noexcept
+{
+    auto const rv = detail::utf32_to_utf8(
+        src, src + n, dest, dest + size,
+        detail::cpu_simd_level());
+    if(rv.in == src + n)
+        return static_cast<std::size_t>(rv.out - dest);
+    if(! detail::is_scalar_value(*rv.in))
+        return system::error_code(
+            system::errc::illegal_byte_sequence,
+            system::generic_category());
+    return system::error_code(
+        system::errc::no_buffer_space,
+        system::generic_category());
+}
+
+} // punycode
+} // boost
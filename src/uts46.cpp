@@ -0,0 +1,502 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#include <boost/punycode/uts46.hpp>
+#include <boost/punycode/idna.hpp>
+#include <boost/punycode/detail/bidi.hpp>
+#include <boost/punycode/punycode.hpp>
+#include <boost/punycode/transcode.hpp>
+#include "src/detail/context.hpp"
+#include "src/detail/decode_label.hpp"
+#include "src/detail/nfc.hpp"
+#include "src/detail/u32_buffer.hpp"
+#include "src/detail/unicode_tables.hpp"
+#include <cstring>
+#include <iterator>
+
+namespace boost {
+namespace punycode {
+
+//------------------------------------------------
+//
+// UTS #46
+//
+// https://www.unicode.org/reports/tr46/
+//
+
+// the status of a code point, in the
+// low bits of what uts46_lookup returns
+enum : std::uint32_t
+{
+    status_valid        = 0,
+    status_disallowed   = 1,
+    status_mapped       = 2,
+    status_replaced     = 3,
+    status_deviation    = 4,
+
+    // the result may not be NFC
+    status_check        = 8
+};
+
+// longest label and domain, per RFC 1035
+static constexpr std::size_t max_label = 63;
+static constexpr std::size_t max_domain = 253;
+
+static
+system::error_code
+uts46_error() noexcept
+{
+    return system::error_code(
+        system::errc::invalid_argument,
+        system::generic_category());
+}
+
+static
+bool
+is_ldh(char32_t cp) noexcept
+{
+    return
+        cp - 'a' < 26u ||
+        cp - '0' < 10u ||
+        cp == '-';
+}
+
+static
+bool
+is_ace_prefix(
+    char32_t const* p,
+    std::size_t n) noexcept
+{
+    return
+        n >= 4 &&
+        p[0] == 'x' &&
+        p[1] == 'n' &&
+        p[2] == '-' &&
+        p[3] == '-';
+}
+
+/*  Step 1, Map, with one table lookup for each
+    code point above ascii. Disallowed code points
+    fail at once, since they can only be an error
+    later. Returns true if the result may need
+    normalizing.
+*/
+static
+system::result<bool>
+uts46_map(
+    char32_t const* p,
+    std::size_t n,
+    bool transitional,
+    detail::u32_buffer& out)
+{
+    bool check = false;
+    out.clear();
+    for(auto const end = p + n; p != end; ++p)
+    {
+        char32_t const cp = *p;
+        if(cp < 0x80)
+        {
+            // only upper case maps
+            out.push_back(
+                cp - 'A' < 26u ? cp + 32 : cp);
+            continue;
+        }
+        auto const v = detail::uts46_lookup(cp);
+        if(v & status_check)
+            check = true;
+        switch(v & 7)
+        {
+        case status_valid:
+            out.push_back(cp);
+            break;
+
+        case status_mapped:
+            // capital sharp s maps to a deviation
+            if(transitional && cp == 0x1e9e)
+            {
+                out.push_back('s');
+                out.push_back('s');
+                break;
+            }
+            out.push_back(static_cast<char32_t>(
+                cp + (static_cast<std::int32_t>(v) >> 8)));
+            break;
+
+        case status_deviation:
+            if(! transitional)
+            {
+                out.push_back(cp);
+                break;
+            }
+            BOOST_FALLTHROUGH;
+
+        case status_replaced:
+            out.append(
+                detail::uts46_pool + (v >> 9),
+                (v >> 4) & 31);
+            break;
+
+        default:
+            return uts46_error();
+        }
+    }
+    return check;
+}
+
+// true if each code point has a status which is
+// allowed in a label, valid or, when processing
+// is not transitional, deviation
+static
+bool
+uts46_allowed(
+    char32_t const* p,
+    std::size_t n,
+    bool transitional) noexcept
+{
+    for(auto const end = p + n; p != end; ++p)
+    {
+        if(*p < 0x80)
+            continue;
+        auto const s = detail::uts46_lookup(*p) & 7;
+        if( s != status_valid && (transitional ||
+            s != status_deviation))
+            return false;
+    }
+    return true;
+}
+
+/*  Validity criteria of section 4.1, for a
+    label which is not empty. The status of
+    each code point is checked by the caller.
+    Sets ascii if the label has no code point
+    above 0x7f. The label is passed to the bidi
+    rule, which the caller checks once all
+    labels are seen, and the contextual rules.
+*/
+static
+bool
+uts46_valid(
+    char32_t const* p,
+    std::size_t n,
+    uts46_options const& opt,
+    bool& ascii,
+    detail::bidi_rule& bidi,
+    detail::context_rule& context) noexcept
+{
+    BOOST_ASSERT(n > 0);
+    if(opt.check_hyphens)
+    {
+        // V2, V3
+        if( (n >= 4 && p[2] == '-' && p[3] == '-') ||
+            p[0] == '-' || p[n - 1] == '-')
+            return false;
+    }
+    else if(is_ace_prefix(p, n))
+    {
+        // V4
+        return false;
+    }
+
+    // V6
+    if(detail::nfc_is_mark(p[0]))
+        return false;
+
+    bool const contextual =
+        opt.check_joiners || opt.check_contexto;
+    ascii = true;
+    for(auto const end = p + n; p != end; ++p)
+    {
+        char32_t const cp = *p;
+        if(opt.check_bidi)
+            bidi.push(cp);
+        if(contextual)
+            context.push(cp);
+        if(cp >= 0x80)
+        {
+            ascii = false;
+            continue;
+        }
+        // V5, and UseSTD3ASCIIRules
+        if(cp == '.')
+            return false;
+        if(opt.use_std3_rules && ! is_ldh(cp))
+            return false;
+    }
+    bidi.end_label();
+    // CheckJoiners, and CONTEXTO
+    return context.end_label();
+}
+
+namespace {
+
+// the buffers used while processing, which
+// live on the stack for short domains
+struct uts46_buffers
+{
+    detail::u32_buffer text;
+    detail::u32_buffer temp;
+    detail::u32_buffer label;
+    detail::u32_buffer norm;
+};
+
+} // (anon)
+
+/*  Processing, section 4. Each label is passed
+    to f as its code points and true if they are
+    all ascii, once the label is known to be
+    valid. The first error f returns stops the
+    processing.
+*/
+template<class Function>
+static
+system::error_code
+uts46_process(
+    core::string_view s,
+    uts46_options const& opt,
+    uts46_buffers& b,
+    Function const& f)
+{
+    // decode, then map
+    b.temp.resize(s.size());
+    auto const rv = utf8_to_utf32(s, b.temp.data());
+    if(rv.has_error())
+        return rv.error();
+    auto const mapped = uts46_map(
+        b.temp.data(), *rv, opt.transitional, b.text);
+    if(mapped.has_error())
+        return mapped.error();
+
+    // normalize, when the quick check fails
+    auto* text = &b.text;
+    if( *mapped && ! detail::nfc_quick_check(
+            text->data(), text->size()))
+    {
+        detail::nfc_normalize(
+            text->data(), text->size(), b.temp);
+        text = &b.temp;
+        // composing yields valid code points, but
+        // being sure costs little on this path
+        if(! uts46_allowed(text->data(),
+                text->size(), opt.transitional))
+            return uts46_error();
+    }
+
+    // break into labels, then convert and validate
+    detail::bidi_rule bidi;
+    detail::context_rule context(
+        opt.check_joiners, opt.check_contexto);
+    auto p = text->data();
+    auto const end = p + text->size();
+    for(;;)
+    {
+        auto q = p;
+        while(q != end && *q != '.')
+            ++q;
+        auto const n = static_cast<std::size_t>(q - p);
+        bool ascii = true;
+        system::error_code ec;
+        if(is_ace_prefix(p, n))
+        {
+            // the decoding is no longer than the input
+            auto const u = b.label.prepare(n);
+            auto const m = detail::decode_label(p + 4, n - 4, u);
+            if(m == SIZE_MAX || m == 0)
+                return uts46_error();
+            if(! detail::nfc_quick_check(u, m))
+            {
+                // V1
+                detail::nfc_normalize(u, m, b.norm);
+                if( b.norm.size() != m ||
+                    std::memcmp(b.norm.data(), u,
+                        m * sizeof(char32_t)) != 0)
+                    return uts46_error();
+            }
+            // validated as nontransitional
+            if( ! uts46_allowed(u, m, false) ||
+                ! uts46_valid(
+                    u, m, opt, ascii, bidi, context) ||
+                ascii)
+                return uts46_error();
+            ec = f(u, m, false);
+        }
+        else
+        {
+            if( n > 0 &&
+                ! uts46_valid(
+                    p, n, opt, ascii, bidi, context))
+                return uts46_error();
+            ec = f(p, n, ascii);
+        }
+        if(ec.failed())
+            return ec;
+        if(q == end)
+            break;
+        p = q + 1;
+    }
+    if(bidi.failed())
+        return uts46_error();
+    return {};
+}
+
+//------------------------------------------------
+
+// true if the ascii domain, which idna_classify
+// found to be an LDH host name without an ACE
+// label, is its own result under the options
+static
+bool
+uts46_plain(
+    core::string_view s,
+    bool check_hyphens,
+    bool verify_dns_length) noexcept
+{
+    // an LDH host name may end in a dot
+    if( verify_dns_length && (
+            s.size() > max_domain ||
+            s.back() == '.'))
+        return false;
+    if(! check_hyphens)
+        return true;
+    // hyphens in the third and fourth positions
+    for(;;)
+    {
+        if( s.size() >= 4 &&
+            s[2] == '-' && s[3] == '-')
+            return false;
+        auto const dot = s.find('.');
+        if(dot == core::string_view::npos)
+            return true;
+        s.remove_prefix(dot + 1);
+    }
+}
+
+// convert a domain which is ascii with nothing
+// to do but fold case, returning true if done
+static
+bool
+uts46_ascii(
+    core::string_view s,
+    bool check_hyphens,
+    bool verify_dns_length,
+    std::string& storage)
+{
+    auto const flags = idna_classify(s);
+    if( (flags & ~unsigned(has_upper)) != 0 ||
+        ! uts46_plain(s,
+            check_hyphens, verify_dns_length))
+        return false;
+    storage.assign(s.data(), s.size());
+    if(flags & has_upper)
+    {
+        for(auto& c : storage)
+            if(c >= 'A' && c <= 'Z')
+                c = static_cast<char>(c + 32);
+    }
+    return true;
+}
+
+system::result<std::string>
+uts46_to_ascii(
+    core::string_view s,
+    uts46_options const& opt,
+    std::string&& storage)
+{
+    if(detail::exceeds_max_input(s.size()))
+        return system::error_code(
+            system::errc::value_too_large,
+            system::generic_category());
+    if(uts46_ascii(s, opt.check_hyphens,
+            opt.verify_dns_length, storage))
+        return std::move(storage);
+
+    storage.clear();
+    uts46_buffers b;
+    auto const ec = uts46_process(s, opt, b,
+        [&](char32_t const* p, std::size_t n, bool ascii)
+            -> system::error_code
+        {
+            auto const size0 = storage.size();
+            if(ascii)
+            {
+                for(std::size_t i = 0; i < n; ++i)
+                    storage.push_back(
+                        static_cast<char>(p[i]));
+            }
+            else
+            {
+                // the punycode has a character for
+                // each code point, at least, so the
+                // label can be rejected unencoded
+                if( opt.verify_dns_length &&
+                    n > max_label - 4)
+                    return uts46_error();
+                // the encoding is quadratic
+                if(detail::exceeds_max_input(n))
+                    return system::error_code(
+                        system::errc::value_too_large,
+                        system::generic_category());
+                storage.append("xn--", 4);
+                encode(std::back_inserter(storage),
+                    p, p + n);
+            }
+            // A4
+            auto const size = storage.size() - size0;
+            if( opt.verify_dns_length && (
+                    size == 0 || size > max_label))
+                return uts46_error();
+            storage.push_back('.');
+            return {};
+        });
+    if(ec.failed())
+        return ec;
+    // the last label has no dot
+    storage.pop_back();
+    if( opt.verify_dns_length &&
+        storage.size() > max_domain)
+        return uts46_error();
+    return std::move(storage);
+}
+
+system::result<std::string>
+uts46_to_unicode(
+    core::string_view s,
+    uts46_options const& opt,
+    std::string&& storage)
+{
+    if(detail::exceeds_max_input(s.size()))
+        return system::error_code(
+            system::errc::value_too_large,
+            system::generic_category());
+    if(uts46_ascii(s, opt.check_hyphens,
+            false, storage))
+        return std::move(storage);
+
+    storage.clear();
+    uts46_buffers b;
+    auto const ec = uts46_process(s, opt, b,
+        [&](char32_t const* p, std::size_t n, bool)
+            -> system::error_code
+        {
+            auto const size0 = storage.size();
+            storage.resize(size0 + 4 * n + 1);
+            auto const rv = utf32_to_utf8(
+                p, n, &storage[size0], 4 * n);
+            BOOST_ASSERT(rv.has_value());
+            storage[size0 + *rv] = '.';
+            storage.resize(size0 + *rv + 1);
+            return {};
+        });
+    if(ec.failed())
+        return ec;
+    storage.pop_back();
+    return std::move(storage);
+}
+
+} // punycode
+} // boost
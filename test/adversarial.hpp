@@ -0,0 +1,128 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#ifndef BOOST_PUNYCODE_TEST_ADVERSARIAL_HPP
+#define BOOST_PUNYCODE_TEST_ADVERSARIAL_HPP
+
+#include <boost/punycode/ascii_count.hpp>
+#include <boost/punycode/punycode.hpp>
+#include <boost/punycode/transcode.hpp>
+#include <boost/punycode/utf8_output.hpp>
+#include <algorithm>
+#include <string>
+
+namespace boost {
+namespace punycode {
+
+/** Worst-case inputs for the quadratic paths
+
+    encode rescans its whole input once for every
+    distinct non-basic code point, and decode
+    shifts the tail of its output with memmove
+    for every code point it inserts. These build
+    inputs which make both do the most work.
+*/
+struct adversarial
+{
+    /** Return n distinct code points, descending from U+10FFFF
+
+        Every code point is distinct, so encode makes
+        one full pass per code point. Descending order
+        also means that decoding the result inserts
+        every code point at position zero.
+    */
+    static
+    std::u32string
+    distinct_high(std::size_t n)
+    {
+        std::u32string s;
+        s.reserve(n);
+        char32_t cp = 0x10FFFF;
+        while(s.size() < n && cp >= 0x80)
+        {
+            // skip the surrogates
+            if(cp < 0xE000 && cp >= 0xD800)
+                cp = 0xD7FF;
+            s.push_back(cp--);
+        }
+        return s;
+    }
+
+    /** Return n distinct code points nameprep allows
+
+        These are the ideographs of CJK Extension B,
+        descending from U+2A6D6, which nameprep
+        leaves alone, unlike the private use and
+        noncharacters of distinct_high.
+    */
+    static
+    std::u32string
+    distinct_ideographs(std::size_t n)
+    {
+        std::u32string s;
+        s.reserve(n);
+        char32_t cp = 0x2A6D6;
+        while(s.size() < n && cp >= 0x20000)
+            s.push_back(cp--);
+        return s;
+    }
+
+    /** Return n code points alternating U+0080 and U+10FFFF
+
+        Every delta the encoder emits spans almost the
+        entire code space, so every variable length
+        integer is as long as it can be.
+    */
+    static
+    std::u32string
+    max_deltas(std::size_t n)
+    {
+        std::u32string s;
+        s.reserve(n);
+        for(std::size_t i = 0; i < n; ++i)
+            s.push_back((i & 1) ? 0x10FFFF : 0x80);
+        return s;
+    }
+
+    /** Return punycode whose decoding inserts at position zero n times
+    */
+    static
+    std::string
+    front_insertions(std::size_t n)
+    {
+        return to_puny(distinct_high(n));
+    }
+
+    static
+    std::string
+    to_puny(std::u32string const& s)
+    {
+        std::string out;
+        out.resize(punycode::encode(
+            ascii_count(), s.begin(), s.end()).count());
+        punycode::encode(&out[0], s.begin(), s.end());
+        return out;
+    }
+
+    static
+    std::string
+    to_utf8(std::u32string const& s)
+    {
+        std::string out;
+        out.resize(utf8_length(s.data(), s.size()));
+        utf8_output(&out[0], &out[0] + out.size())
+            .write(s.data(), s.size());
+        return out;
+    }
+};
+
+} // punycode
+} // boost
+
+#endif
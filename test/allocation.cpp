@@ -0,0 +1,261 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#include <boost/punycode/ascii_count.hpp>
+#include <boost/punycode/idna.hpp>
+#include <boost/punycode/idna_hash.hpp>
+#include <boost/punycode/idna_view.hpp>
+#include <boost/punycode/punycode.hpp>
+#include <boost/punycode/utf32_count.hpp>
+#include <boost/punycode/utf8_count.hpp>
+#include <boost/punycode/utf8_input.hpp>
+#include <boost/punycode/utf8_output.hpp>
+
+#include "test_suite.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+//------------------------------------------------
+//
+// The global allocation functions are replaced
+// for the whole test executable so that every
+// call to operator new can be counted.
+//
+
+namespace {
+
+std::size_t g_allocs = 0;
+
+} // (anon)
+
+void*
+operator new(std::size_t n)
+{
+    ++g_allocs;
+    if(n == 0)
+        n = 1;
+    if(void* p = std::malloc(n))
+        return p;
+    throw std::bad_alloc();
+}
+
+void*
+operator new[](std::size_t n)
+{
+    return ::operator new(n);
+}
+
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace boost {
+namespace punycode {
+
+class allocation_test
+{
+public:
+    // counts allocations made by one call
+    template<class F>
+    static
+    std::size_t
+    allocations(F const& f)
+    {
+        auto const n0 = g_allocs;
+        f();
+        return g_allocs - n0;
+    }
+
+    // long enough that no std::string can hold
+    // the result in its small buffer
+    static
+    char const*
+    domain() noexcept
+    {
+        return
+            "B\xC3\xBC" "cher-\xC3\xBC" "ber-Stra\xC3\x9F" "en."
+            "\xD0\xA0\xD0\xBE\xD1\x81\xD1\x81\xD0\xB8\xD1\x8F."
+            "example.com";
+    }
+
+    void
+    testPunycode()
+    {
+        std::u32string const u = U"b\u00FCcher-\u00FCber";
+        char a[64];
+        BOOST_TEST_EQ(allocations([&]
+        {
+            punycode::encode(&a[0], u.begin(), u.end());
+        }), 0u);
+        BOOST_TEST_EQ(allocations([&]
+        {
+            punycode::encode(ascii_count(), u.begin(), u.end());
+        }), 0u);
+
+        char32_t d[64];
+        BOOST_TEST_EQ(allocations([&]
+        {
+            std::size_t len = 64;
+            punycode::decode("bcher-ber-q9af", 14, d, &len);
+        }), 0u);
+    }
+
+    void
+    testIterators()
+    {
+        core::string_view const s = domain();
+        utf8_input const first(s.data(), s.data() + s.size());
+        utf8_input const last(s.data() + s.size());
+        char32_t u[64];
+        char o[256];
+        BOOST_TEST_EQ(allocations([&]
+        {
+            std::copy(first, last, utf32_count());
+            std::copy(first, last, utf8_count());
+            auto const end = std::copy(first, last, &u[0]);
+            std::copy(&u[0], end, utf8_output(&o[0]));
+        }), 0u);
+    }
+
+    void
+    testIdna()
+    {
+        core::string_view const s = domain();
+
+        // a fresh result allocates exactly once
+        BOOST_TEST_EQ(allocations([&]
+        {
+            auto rv = utf8_to_idna(s);
+            BOOST_TEST(rv.has_value());
+        }), 1u);
+
+        // once storage has capacity, reusing it is free
+        std::string storage;
+        storage.reserve(256);
+        BOOST_TEST_EQ(allocations([&]
+        {
+            for(int i = 0; i < 10; ++i)
+            {
+                auto rv = utf8_to_idna(s, std::move(storage));
+                if(! BOOST_TEST(rv.has_value()))
+                    return;
+                storage = std::move(*rv);
+            }
+        }), 0u);
+        BOOST_TEST_EQ(storage,
+            "xn--bcher-ber-strassen-m6bf.xn--h1alffa9f.example.com");
+    }
+
+    void
+    testBorrowed()
+    {
+        // nothing to convert, nothing copied
+        std::string storage;
+        BOOST_TEST_EQ(allocations([&]
+        {
+            auto rv = utf8_to_idna_borrowed(
+                "www.example-domain-name.com", storage);
+            BOOST_TEST(rv.has_value());
+        }), 0u);
+        BOOST_TEST(storage.empty());
+
+        // otherwise, storage is reused
+        storage.reserve(256);
+        core::string_view const s = domain();
+        BOOST_TEST_EQ(allocations([&]
+        {
+            auto rv = utf8_to_idna_borrowed(s, storage);
+            BOOST_TEST(rv.has_value());
+        }), 0u);
+    }
+
+    void
+    testView()
+    {
+        // streaming into an existing buffer
+        idna_view const v(domain());
+        char o[256];
+        char* end = o;
+        BOOST_TEST_EQ(allocations([&]
+        {
+            end = std::copy(v.begin(), v.end(), &o[0]);
+        }), 0u);
+        BOOST_TEST_EQ(std::string(&o[0], end),
+            "xn--bcher-ber-strassen-m6bf.xn--h1alffa9f.example.com");
+    }
+
+    void
+    testHash()
+    {
+        std::string const a = domain();
+        std::string const b =
+            "xn--bcher-ber-strassen-m6bf.xn--h1alffa9f.EXAMPLE.com";
+        bool eq = false;
+        std::size_t ha = 0;
+        std::size_t hb = 0;
+        BOOST_TEST_EQ(allocations([&]
+        {
+            eq = idna_equal()(a, b);
+            ha = idna_hash()(a);
+            hb = idna_hash()(b);
+        }), 0u);
+        BOOST_TEST(eq);
+        BOOST_TEST_EQ(ha, hb);
+
+        // every kind of label pair
+        BOOST_TEST_EQ(allocations([&]
+        {
+            eq = idna_equivalent(
+                "B\xC3\xBC" "cher.\xD0\xA0\xD0\xBE\xD1\x81.EXAMPLE.com",
+                "xn--bcher-kva.\xD1\x80\xD0\xBE\xD1\x81.example.com");
+        }), 0u);
+        BOOST_TEST(eq);
+    }
+
+    void
+    run()
+    {
+        testPunycode();
+        testIterators();
+        testIdna();
+        testBorrowed();
+        testView();
+        testHash();
+    }
+};
+
+TEST_SUITE(
+    allocation_test,
+    "boost.punycode.allocation");
+
+} // punycode
+} // boost
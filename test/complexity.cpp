@@ -0,0 +1,251 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+#include <boost/punycode/idna.hpp>
+#include <boost/punycode/punycode.hpp>
+#include <boost/system/system_error.hpp>
+
+#include "adversarial.hpp"
+#include "test_suite.hpp"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace punycode {
+
+/*  Complexity regression tests
+
+    These time the worst-case inputs at doubling
+    sizes and fail if the cost grows faster than
+    the stated bound. Each size is timed several
+    times and the fastest run is kept, and the
+    bound is applied with a factor of two slack,
+    so that noise on a loaded machine does not
+    fail the build while a regression from
+    quadratic to cubic still does.
+*/
+class complexity_test
+{
+public:
+    // growth per doubling of the input
+    static constexpr double linear = 2;
+    static constexpr double quadratic = 4;
+    static constexpr double slack = 2;
+
+    template<class F>
+    static
+    double
+    seconds(F const& f)
+    {
+        using clock = std::chrono::steady_clock;
+        double best = 1e9;
+        for(int i = 0; i < 5; ++i)
+        {
+            auto const t0 = clock::now();
+            f();
+            auto const t1 = clock::now();
+            auto const t = std::chrono::duration<
+                double>(t1 - t0).count();
+            if(t < best)
+                best = t;
+        }
+        return best;
+    }
+
+    // time make(n) at doubling sizes, and check
+    // that each step grows by at most `bound`
+    template<class Make>
+    void
+    check_growth(
+        char const* name,
+        double bound,
+        std::size_t n0,
+        Make const& make)
+    {
+        // inputs over the configured limit are refused
+        // rather than timed; 4 covers the utf8 octets
+        // or punycode digits per code point
+        if(detail::exceeds_max_input(4 * 4 * n0))
+            return;
+        double prev = 0;
+        for(std::size_t n = n0; n <= 4 * n0; n *= 2)
+        {
+            auto const f = make(n);
+            auto const t = seconds(f);
+            if(prev > 0)
+            {
+                auto const ratio = t / prev;
+                if(! BOOST_TEST_LE(ratio, bound * slack))
+                    test_suite::log <<
+                        name << ": n=" << n <<
+                        " grew " << ratio << "x\n";
+            }
+            prev = t;
+        }
+    }
+
+    void
+    testEncode()
+    {
+        check_growth("encode distinct_high", quadratic, 1000,
+            [](std::size_t n)
+            {
+                auto s = adversarial::distinct_high(n);
+                return [s]
+                {
+                    std::string out(8 * s.size(), 0);
+                    punycode::encode(
+                        &out[0], s.begin(), s.end());
+                };
+            });
+
+        check_growth("encode max_deltas", linear, 50000,
+            [](std::size_t n)
+            {
+                auto s = adversarial::max_deltas(n);
+                return [s]
+                {
+                    std::string out(8 * s.size(), 0);
+                    punycode::encode(
+                        &out[0], s.begin(), s.end());
+                };
+            });
+    }
+
+    void
+    testDecode()
+    {
+        check_growth("decode front_insertions", quadratic, 2000,
+            [](std::size_t n)
+            {
+                auto s = adversarial::front_insertions(n);
+                return [s, n]
+                {
+                    std::vector<char32_t> out(n);
+                    std::size_t len = out.size();
+                    punycode::decode(s.data(), s.size(),
+                        out.data(), &len);
+                    BOOST_TEST_EQ(len, n);
+                };
+            });
+    }
+
+    void
+    testIdna()
+    {
+        check_growth("utf8_to_idna distinct_ideographs", quadratic, 250,
+            [](std::size_t n)
+            {
+                auto s = adversarial::to_utf8(
+                    adversarial::distinct_ideographs(n));
+                return [s]
+                {
+                    auto rv = utf8_to_idna(s);
+                    BOOST_TEST(rv.has_value());
+                };
+            });
+    }
+
+    void
+    testMaxInput()
+    {
+#if BOOST_PUNYCODE_MAX_INPUT_LENGTH
+        std::size_t const n =
+            BOOST_PUNYCODE_MAX_INPUT_LENGTH;
+        auto const s =
+            adversarial::distinct_high(n + 1);
+        std::string out(8 * s.size(), 0);
+        BOOST_TEST_THROWS(punycode::encode(
+            &out[0], s.begin(), s.end()),
+            system::system_error);
+        BOOST_TEST_NO_THROW(punycode::encode(
+            &out[0], s.begin(), s.end() - 1));
+
+        std::string const a(n + 1, 'a');
+        std::vector<char32_t> u(n + 1);
+        std::size_t len = u.size();
+        BOOST_TEST_THROWS(punycode::decode(
+            a.data(), a.size(), u.data(), &len),
+            system::system_error);
+
+        auto rv = utf8_to_idna(a);
+        BOOST_TEST(rv.has_error());
+        BOOST_TEST(rv.error() ==
+            system::errc::value_too_large);
+
+        // soft hyphens map to nothing, leaving
+        // a short name from a long input
+        std::string h = "a";
+        while(h.size() <= n)
+            h += "\xC2\xAD";
+        char buf[255];
+        auto const rw = utf8_to_dns_wire(
+            h, buf, sizeof(buf));
+        BOOST_TEST(rw.has_error());
+        BOOST_TEST(rw.error() ==
+            system::errc::value_too_large);
+        BOOST_TEST(utf8_to_idna(h).error() ==
+            system::errc::value_too_large);
+        BOOST_TEST(utf8_to_dns_wire(
+            h.substr(0, 3), buf, sizeof(buf)).has_value());
+
+        // U+3300 maps to four code points, giving
+        // a label too long to encode from an input
+        // which is not
+        if(4 * (n / 3) > n)
+        {
+            std::string x;
+            std::string y;
+            std::u16string x16;
+            while(x.size() + 3 <= n)
+            {
+                x += "\xE3\x8C\x80";
+                y += "\xE3\x82\xA2\xE3\x83\x91"
+                     "\xE3\x83\xBC\xE3\x83\x88";
+                x16 += u'\x3300';
+            }
+            BOOST_TEST(utf8_to_idna(x).error() ==
+                system::errc::value_too_large);
+            BOOST_TEST(utf16_to_idna(x16).error() ==
+                system::errc::value_too_large);
+            std::size_t offset;
+            BOOST_TEST(utf8_to_idna(x, {}, offset).error() ==
+                system::errc::value_too_large);
+            std::vector<label_info> labels;
+            BOOST_TEST(utf8_to_idna(x, labels).error() ==
+                system::errc::value_too_large);
+            BOOST_TEST(utf8_to_dns_wire(
+                x, buf, sizeof(buf)).error() ==
+                    system::errc::value_too_large);
+            BOOST_TEST(! idna_equivalent(x, y));
+            if(n >= 4)
+                BOOST_TEST(utf8_to_idna(
+                    x.substr(0, 3 * (n / 4))).has_value());
+        }
+#endif
+    }
+
+    void
+    run()
+    {
+        testEncode();
+        testDecode();
+        testIdna();
+        testMaxInput();
+    }
+};
+
+TEST_SUITE(
+    complexity_test,
+    "boost.punycode.complexity");
+
+} // punycode
+} // boost
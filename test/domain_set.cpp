@@ -0,0 +1,353 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+// Test that header file is self-contained.
+#include <boost/punycode/domain_set.hpp>
+
+#include "test_suite.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace punycode {
+
+struct domain_set_test
+{
+    static
+    domain_set
+    make_set(
+        std::vector<core::string_view> const& v)
+    {
+        auto rv = domain_set::build(v.data(), v.size());
+        BOOST_TEST(rv.has_value());
+        if(! rv)
+            return {};
+        return std::move(*rv);
+    }
+
+    static
+    domain_set
+    make_set()
+    {
+        return make_set({
+            "example.com",
+            "*.wild.org",
+            "B\xC3\xBC" "cher.de",                  // Bücher.de
+            "xn--mller-kva.de",                     // müller.de
+            "ads.tracker.net.",
+            "www.example.com",                      // below example.com
+            "example.com",                          // again
+            "io" });
+    }
+
+    void
+    testContains()
+    {
+        auto const set = make_set();
+        BOOST_TEST_EQ(set.size(), 8u);
+
+        // the domain and those below it
+        BOOST_TEST(set.contains("example.com"));
+        BOOST_TEST(set.contains("www.example.com"));
+        BOOST_TEST(set.contains("a.b.c.example.com"));
+        BOOST_TEST(set.contains("example.com."));
+        BOOST_TEST(! set.contains("com"));
+        BOOST_TEST(! set.contains("example.net"));
+        BOOST_TEST(! set.contains("xexample.com"));
+        BOOST_TEST(! set.contains("example.co"));
+        BOOST_TEST(! set.contains("example.comm"));
+
+        // a wildcard lists only what is below it
+        BOOST_TEST(! set.contains("wild.org"));
+        BOOST_TEST(set.contains("a.wild.org"));
+        BOOST_TEST(set.contains("a.b.wild.org"));
+
+        // a trailing dot on a domain of the set
+        BOOST_TEST(set.contains("ads.tracker.net"));
+        BOOST_TEST(set.contains("x.ads.tracker.net"));
+        BOOST_TEST(! set.contains("tracker.net"));
+
+        // a top level domain
+        BOOST_TEST(set.contains("anything.io"));
+        BOOST_TEST(set.contains("io"));
+
+        // any form of the host
+        BOOST_TEST(set.contains("WWW.Example.COM"));
+        BOOST_TEST(set.contains("b\xC3\xBC" "cher.de"));
+        BOOST_TEST(set.contains("www.B\xC3\x9C" "CHER.DE"));
+        BOOST_TEST(set.contains("xn--bcher-kva.de"));
+        BOOST_TEST(set.contains("XN--BCHER-KVA.DE"));
+        BOOST_TEST(set.contains("m\xC3\xBCller.de"));
+        BOOST_TEST(set.contains("shop.xn--mller-kva.de"));
+        BOOST_TEST(! set.contains(
+            "b\xEF\xBD\x95" "cher.de"));             // fullwidth u
+        BOOST_TEST(set.contains(
+            "\xEF\xBD\x85xample.com"));             // fullwidth e
+        BOOST_TEST(set.contains(
+            "b\xC3\xBC" "cher\xEF\xBC\x8E" "de"));   // fullwidth dot
+        BOOST_TEST(set.contains(
+            "b\xC3\xBC" "cher\xE3\x80\x82" "de"));   // ideographic
+
+        // hosts without an IDNA
+        BOOST_TEST(! set.contains(""));
+        BOOST_TEST(! set.contains("."));
+        BOOST_TEST(! set.contains("\xFF.example.com"));
+        BOOST_TEST(! set.contains(
+            "\xC2\x80.example.com"));               // prohibited
+        BOOST_TEST(! set.contains(
+            std::string(300, 'a') + ".example.com"));
+        BOOST_TEST(! set.contains(
+            std::string(300, 'A') + ".example.com"));
+
+        // the empty set
+        domain_set const empty;
+        BOOST_TEST_EQ(empty.size(), 0u);
+        BOOST_TEST(empty.image().empty());
+        BOOST_TEST(! empty.contains("example.com"));
+        auto const none = make_set(
+            std::vector<core::string_view>());
+        BOOST_TEST(! none.contains("example.com"));
+        BOOST_TEST(! none.contains(""));
+    }
+
+    void
+    testWide()
+    {
+        // many children of one node, which
+        // share slots and follow each other
+        std::vector<std::string> names;
+        for(int i = 0; i < 20000; ++i)
+            names.push_back(
+                "n" + std::to_string(i) + ".com");
+        std::vector<core::string_view> const v(
+            names.begin(), names.end());
+        auto const set = make_set(v);
+        std::size_t found = 0;
+        for(auto const& s : names)
+            found += set.contains("www." + s);
+        BOOST_TEST_EQ(found, names.size());
+        std::size_t missed = 0;
+        for(int i = 20000; i < 40000; ++i)
+            missed += ! set.contains(
+                "n" + std::to_string(i) + ".com");
+        BOOST_TEST_EQ(missed, 20000u);
+    }
+
+    void
+    testImage()
+    {
+        auto const set = make_set();
+        auto const image = set.image();
+        BOOST_TEST(! image.empty());
+
+        // copies share the image
+        auto const copy = set;
+        BOOST_TEST(copy.image().data() == image.data());
+        BOOST_TEST(copy.contains("www.example.com"));
+
+        // in place, at an aligned address
+        std::vector<std::uint32_t> words(
+            (image.size() + 3) / 4);
+        std::memcpy(words.data(), image.data(), image.size());
+        {
+            auto rv = domain_set::from_image(
+                words.data(), image.size());
+            BOOST_TEST(rv.has_value());
+            BOOST_TEST_EQ(rv->size(), set.size());
+            BOOST_TEST(static_cast<void const*>(
+                rv->image().data()) == words.data());
+            BOOST_TEST(rv->contains("a.wild.org"));
+            BOOST_TEST(rv->contains("b\xC3\xBC" "cher.de"));
+            BOOST_TEST(! rv->contains("wild.org"));
+        }
+
+        // misaligned, short, or damaged
+        std::vector<char> bytes(image.size() + 1);
+        std::memcpy(bytes.data() + 1, image.data(), image.size());
+        BOOST_TEST(domain_set::from_image(
+            bytes.data() + 1, image.size()).has_error());
+        BOOST_TEST(domain_set::from_image(
+            words.data(), image.size() - 1).has_error());
+        BOOST_TEST(domain_set::from_image(
+            words.data(), 8).has_error());
+        BOOST_TEST(domain_set::from_image(
+            words.data(), 0).has_error());
+        words[0] ^= 1;
+        BOOST_TEST(domain_set::from_image(
+            words.data(), image.size()).has_error());
+        words[0] ^= 1;
+        words[3] += 1;
+        BOOST_TEST(domain_set::from_image(
+            words.data(), image.size()).has_error());
+        words[3] -= 1;
+        // a child table past the end
+        words[6 + 2] = 0xffff;
+        BOOST_TEST(domain_set::from_image(
+            words.data(), image.size()).has_error());
+
+        // through a file
+        char const* path = "boost_punycode_domain_set.bin";
+        auto f = std::fopen(path, "wb");
+        BOOST_TEST(f != nullptr);
+        if(f)
+        {
+            std::fwrite(image.data(), 1, image.size(), f);
+            std::fclose(f);
+            auto rv = domain_set::load(path);
+            BOOST_TEST(rv.has_value());
+            if(rv)
+            {
+                BOOST_TEST(rv->image() == image);
+                BOOST_TEST(rv->contains("www.example.com"));
+            }
+            std::remove(path);
+        }
+        BOOST_TEST(domain_set::load(path).has_error());
+    }
+
+    void
+    testInvalid()
+    {
+        auto const fails =
+            [](core::string_view s)
+            {
+                return domain_set::build(&s, 1).has_error();
+            };
+        BOOST_TEST(fails(""));
+        BOOST_TEST(fails("."));
+        BOOST_TEST(fails("*"));
+        BOOST_TEST(fails("*."));
+        BOOST_TEST(fails("a.*.com"));
+        BOOST_TEST(fails("a..com"));
+        BOOST_TEST(fails(".com"));
+        BOOST_TEST(fails("\xFF.com"));
+        BOOST_TEST(fails(std::string(64, 'a') + ".com"));
+        BOOST_TEST(! fails(std::string(63, 'a') + ".com"));
+    }
+
+    // true if a domain of the set, or a wildcard
+    // above the host, is the host or above it
+    static
+    bool
+    reference(
+        std::set<std::string> const& listed,
+        std::set<std::string> const& wild,
+        std::string const& host)
+    {
+        for(std::size_t pos = 0;;)
+        {
+            auto const rest = host.substr(pos);
+            if(listed.count(rest) || (
+                pos > 0 && wild.count(rest)))
+                return true;
+            pos = host.find('.', pos);
+            if(pos == std::string::npos)
+                return false;
+            ++pos;
+        }
+    }
+
+    void
+    testRandom()
+    {
+        // a short last table, whose
+        // home slots reach past it
+        {
+            auto const set = make_set({
+                "a20150.com", "a32432.com", "a39907.com",
+                "a44467.com", "a56065.com", "a57283.com",
+                "a83232.com", "a85800.com", "a90000.com",
+                "a92119.com" });
+            BOOST_TEST(set.contains("a90000.com"));
+            BOOST_TEST(! set.contains("a90001.com"));
+        }
+
+        std::mt19937 rng(1);
+        auto const label =
+            [&rng]
+            {
+                return "a" + std::to_string(rng() % 100000);
+            };
+        auto const name =
+            [&rng, &label]
+            {
+                // few parents, so that the
+                // last tables are wide too
+                std::string s = label();
+                if(rng() % 2)
+                    s += ".b" + std::to_string(rng() % 3);
+                return s + (rng() % 2 ? ".com" : ".net");
+            };
+        std::size_t bad = 0;
+        for(int t = 0; t < 300; ++t)
+        {
+            std::set<std::string> listed;
+            std::set<std::string> wild;
+            std::vector<std::string> names;
+            for(auto n = rng() % 200; n--;)
+            {
+                names.push_back(name());
+                if(rng() % 4 == 0)
+                {
+                    wild.insert(names.back());
+                    names.back() = "*." + names.back();
+                }
+                else
+                {
+                    listed.insert(names.back());
+                }
+            }
+            std::vector<core::string_view> const v(
+                names.begin(), names.end());
+            auto const set = make_set(v);
+            for(int i = 0; i < 200; ++i)
+            {
+                // the names of the set, below
+                // them, above them, and others
+                std::string host;
+                if(names.empty() || rng() % 4 == 0)
+                    host = name();
+                else
+                    host = names[rng() % names.size()];
+                if(host.substr(0, 2) == "*.")
+                    host = host.substr(2);
+                if(rng() % 3 == 0)
+                    host = label() + "." + host;
+                else if(rng() % 3 == 0)
+                    host = host.substr(host.find('.') + 1);
+                bad += set.contains(host) !=
+                    reference(listed, wild, host);
+            }
+        }
+        BOOST_TEST_EQ(bad, 0u);
+    }
+
+    void
+    run()
+    {
+        testContains();
+        testWide();
+        testImage();
+        testInvalid();
+        testRandom();
+    }
+};
+
+TEST_SUITE(
+    domain_set_test,
+    "boost.punycode.domain_set");
+
+} // punycode
+} // boost
@@ -10,8 +10,21 @@
 // Test that header file is self-contained.
 #include <boost/punycode/idna.hpp>
 
+#include <boost/punycode/detail/idna_classify.hpp>
+#include <boost/punycode/idna_hash.hpp>
+#include <boost/punycode/idna_view.hpp>
+#include <boost/punycode/utf8_input.hpp>
+#include <boost/punycode/utf16_output.hpp>
+
+#include <boost/system/system_error.hpp>
+
 #include "test_suite.hpp"
 
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
 namespace boost {
 namespace punycode {
 
@@ -20,6 +33,35 @@ namespace punycode {
 
 struct idna_test
 {
+    // the wire format of an IDNA, or the
+    // empty string when it has none
+    static
+    std::string
+    to_wire(core::string_view idna)
+    {
+        std::string w;
+        if(idna == ".")
+            return std::string(1, '\0');
+        if(! idna.empty() && idna.back() == '.')
+            idna.remove_suffix(1);
+        for(;;)
+        {
+            auto const n = std::min(
+                idna.find('.'), idna.size());
+            if(n == 0 || n > 63)
+                return {};
+            w.push_back(static_cast<char>(n));
+            w.append(idna.data(), n);
+            if(n == idna.size())
+                break;
+            idna.remove_prefix(n + 1);
+        }
+        w.push_back('\0');
+        if(w.size() > 255)
+            return {};
+        return w;
+    }
+
     void
     check(
         core::string_view domain,
@@ -28,6 +70,580 @@ struct idna_test
         auto rv = utf8_to_idna(domain);
         if( BOOST_TEST(! rv.has_error()))
             BOOST_TEST_EQ(rv.value(), ascii);
+
+        // borrowed, when nothing changes
+        std::string storage;
+        auto const rb =
+            utf8_to_idna_borrowed(domain, storage);
+        if( BOOST_TEST(! rb.has_error()))
+            BOOST_TEST_EQ(*rb, ascii);
+
+        // lazily
+        idna_view const v(domain);
+        BOOST_TEST_EQ(std::string(
+            v.begin(), v.end()), ascii);
+
+        // the same domain as utf16
+        std::u16string u(domain.size(), u'\0');
+        auto const end = std::copy(
+            utf8_input(domain.data(),
+                domain.data() + domain.size()),
+            utf8_input(domain.data() + domain.size()),
+            utf16_output(&u[0], &u[0] + u.size()));
+        u.resize(end.base() - &u[0]);
+        rv = utf16_to_idna(u);
+        if( BOOST_TEST(! rv.has_error()))
+            BOOST_TEST_EQ(rv.value(), ascii);
+
+        // in wire format, when it has one
+        char buf[255];
+        auto const rw = utf8_to_dns_wire(
+            domain, buf, sizeof(buf));
+        auto const w = to_wire(ascii);
+        if(w.empty())
+            BOOST_TEST(rw.has_error());
+        else if( BOOST_TEST(rw.has_value()))
+            BOOST_TEST_EQ(
+                std::string(buf, *rw), w);
+    }
+
+    void
+    testView()
+    {
+        auto const same = [](core::string_view s)
+        {
+            idna_view const v(s);
+            auto const rv = utf8_to_idna(s);
+            return rv.has_value() &&
+                std::string(v.begin(), v.end()) == *rv;
+        };
+        BOOST_TEST(same(""));
+        BOOST_TEST(same("."));
+        BOOST_TEST(same(".."));
+        BOOST_TEST(same("a..b."));
+        BOOST_TEST(same(".B\xC3\xBC" "cher."));
+        BOOST_TEST(same("\xC2\xAD.x"));      // mapped to nothing
+        BOOST_TEST(same("\xC2\xAD"));
+        BOOST_TEST(same("WWW.B\xC3\x9C" "CHER.DE"));
+
+        // a forward range
+        idna_view const v("b\xC3\xBC" "cher.de");
+        auto it = v.begin();
+        auto const it0 = it++;
+        BOOST_TEST_EQ(*it0, 'x');
+        BOOST_TEST_EQ(*it, 'n');
+        BOOST_TEST_EQ(std::distance(v.begin(), v.end()),
+            std::ptrdiff_t(sizeof("xn--bcher-kva.de") - 1));
+        BOOST_TEST(std::equal(v.begin(), v.end(),
+            "xn--bcher-kva.de"));
+
+        // a label must fit in DNS
+        std::string s(63, 'a');
+        BOOST_TEST(same(s));
+        s.push_back('a');
+        BOOST_TEST_THROWS(std::string(
+            idna_view(s).begin(), idna_view(s).end()),
+            system::system_error);
+        BOOST_TEST_THROWS(idna_view("\xC0\x80").begin(),
+            system::system_error);
+    }
+
+    void
+    testNormalize()
+    {
+        // composed and decomposed are the same host
+        check("b\xC3\xBC" "cher", "xn--bcher-kva");
+        check("bu\xCC\x88" "cher", "xn--bcher-kva");
+        check("BU\xCC\x88" "CHER", "xn--bcher-kva");
+        check("A\xCC\x8A", "xn--5ca");
+
+        // marks in any order
+        check("a\xCC\xA3\xCC\x81", "xn--lsa752l");
+        check("a\xCC\x81\xCC\xA3", "xn--lsa752l");
+
+        // compatibility forms
+        check("\xEF\xBD\x85\xEF\xBD\x98\xEF\xBD\x81"
+            "\xEF\xBD\x8D\xEF\xBD\x90\xEF\xBD\x8C"
+            "\xEF\xBD\x85.com", "example.com");
+        check("\xEF\xAC\x81.com", "fi.com");
+        check("\xE2\x85\xAB", "xii");
+        check("\xE3\x8D\xB1", "hpa");
+        check("\xC2\xBD", "xn--12-c6t");
+        check("\xC7\x86", "xn--d-toa");
+
+        // Hangul, by arithmetic
+        check("\xEA\xB0\x80", "xn--o39a");
+        check("\xE1\x84\x80\xE1\x85\xA1", "xn--o39a");
+        check("\xEA\xB0\x80\xE1\x86\xA8", "xn--p39a");
+        check("\xE1\x84\x80\xEA\xB0\x81", "xn--ypd6740f");
+
+        // a run of marks longer than a segment
+        std::string s = "a";
+        for(int i = 0; i < 40; ++i)
+            s += "\xCC\x81";
+        check(s, "xn--1ca20iaaaaaaaaaaaaa"
+            "aaaaaaaaaaaaaaaaaaaaaaaaa");
+    }
+
+    void
+    testProhibited()
+    {
+        auto const prohibited = [](core::string_view s)
+        {
+            auto const rv = utf8_to_idna(s);
+            return rv.has_error() &&
+                rv.error() == system::errc::invalid_argument;
+        };
+        BOOST_TEST(prohibited("a\xC2\x80"));              // C.2.2
+        BOOST_TEST(prohibited("a\xE1\x9A\x80" "b"));      // C.1.2
+        BOOST_TEST(prohibited("\xEE\x80\x80.com"));       // C.3
+        BOOST_TEST(prohibited("\xEF\xBF\xBF"));           // C.4
+        BOOST_TEST(prohibited("\xEF\xBF\xBD"));           // C.6
+        BOOST_TEST(prohibited("\xE2\xBF\xB0"));           // C.7
+        BOOST_TEST(prohibited("\xE2\x80\x8E" "a"));       // C.8
+        BOOST_TEST(prohibited("a.\xF3\xA0\x80\x81"));    // C.9
+
+        // prohibited after mapping, not before
+        check("a\xC2\xA0" "b", "a b");
+        check("a\xCD\x80", "xn--0ca");
+        check("a\xE2\x80\x8B" "b", "ab");
+
+        // as utf16, and lazily
+        BOOST_TEST(utf16_to_idna(u"a\u0080").error() ==
+            system::errc::invalid_argument);
+        BOOST_TEST_THROWS(std::string(
+            idna_view("a\xC2\x80").begin(),
+            idna_view("a\xC2\x80").end()),
+            system::system_error);
+        BOOST_TEST(! idna_equivalent("a\xC2\x80", "A\xC2\x80"));
+        BOOST_TEST(idna_equivalent("a\xC2\x80", "a\xC2\x80"));
+
+        // the offset of the input code point
+        auto rv = nameprep_find_prohibited("example.com");
+        BOOST_TEST_EQ(*rv, 11u);
+        rv = nameprep_find_prohibited("b\xC3\xBC.\xE1\x9A\x80");
+        BOOST_TEST_EQ(*rv, 4u);
+        rv = nameprep_find_prohibited("\xC2\xA0\xC2\x80");
+        BOOST_TEST_EQ(*rv, 2u);
+        rv = nameprep_find_prohibited("a\xFF");
+        BOOST_TEST(rv.error() ==
+            system::errc::illegal_byte_sequence);
+
+        // unassigned in Unicode 3.2
+        rv = nameprep_find_prohibited("a\xF0\x9F\x98\x80");
+        BOOST_TEST_EQ(*rv, 5u);
+        rv = nameprep_find_prohibited("a\xF0\x9F\x98\x80", false);
+        BOOST_TEST_EQ(*rv, 1u);
+        rv = nameprep_find_prohibited("b\xC3\xBC" "cher", false);
+        BOOST_TEST_EQ(*rv, 7u);
+
+        // the offset from the conversion itself
+        auto const convert =
+            [](core::string_view s, bool allow)
+            {
+                idna_options opt;
+                opt.allow_unassigned = allow;
+                std::size_t offset = 0;
+                auto const rv = utf8_to_idna(s, opt, offset);
+                if(rv.has_error())
+                    BOOST_TEST(rv.error() ==
+                        system::errc::invalid_argument);
+                return offset;
+            };
+        std::string const longer =
+            "\xC3\xBC" + std::string(300, 'a');
+        core::string_view const domains[] = {
+            "example.com",
+            "b\xC3\xBC.\xE1\x9A\x80",
+            "\xC2\xA0\xC2\x80",
+            "a\xC2\xAD\xC2\x80",
+            "a\xF0\x9F\x98\x80",
+            "a\xF0\x9F\x98\x80\xC2\x80",
+            "\xC3\x9F\xEF\xBC\x8E\xF0\x9F\x98\x80",
+            "\xD7\x90" "a\xD7\x91",
+            longer };
+        for(auto const s : domains)
+        {
+            BOOST_TEST_EQ(convert(s, true),
+                *nameprep_find_prohibited(s));
+            BOOST_TEST_EQ(convert(s, false),
+                *nameprep_find_prohibited(s, false));
+        }
+        BOOST_TEST_EQ(convert(
+            longer + "\xE1\x9A\x80", true), 302u);
+        BOOST_TEST_EQ(convert(
+            longer + "\xF0\x9F\x98\x80", false), 302u);
+        {
+            idna_options opt;
+            opt.allow_unassigned = false;
+            std::size_t offset = 0;
+            auto const rv = utf8_to_idna(
+                "b\xC3\xBC" "cher.de", opt, offset);
+            BOOST_TEST(rv.has_value());
+            BOOST_TEST_EQ(*rv, "xn--bcher-kva.de");
+            BOOST_TEST_EQ(offset, 10u);
+            BOOST_TEST(utf8_to_idna("a\xF0\x9F\x98\x80",
+                opt, offset).has_error());
+            BOOST_TEST(utf8_to_idna("a\xFF",
+                opt, offset).error() ==
+                    system::errc::illegal_byte_sequence);
+            BOOST_TEST_EQ(offset, 2u);
+        }
+    }
+
+    void
+    testBidi()
+    {
+        auto const fails = [](core::string_view s)
+        {
+            auto const rv = utf8_to_idna(s);
+            return rv.has_error() &&
+                rv.error() == system::errc::invalid_argument;
+        };
+
+        // right-to-left labels
+        check("\xD7\xA9\xD7\x9C\xD7\x95\xD7\x9D.com",
+            "xn--9dbne9b.com");
+        check("\xD7\x90\xD7\x91" "1", "xn--1-zhcd");
+        check("\xD7\x90\xD7\x91\xD6\xB0", "xn--7cb7dd");
+        check("\xD8\xB9\xD8\xB1\xD8\xA8\xD9\x8A\xD9\xA2",
+            "xn--ngbrx4ezf");
+
+        BOOST_TEST(fails("\xD7\x90" "a\xD7\x91"));           // 2
+        BOOST_TEST(fails("\xD7\x90\xD7\x91-"));              // 3
+        BOOST_TEST(fails("\xD7\x90" "1\xD9\xA2"));           // 4
+        BOOST_TEST(fails("\xD7\x90 \xD7\x91"));              // 2
+
+        // the left-to-right labels of a domain only
+        // follow the rule if it has an RTL label
+        check("1a.com", "1a.com");
+        check("a-.b\xC3\xBC", "a-.xn--b-eha");
+        BOOST_TEST(fails("1a.\xD7\x90\xD7\x91"));            // 1
+        BOOST_TEST(fails("a-.\xD7\x90\xD7\x91"));            // 6
+        BOOST_TEST(fails("a-.\xD9\xA2"));                      // 1, 6
+        BOOST_TEST(fails("\xD7\x90\xD7\x91.a-"));
+
+        // expanding by NFKC, to spaces
+        BOOST_TEST(fails("\xEF\xB7\xBA"));
+
+        std::u16string const u = u"1a.\u05D0\u05D1";
+        BOOST_TEST(utf16_to_idna(u).has_error());
+
+        // the labels before are produced first
+        idna_view const v("\xD7\x90.1a");
+        auto it = v.begin();
+        BOOST_TEST_EQ(*it, 'x');
+        BOOST_TEST_THROWS(std::string(it, v.end()),
+            system::system_error);
+
+        BOOST_TEST(idna_equivalent(
+            "\xD7\xA9\xD7\x9C\xD7\x95\xD7\x9D.COM",
+            "xn--9dbne9b.com"));
+        BOOST_TEST(! idna_equivalent(
+            "1a.\xD7\x90\xD7\x91", "1A.\xD7\x90\xD7\x91"));
+        BOOST_TEST(! idna_equivalent(
+            "\xD7\x90\xD7\x91.1a", "\xD7\x90\xD7\x91.1A"));
+    }
+
+    void
+    testUtf16()
+    {
+        // longer than the stack buffer
+        std::u16string s(300, u'a');
+        s += u".b\u00fccher\U0001F600";
+        auto rv = utf16_to_idna(s);
+        if(BOOST_TEST(rv.has_value()))
+            BOOST_TEST_EQ(*rv, std::string(300, 'a') +
+                ".xn--bcher-kva83980g");
+
+        // unpaired surrogates, short and long
+        for(auto n : { 1, 300 })
+        {
+            std::u16string t(n, u'a');
+            t += u'\xD800';
+            rv = utf16_to_idna(t);
+            if(BOOST_TEST(rv.has_error()))
+                BOOST_TEST(rv.error() ==
+                    system::errc::illegal_byte_sequence);
+            t.back() = u'\xDC00';
+            t += u"b";
+            rv = utf16_to_idna(t);
+            BOOST_TEST(rv.has_error());
+        }
+    }
+
+    void
+    testEquivalent()
+    {
+        // agrees with comparing the IDNAs
+        char const* const v[] = {
+            "",
+            ".",
+            "a",
+            "A",
+            "a.",
+            "example.com",
+            "EXAMPLE.com",
+            "example.co",
+            "b\xC3\xBC" "cher.de",
+            "B\xC3\x9C" "CHER.de",
+            "xn--bcher-kva.de",
+            "XN--BCHER-KVA.DE",
+            "xn--bcher-kvb.de",
+            "xn--.de",
+            "bucher.de",
+            "\xC2\xAD" "b\xC3\xBC" "cher.de",
+            "stra\xC3\x9F" "e.de",
+            "strasse.de",
+            "xn--strae-oqa.de",
+            "\xC2\xAD",
+            "\xC2\xAD.\xC2\xAD",
+            "\xD0\xA0\xD0\xBE\xD1\x81.ru",
+            "xn--h1ag4d.ru",
+            "\xE2\x98\x83.com",
+            "xn--n3h.com",
+            "xn--N3H.com",
+            "b\xC3\xBC" "cher\xEF\xBC\x8E" "de",      // fullwidth dot
+            "b\xC3\xBC" "cher\xE3\x80\x82" "de",      // ideographic
+            "xn--bcher-kva\xEF\xBD\xA1" "de",        // halfwidth
+            "example\xEF\xBC\x8E" "com",
+            "\xC3\xBC\xEF\xBC\x8E" "b",
+            "\xC3\xBC.b",
+            "xn--tda.b",
+            "\xC3\xBC\xEF\xBC\x8E",
+            "\xC3\xBC.",
+            "\xE2\x92\x88" "com",                   // 1.com
+            "1.com" };
+        for(auto a : v)
+        {
+            for(auto b : v)
+            {
+                auto const ra = utf8_to_idna(a);
+                auto const rb = utf8_to_idna(b);
+                BOOST_TEST_EQ(idna_equivalent(a, b),
+                    *ra == *rb);
+            }
+        }
+
+        // labels longer than DNS allows,
+        // which only match themselves
+        std::string const big(64, 'a');
+        BOOST_TEST(idna_equivalent(big, big));
+        BOOST_TEST(! idna_equivalent(big,
+            std::string(64, 'A')));
+        BOOST_TEST(idna_equivalent(
+            std::string(63, 'a'),
+            std::string(63, 'A')));
+        std::string u;
+        for(int i = 0; i < 70; ++i)
+            u += "\xC3\xBC";
+        BOOST_TEST(! idna_equivalent(u, "\xC3\x9C" + u.substr(2)));
+        BOOST_TEST(! idna_equivalent(u,
+            *utf8_to_idna(u)));
+
+        // not utf8
+        BOOST_TEST(idna_equivalent("a\xFF", "a\xFF"));
+        BOOST_TEST(! idna_equivalent("A\xFF", "a\xFF"));
+        BOOST_TEST(! idna_equivalent("xn--", "\xC0\x80"));
+    }
+
+    void
+    testBorrowed()
+    {
+        std::string storage = "unchanged";
+
+        // already an IDNA
+        core::string_view s = "www.example.com";
+        auto rv = utf8_to_idna_borrowed(s, storage);
+        if(BOOST_TEST(rv.has_value()))
+        {
+            BOOST_TEST_EQ(rv->data(), s.data());
+            BOOST_TEST_EQ(rv->size(), s.size());
+        }
+        BOOST_TEST_EQ(storage, "unchanged");
+        rv = utf8_to_idna_borrowed("", storage);
+        if(BOOST_TEST(rv.has_value()))
+            BOOST_TEST(rv->empty());
+
+        // an existing ACE domain is its own IDNA
+        s = "xn--bcher-kva.de";
+        rv = utf8_to_idna_borrowed(s, storage);
+        if(BOOST_TEST(rv.has_value()))
+            BOOST_TEST_EQ(rv->data(), s.data());
+
+        // converted into storage
+        s = "WWW.B\xC3\xBC" "cher.de";
+        rv = utf8_to_idna_borrowed(s, storage);
+        if(BOOST_TEST(rv.has_value()))
+        {
+            BOOST_TEST_EQ(*rv, "www.xn--bcher-kva.de");
+            BOOST_TEST_EQ(rv->data(), storage.data());
+        }
+        s = "Example.com";
+        rv = utf8_to_idna_borrowed(s, storage);
+        if(BOOST_TEST(rv.has_value()))
+        {
+            BOOST_TEST_EQ(*rv, "example.com");
+            BOOST_TEST_EQ(rv->data(), storage.data());
+        }
+
+        // errors
+        rv = utf8_to_idna_borrowed("a\xFF", storage);
+        if(BOOST_TEST(rv.has_error()))
+            BOOST_TEST(rv.error() ==
+                system::errc::illegal_byte_sequence);
+    }
+
+    // straightforward classification, for reference
+    static
+    unsigned
+    classify(core::string_view s)
+    {
+        unsigned f = 0;
+        if(s.empty())
+            f |= has_invalid_ldh;
+        for(char c : s)
+        {
+            unsigned char const u = c;
+            if(u >= 0x80)
+                f |= has_non_ascii;
+            else if(u >= 'A' && u <= 'Z')
+                f |= has_upper;
+            else if(! (
+                (u >= 'a' && u <= 'z') ||
+                (u >= '0' && u <= '9') ||
+                u == '-' || u == '.'))
+                f |= has_invalid_ldh;
+        }
+        std::vector<std::string> labels(1);
+        for(char c : s)
+        {
+            if(c == '.')
+                labels.emplace_back();
+            else
+                labels.back().push_back(c);
+        }
+        for(std::size_t i = 0; i < labels.size(); ++i)
+        {
+            auto const& l = labels[i];
+            if(l.empty())
+            {
+                if( i + 1 < labels.size() ||
+                    labels.size() == 1)
+                    f |= has_invalid_ldh;
+                continue;
+            }
+            if( l.size() > 63 ||
+                l.front() == '-' ||
+                l.back() == '-')
+                f |= has_invalid_ldh;
+            if( l.size() >= 4 &&
+                (l[0] | 0x20) == 'x' &&
+                (l[1] | 0x20) == 'n' &&
+                l[2] == '-' && l[3] == '-')
+                f |= has_xn_label;
+        }
+        return f;
+    }
+
+    // true if every kernel agrees with the reference
+    static
+    bool
+    classifies(core::string_view s)
+    {
+        using level = detail::simd_level;
+        auto const f = classify(s);
+        for(auto lv : {
+            level::none, level::sse4,
+            level::avx2, level::avx512 })
+            if(detail::idna_classify(s, lv) != f)
+                return false;
+        return idna_classify(s) == f;
+    }
+
+    void
+    testClassify()
+    {
+        BOOST_TEST_EQ(idna_classify("example.com"), 0u);
+        BOOST_TEST_EQ(idna_classify("example.com."), 0u);
+        BOOST_TEST_EQ(idna_classify("a-b.c0"), 0u);
+        BOOST_TEST_EQ(idna_classify("Example.com"),
+            unsigned(has_upper));
+        BOOST_TEST_EQ(idna_classify("b\xC3\xBC" "cher.de"),
+            unsigned(has_non_ascii));
+        BOOST_TEST_EQ(idna_classify("xn--bcher-kva.de"),
+            unsigned(has_xn_label));
+        BOOST_TEST_EQ(idna_classify("www.XN--bcher-kva.de"),
+            has_xn_label | has_upper);
+        BOOST_TEST_EQ(idna_classify("axn--b.de"), 0u);
+        BOOST_TEST_EQ(idna_classify("a_b.de"),
+            unsigned(has_invalid_ldh));
+        BOOST_TEST_EQ(idna_classify("-a.de"),
+            unsigned(has_invalid_ldh));
+        BOOST_TEST_EQ(idna_classify("a-.de"),
+            unsigned(has_invalid_ldh));
+        BOOST_TEST_EQ(idna_classify("a..de"),
+            unsigned(has_invalid_ldh));
+        BOOST_TEST_EQ(idna_classify(""),
+            unsigned(has_invalid_ldh));
+        BOOST_TEST_EQ(idna_classify("."),
+            unsigned(has_invalid_ldh));
+        BOOST_TEST_EQ(idna_classify(
+            std::string(63, 'a') + ".com"), 0u);
+        BOOST_TEST_EQ(idna_classify(
+            std::string(64, 'a') + ".com"),
+            unsigned(has_invalid_ldh));
+        BOOST_TEST_EQ(idna_classify(
+            "com." + std::string(64, 'a')),
+            unsigned(has_invalid_ldh));
+
+        // patterns at every offset, which
+        // puts them across block boundaries
+        for(std::size_t i = 0; i < 140; ++i)
+        {
+            for(auto t : {
+                ".xn--a", ".XN--a", "-.a", ".-a",
+                "..a", "a.", "A", "\xC3\xBC", "_",
+                ".xn-", "xn--" })
+            {
+                std::string s(i, 'a');
+                s += t;
+                if(! BOOST_TEST(classifies(s)))
+                    return;
+                if(! BOOST_TEST(classifies(s + "b")))
+                    return;
+                if(i > 0)
+                    s[i / 2] = '.';
+                if(! BOOST_TEST(classifies(s)))
+                    return;
+            }
+        }
+
+        // labels of every length
+        for(std::size_t i = 0; i < 140; ++i)
+        {
+            std::string s(i, 'a');
+            BOOST_TEST(classifies(s));
+            BOOST_TEST(classifies("b." + s));
+            BOOST_TEST(classifies("b." + s + ".c"));
+            BOOST_TEST(classifies(
+                std::string(62, 'c') + "." + s));
+        }
+
+        // random strings over the octets
+        // which matter
+        std::mt19937 rng(7);
+        char const alphabet[] =
+            "aaazAZ09xXnN--..._\xC3\xBC";
+        for(int k = 0; k < 20000; ++k)
+        {
+            std::string s(rng() % 200, 'a');
+            for(auto& c : s)
+                c = alphabet[rng() %
+                    (sizeof(alphabet) - 1)];
+            if(! BOOST_TEST(classifies(s)))
+                break;
+        }
     }
 
     void
@@ -149,12 +765,285 @@ check(
     "xn--b1abfaaepdrnnbgefbadotcwatmq2g4l");
     }
 
+    void
+    testSkeleton()
+    {
+        auto const same = [](
+            core::string_view a,
+            core::string_view b)
+        {
+            auto const ra = skeleton(a);
+            auto const rb = skeleton(b);
+            return
+                ra.has_value() && rb.has_value() &&
+                *ra == *rb &&
+                skeleton_hash(a) == skeleton_hash(b);
+        };
+
+        // Cyrillic, which looks like Latin
+        auto const cyrillic =
+            "\xD1\x80\xD0\xB0\xD1\x83\xD1\x80\xD0\xB0l.com";
+        auto rv = skeleton(cyrillic);
+        if(BOOST_TEST(rv.has_value()))
+            BOOST_TEST_EQ(*rv, "paypal.corn");
+        BOOST_TEST(same(cyrillic, "paypal.com"));
+        BOOST_TEST(same(cyrillic, "xn--l-7sba6dbr.com"));
+        BOOST_TEST(same(cyrillic, "XN--L-7SBA6DBR.COM"));
+        BOOST_TEST(same("PayPal.com", "paypal.com"));
+        BOOST_TEST(same(                                // fullwidth
+            "\xEF\xBC\xB0\xEF\xBC\xA1\xEF\xBC\xB9"
+            "\xEF\xBC\xB0\xEF\xBC\xA1\xEF\xBC\xAC.com",
+            "paypal.com"));
+        BOOST_TEST(same("goog1e.com", "google.com"));
+        BOOST_TEST(same("\xC2\xAD" "a.b", "a.b"));     // mapped to nothing
+        BOOST_TEST(! same("example.com", "google.com"));
+        BOOST_TEST(! same("b\xC3\xBC" "cher.de", "bucher.de"));
+
+        // marks are put in canonical order before
+        // and after mapping: U+0327 is ordered before
+        // the U+0323 of U+1E43, then becomes U+0326
+        rv = skeleton("\xE1\xB9\x83\xCC\xA7");
+        if(BOOST_TEST(rv.has_value()))
+            BOOST_TEST_EQ(*rv, "rn\xCC\xA6\xCC\xA3");
+
+        rv = skeleton("");
+        if(BOOST_TEST(rv.has_value()))
+            BOOST_TEST(rv->empty());
+
+        // storage is reused
+        std::string storage;
+        storage.reserve(64);
+        auto const p = storage.data();
+        rv = skeleton("example.com", std::move(storage));
+        if(BOOST_TEST(rv.has_value()))
+        {
+            BOOST_TEST_EQ(*rv, "exarnple.corn");
+            BOOST_TEST(rv->data() == p);
+        }
+
+        rv = skeleton("a\xFF");
+        if(BOOST_TEST(rv.has_error()))
+            BOOST_TEST(rv.error() ==
+                system::errc::illegal_byte_sequence);
+        for(auto s : {
+            "xn--.com",
+            "xn--zz.com",
+            "a.\xEE\x80\x80" })                        // private use
+        {
+            rv = skeleton(s);
+            if(BOOST_TEST(rv.has_error()))
+                BOOST_TEST(rv.error() ==
+                    system::errc::invalid_argument);
+        }
+
+        // the hash is that of the skeleton, or of
+        // the octets of a domain without one
+        auto const fnv = [](core::string_view s)
+        {
+            detail::fnv1a f;
+            for(char c : s)
+                f(c);
+            return f.h;
+        };
+        BOOST_TEST_EQ(skeleton_hash(cyrillic),
+            fnv("paypal.corn"));
+        BOOST_TEST_EQ(skeleton_hash("xn--.com"),
+            fnv("xn--.com"));
+        BOOST_TEST_EQ(skeleton_hash("a\xFF"),
+            fnv("a\xFF"));
+
+        core::string_view const v[] = {
+            cyrillic, "example.com", "a\xFF", "" };
+        std::uint64_t h[4] = {};
+        skeleton_hash(v, 4, h);
+        for(std::size_t i = 0; i < 4; ++i)
+            BOOST_TEST_EQ(h[i], skeleton_hash(v[i]));
+    }
+
+    void
+    testDots()
+    {
+        // labels are split after nameprep, which
+        // maps these to '.' and U+3002, and RFC 3490
+        // takes U+3002 as a dot
+        check("a\xEF\xBC\x8E" "b", "a.b");
+        check("\xC3\xBC\xEF\xBC\x8E" "b", "xn--tda.b");
+        check("\xC3\xBC\xE3\x80\x82" "b", "xn--tda.b");
+        check("\xC3\xBC\xEF\xBD\xA1" "b", "xn--tda.b");
+        check("a\xE3\x80\x82", "a.");
+        check("\xE3\x80\x82\xC3\xBC", ".xn--tda");
+        check("\xE2\x92\x88\xC3\xBC", "1.xn--tda");
+        check("b\xC3\xBC" "cher\xE3\x80\x82" "de\xEF\xBC\x8E",
+            "xn--bcher-kva.de.");
+
+        std::vector<label_info> labels;
+        BOOST_TEST(utf8_to_idna(
+            "\xC3\xBC\xE3\x80\x82" "b", labels).has_value());
+        BOOST_TEST_EQ(labels.size(), 2u);
+
+        BOOST_TEST(idna_equivalent("a\xEF\xBC\x8E" "b", "a.b"));
+        BOOST_TEST(idna_equivalent(
+            "\xC3\xBC\xEF\xBC\x8E" "b", "\xC3\xBC.b"));
+        BOOST_TEST(idna_equivalent(
+            "xn--tda.b", "\xC3\xBC\xEF\xBC\x8E" "b"));
+        BOOST_TEST(idna_equivalent(
+            "xn--tda.b", "\xC3\xBC\xE3\x80\x82" "b"));
+        BOOST_TEST(! idna_equivalent(
+            "\xC3\xBC\xEF\xBC\x8E" "b", "\xC3\xBC" "b"));
+        BOOST_TEST(! idna_equivalent(
+            "\xC3\xBC\xEF\xBC\x8E\xC2\x80", "\xC3\xBC."));
+
+        BOOST_TEST(idna_equal()(
+            "\xC3\xBC\xEF\xBC\x8E" "b", "xn--tda.b"));
+        BOOST_TEST_EQ(
+            idna_hash()("\xC3\xBC\xEF\xBC\x8E" "b"),
+            idna_hash()("xn--tda.b"));
+
+        // a label after a mapped dot
+        // may be an ACE label
+        BOOST_TEST_EQ(
+            skeleton("\xC3\xBC\xEF\xBC\x8E" "b").value(),
+            skeleton("\xC3\xBC.b").value());
+        BOOST_TEST_EQ(
+            skeleton("\xC3\xBC\xE3\x80\x82xn--tda").value(),
+            skeleton("\xC3\xBC.\xC3\xBC").value());
+        BOOST_TEST_EQ(
+            skeleton("\xEF\xBD\x98\xEF\xBD\x8E--tda.b").value(),
+            skeleton("\xC3\xBC.b").value());
+        BOOST_TEST(skeleton(
+            "\xC3\xBC\xEF\xBC\x8E" "xn--" +
+            std::string(70, 'a')).has_error());
+        BOOST_TEST(skeleton(
+            "\xC3\xBC\xEF\xBC\x8E" "xn--").has_error());
+
+        // a prohibited code point after a dot
+        idna_view const v("a.\xC2\x80");
+        BOOST_TEST_THROWS(std::string(v.begin(), v.end()),
+            system::system_error);
+    }
+
+    void
+    testDnsWire()
+    {
+        char buf[255];
+        auto const wire = [&buf](core::string_view s)
+        {
+            auto const rv = utf8_to_dns_wire(
+                s, buf, sizeof(buf));
+            if(rv.has_error())
+                return std::string("error");
+            return std::string(buf, *rv);
+        };
+        auto const fails = [&buf](
+            core::string_view s, system::errc::errc_t ev)
+        {
+            auto const rv = utf8_to_dns_wire(
+                s, buf, sizeof(buf));
+            return rv.has_error() && rv.error() == ev;
+        };
+        using namespace std::string_literals;
+
+        BOOST_TEST_EQ(wire("www.b\xC3\xBC" "cher.de"),
+            "\x03www\x0dxn--bcher-kva\x02" "de\0"s);
+        BOOST_TEST_EQ(wire("WWW.Example.COM."),
+            "\x03www\x07" "example\x03" "com\0"s);
+        BOOST_TEST_EQ(wire("_dmarc.example.com"),
+            "\x06_dmarc\x07" "example\x03" "com\0"s);
+        BOOST_TEST_EQ(wire("\xC3\xBC."),
+            "\x07xn--tda\0"s);
+        BOOST_TEST_EQ(wire("."), "\0"s);
+        BOOST_TEST_EQ(wire("\xEF\xBC\x8E"), "\0"s);
+        BOOST_TEST_EQ(wire("\xEF\xBD\x81\xEF\xBC\x8E" "b"),
+            "\x01" "a\x01" "b\0"s);                   // fullwidth
+        BOOST_TEST_EQ(wire("a\xC2\xAD" "b.com"),
+            "\x02" "ab\x03" "com\0"s);                // soft hyphen
+
+        // empty labels
+        auto const invalid = system::errc::invalid_argument;
+        BOOST_TEST(fails("", invalid));
+        BOOST_TEST(fails("..", invalid));
+        BOOST_TEST(fails(".com", invalid));
+        BOOST_TEST(fails("a..com", invalid));
+        BOOST_TEST(fails("\xC3\xBC..com", invalid));
+        BOOST_TEST(fails("\xC2\xAD.com", invalid));
+        BOOST_TEST(fails("\xEF\xBC\x8E" "a", invalid));
+
+        // no IDNA
+        BOOST_TEST(fails("\xFF.com",
+            system::errc::illegal_byte_sequence));
+        BOOST_TEST(fails("a\xC2\x80.com", invalid));
+        BOOST_TEST(fails("a.\xC2\x80", invalid));
+        BOOST_TEST(fails("\xD7\x90" "a\xD7\x91", invalid));
+        BOOST_TEST(fails("1a.\xD7\x90\xD7\x91", invalid));
+
+        // labels of at most 63 octets
+        auto const too_large = system::errc::value_too_large;
+        std::string const l63(63, 'a');
+        BOOST_TEST_EQ(wire(l63).size(), 65u);
+        BOOST_TEST(fails(l63 + "a", too_large));
+        BOOST_TEST(fails(l63 + "A.com", too_large));
+        for(std::size_t n = 50; n < 64; ++n)
+        {
+            auto const s = std::string(n, 'a') + "\xC3\xBC";
+            auto const idna = utf8_to_idna(s).value();
+            if(idna.size() <= 63)
+                BOOST_TEST_EQ(wire(s).size(), idna.size() + 2);
+            else
+                BOOST_TEST(fails(s, too_large));
+        }
+        BOOST_TEST(fails(std::string(64, 'a') +
+            "\xC3\xBC", too_large));
+
+        // names of at most 255 octets
+        std::string name;
+        for(int i = 0; i < 3; ++i)
+            name += l63 + ".";
+        name += std::string(61, 'a');
+        BOOST_TEST_EQ(name.size(), 253u);
+        BOOST_TEST_EQ(wire(name).size(), 255u);
+        BOOST_TEST_EQ(wire(name + ".").size(), 255u);
+        BOOST_TEST(fails(name + "a", too_large));
+        BOOST_TEST(fails(name + "\xC3\xBC", too_large));
+        BOOST_TEST(fails(name + ".a", too_large));
+        std::string big;
+        for(int i = 0; i < 40; ++i)
+            big += "\xC3\xBC.";
+        BOOST_TEST(fails(big, too_large));
+
+        // the buffer
+        auto rv = utf8_to_dns_wire("b\xC3\xBC" "cher.de", buf, 18);
+        if(BOOST_TEST(rv.has_value()))
+            BOOST_TEST_EQ(*rv, 18u);
+        rv = utf8_to_dns_wire("b\xC3\xBC" "cher.de", buf, 17);
+        BOOST_TEST(rv.error() == system::errc::no_buffer_space);
+        rv = utf8_to_dns_wire("www.example.com", buf, 17);
+        if(BOOST_TEST(rv.has_value()))
+            BOOST_TEST_EQ(*rv, 17u);
+        rv = utf8_to_dns_wire("www.example.com", buf, 16);
+        BOOST_TEST(rv.error() == system::errc::no_buffer_space);
+        rv = utf8_to_dns_wire(".", nullptr, 0);
+        BOOST_TEST(rv.error() == system::errc::no_buffer_space);
+        rv = utf8_to_dns_wire("\xC3\xBC", nullptr, 0);
+        BOOST_TEST(rv.error() == system::errc::no_buffer_space);
+    }
+
     void
     run()
     {
         check("boost.org", "boost.org");
         check("Boost.org", "boost.org");
         testEncode();
+        testNormalize();
+        testProhibited();
+        testBidi();
+        testUtf16();
+        testView();
+        testEquivalent();
+        testClassify();
+        testBorrowed();
+        testSkeleton();
+        testDots();
+        testDnsWire();
     }
 };
 
@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+// Test that header file is self-contained.
+#include <boost/punycode/idna_hash.hpp>
+
+#include <boost/punycode/idna.hpp>
+
+#include "test_suite.hpp"
+
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+
+namespace boost {
+namespace punycode {
+
+struct idna_hash_test
+{
+    static
+    bool
+    same(
+        core::string_view a,
+        core::string_view b)
+    {
+        return
+            idna_equal()(a, b) &&
+            idna_equal()(b, a) &&
+            idna_hash()(a) == idna_hash()(b);
+    }
+
+    void
+    testEquivalent()
+    {
+        BOOST_TEST(same(
+            "B\xC3\xBC" "cher.de", "b\xC3\xBC" "cher.de"));
+        BOOST_TEST(same(
+            "B\xC3\xBC" "cher.de", "xn--bcher-kva.de"));
+        BOOST_TEST(same(
+            "b\xC3\xBC" "cher.DE", "XN--BCHER-KVA.de"));
+        BOOST_TEST(same(
+            "WWW.Example.COM", "www.example.com"));
+        BOOST_TEST(same(
+            "stra\xC3\x9F" "e.de", "strasse.de"));
+        BOOST_TEST(same(
+            "\xC2\xAD" "a.b", "a.b"));              // mapped to nothing
+        BOOST_TEST(same("", ""));
+        BOOST_TEST(same("", "\xC2\xAD"));
+
+        // the hash is that of the IDNA
+        BOOST_TEST_EQ(idna_hash()("B\xC3\xBC" "cher.de"),
+            idna_hash()(*utf8_to_idna("b\xC3\xBC" "cher.de")));
+    }
+
+    void
+    testDifferent()
+    {
+        BOOST_TEST(! idna_equal()("example.com", "example.co"));
+        BOOST_TEST(! idna_equal()("example.co", "example.com"));
+        BOOST_TEST(! idna_equal()("a.b", "a.b."));
+        BOOST_TEST(! idna_equal()("b\xC3\xBC" "cher.de", "bucher.de"));
+        BOOST_TEST(! idna_equal()("", "."));
+    }
+
+    void
+    testInvalid()
+    {
+        // not utf8, or a label too long for DNS;
+        // such hosts only equal the same octets
+        std::string const bad = "a\xFF.com";
+        std::string const big = std::string(64, 'a') + ".com";
+        std::string const huge = std::string(64, 'A') + ".com";
+        BOOST_TEST(idna_equal()(bad, bad));
+        BOOST_TEST(idna_equal()(big, big));
+        BOOST_TEST(! idna_equal()(big, huge));
+        BOOST_TEST(! idna_equal()(bad, "a.com"));
+        BOOST_TEST(! idna_equal()("a.com", bad));
+        BOOST_TEST_EQ(idna_hash()(bad), idna_hash()(bad));
+        BOOST_TEST_EQ(idna_hash()(big), idna_hash()(big));
+
+        // 63 octets is fine
+        BOOST_TEST(same(
+            std::string(63, 'A'), std::string(63, 'a')));
+    }
+
+    void
+    testContainer()
+    {
+        BOOST_TEST((std::is_same<
+            idna_hash::is_transparent, void>::value));
+        BOOST_TEST((std::is_same<
+            idna_equal::is_transparent, void>::value));
+
+        std::unordered_set<
+            std::string, idna_hash, idna_equal> set;
+        set.insert("xn--bcher-kva.de");
+        set.insert("example.com");
+        BOOST_TEST(! set.insert("B\xC3\xBC" "cher.de").second);
+        BOOST_TEST(! set.insert("EXAMPLE.com").second);
+        BOOST_TEST_EQ(set.size(), 2u);
+        BOOST_TEST(set.count("b\xC3\xBC" "cher.DE") == 1);
+        BOOST_TEST(set.count("xn--bcher-kva.de") == 1);
+        BOOST_TEST(set.count("bucher.de") == 0);
+    }
+
+    void
+    run()
+    {
+        testEquivalent();
+        testDifferent();
+        testInvalid();
+        testContainer();
+    }
+};
+
+TEST_SUITE(
+    idna_hash_test,
+    "boost.punycode.idna_hash");
+
+} // punycode
+} // boost
@@ -0,0 +1,187 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+// Test that header file is self-contained.
+#include <boost/punycode/label_info.hpp>
+
+#include <boost/punycode/idna.hpp>
+
+#include "test_suite.hpp"
+
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace punycode {
+
+struct label_info_test
+{
+    // the info of a domain with one label
+    static
+    label_info
+    info(core::string_view s)
+    {
+        std::vector<label_info> labels;
+        auto r = utf8_to_idna(s, labels);
+        BOOST_TEST(r.has_value());
+        BOOST_TEST_EQ(labels.size(), 1u);
+        if(labels.size() != 1)
+            return {};
+        return labels[0];
+    }
+
+    static
+    bool
+    level_is(
+        core::string_view s,
+        restriction_level level)
+    {
+        return info(s).level == level;
+    }
+
+    void
+    testScripts()
+    {
+        BOOST_TEST_EQ(info("example").scripts,
+            std::uint32_t(script_latin));
+        BOOST_TEST_EQ(info("B\xC3\xBC" "cher").scripts,
+            std::uint32_t(script_latin));
+        BOOST_TEST_EQ(info("\xD0\xBF\xD1\x80\xD0\xB8"
+            "\xD0\xBC\xD0\xB5\xD1\x80").scripts,    // пример
+            std::uint32_t(script_cyrillic));
+        BOOST_TEST_EQ(info("\xD1\x80\xD0\xB0\xD1\x83"
+            "\xD1\x80\xD0\xB0l").scripts,           // раураl
+            std::uint32_t(script_cyrillic | script_latin));
+        BOOST_TEST_EQ(info("\xE6\x97\xA5\xE6\x9C\xAC"
+            "\xE3\x81\x8B\xE3\x81\xAA").scripts,    // 日本かな
+            std::uint32_t(script_han | script_hiragana));
+
+        // Common and Inherited add nothing
+        BOOST_TEST_EQ(info("123-4").scripts, 0u);
+
+        // Cherokee is not recommended
+        BOOST_TEST_EQ(info("\xE1\x8E\xA0").scripts,
+            std::uint32_t(script_other));
+    }
+
+    void
+    testLevel()
+    {
+        BOOST_TEST(level_is("example",
+            restriction_level::ascii_only));
+        BOOST_TEST(level_is("123",
+            restriction_level::ascii_only));
+        BOOST_TEST(level_is("B\xC3\xBC" "cher",
+            restriction_level::single_script));
+        BOOST_TEST(level_is("\xD0\xBF\xD1\x80\xD0\xB8"
+            "\xD0\xBC\xD0\xB5\xD1\x80",
+            restriction_level::single_script));
+
+        // Han and Hiragana resolve to Japanese
+        BOOST_TEST(level_is("\xE6\x97\xA5\xE6\x9C\xAC"
+            "\xE3\x81\x8B\xE3\x81\xAA",
+            restriction_level::single_script));
+
+        // Latin with Japanese, or Korean
+        BOOST_TEST(level_is("abc\xE6\x97\xA5\xE6\x9C\xAC"
+            "\xE3\x81\x8B\xE3\x81\xAA",
+            restriction_level::highly_restrictive));
+        BOOST_TEST(level_is("\xED\x95\x9C\xEA\xB5\xAD"
+            "\xEC\x96\xB4" "abc",
+            restriction_level::highly_restrictive));
+
+        // Latin with Devanagari
+        BOOST_TEST(level_is("abc\xE0\xA4\xA8\xE0\xA4\xAE"
+            "\xE0\xA4\xB8\xE0\xA5\x8D\xE0\xA4\xA4"
+            "\xE0\xA5\x87",
+            restriction_level::moderately_restrictive));
+
+        // Latin with Cyrillic
+        BOOST_TEST(level_is("\xD1\x80\xD0\xB0\xD1\x83"
+            "\xD1\x80\xD0\xB0l",
+            restriction_level::minimally_restrictive));
+
+        // not in the General Security Profile
+        BOOST_TEST(level_is("a\xE2\x99\xA5",
+            restriction_level::unrestricted));
+        BOOST_TEST(level_is("\xE1\x8E\xA0",
+            restriction_level::unrestricted));
+    }
+
+    void
+    testDigits()
+    {
+        BOOST_TEST(! info("12").has_digits_mixed);
+        BOOST_TEST(! info("\xE0\xA7\xA7\xE0\xA7\xA8")
+            .has_digits_mixed);                     // ১২
+        BOOST_TEST(info("1\xE0\xA7\xA7")
+            .has_digits_mixed);                     // 1১
+
+        // fullwidth digits are ascii after nameprep
+        BOOST_TEST(! info("1\xEF\xBC\x92")
+            .has_digits_mixed);
+    }
+
+    void
+    testLabels()
+    {
+        std::vector<label_info> labels;
+        auto r = utf8_to_idna(
+            "\xD0\xBF\xD1\x80\xD0\xB8\xD0\xBC\xD0\xB5"
+            "\xD1\x80.example..COM.", labels);
+        BOOST_TEST(r.has_value());
+        BOOST_TEST_EQ(labels.size(), 5u);
+        if(labels.size() == 5)
+        {
+            BOOST_TEST(labels[0].level ==
+                restriction_level::single_script);
+            BOOST_TEST(labels[1].level ==
+                restriction_level::ascii_only);
+            BOOST_TEST_EQ(labels[2].scripts, 0u);
+            BOOST_TEST_EQ(labels[3].scripts,
+                std::uint32_t(script_latin));
+            BOOST_TEST_EQ(labels[4].scripts, 0u);
+        }
+
+        // the IDNA is the same as without labels
+        BOOST_TEST_EQ(*r, *utf8_to_idna(
+            "\xD0\xBF\xD1\x80\xD0\xB8\xD0\xBC\xD0\xB5"
+            "\xD1\x80.example..COM."));
+
+        // cleared on failure
+        BOOST_TEST(utf8_to_idna(
+            "a.\xFF", labels).has_error());
+        BOOST_TEST(labels.empty());
+        labels.resize(3);
+        BOOST_TEST(utf8_to_idna(
+            "a\xC2\x80", labels).has_error());
+        BOOST_TEST(labels.empty());
+
+        // reused
+        labels.resize(3);
+        BOOST_TEST(utf8_to_idna("a", labels).has_value());
+        BOOST_TEST_EQ(labels.size(), 1u);
+    }
+
+    void
+    run()
+    {
+        testScripts();
+        testLevel();
+        testDigits();
+        testLabels();
+    }
+};
+
+TEST_SUITE(
+    label_info_test,
+    "boost.punycode.label_info");
+
+} // punycode
+} // boost
@@ -0,0 +1,229 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+// Test that header file is self-contained.
+#include <boost/punycode/public_suffix_list.hpp>
+
+#include <boost/punycode/idna.hpp>
+
+#include "test_suite.hpp"
+
+#include <string>
+
+namespace boost {
+namespace punycode {
+
+struct public_suffix_list_test
+{
+    // rules from the list, for the tests
+    // of https://publicsuffix.org/list/
+    static
+    public_suffix_list
+    make_list()
+    {
+        auto rv = public_suffix_list::parse(
+            "// ===BEGIN ICANN DOMAINS===\n"
+            "\n"
+            "com\n"
+            "uk.com\n"
+            "biz\n"
+            "jp\n"
+            "ac.jp\n"
+            "kyoto.jp\n"
+            "ide.kyoto.jp\n"
+            "*.kobe.jp\n"
+            "!city.kobe.jp\n"
+            "*.ck\n"
+            "!www.ck\n"
+            "us\n"
+            "ak.us\n"
+            "k12.ak.us\n"
+            "cn\n"
+            "com.cn\n"
+            "\xE5\x85\xAC\xE5\x8F\xB8.cn\n"        // 公司.cn
+            "\xE4\xB8\xAD\xE5\x9B\xBD\n"            // 中国
+            "xn--fiqz9s\r\n"
+            "mil.kr  trailing words are ignored\n"
+            "kr\n"
+            "// ===END ICANN DOMAINS===");
+        BOOST_TEST(rv.has_value());
+        if(! rv)
+            return {};
+        return std::move(*rv);
+    }
+
+    // check the registrable domain of a utf8 domain,
+    // which is empty when there is none
+    static
+    bool
+    check(
+        public_suffix_list const& psl,
+        core::string_view domain,
+        core::string_view expected)
+    {
+        auto const idna = utf8_to_idna(domain);
+        if(! idna)
+            return false;
+        std::string want;
+        if(! expected.empty())
+            want = *utf8_to_idna(expected);
+        return psl.registrable_domain(*idna) == want;
+    }
+
+    void
+    testRegistrable()
+    {
+        auto const psl = make_list();
+        BOOST_TEST_EQ(psl.size(), 21u);
+
+        // the tests of checkPublicSuffix
+        BOOST_TEST(check(psl, "", ""));
+        BOOST_TEST(check(psl, "COM", ""));
+        BOOST_TEST(check(psl, "example.COM", "example.com"));
+        BOOST_TEST(check(psl, "WwW.example.COM", "example.com"));
+        BOOST_TEST(check(psl, "example", ""));
+        BOOST_TEST(check(psl, "example.example", "example.example"));
+        BOOST_TEST(check(psl, "b.example.example", "example.example"));
+        BOOST_TEST(check(psl, "a.b.example.example", "example.example"));
+        BOOST_TEST(check(psl, "biz", ""));
+        BOOST_TEST(check(psl, "domain.biz", "domain.biz"));
+        BOOST_TEST(check(psl, "a.b.domain.biz", "domain.biz"));
+        BOOST_TEST(check(psl, "uk.com", ""));
+        BOOST_TEST(check(psl, "example.uk.com", "example.uk.com"));
+        BOOST_TEST(check(psl, "b.example.uk.com", "example.uk.com"));
+        BOOST_TEST(check(psl, "jp", ""));
+        BOOST_TEST(check(psl, "test.jp", "test.jp"));
+        BOOST_TEST(check(psl, "www.test.jp", "test.jp"));
+        BOOST_TEST(check(psl, "ac.jp", ""));
+        BOOST_TEST(check(psl, "test.ac.jp", "test.ac.jp"));
+        BOOST_TEST(check(psl, "www.test.ac.jp", "test.ac.jp"));
+        BOOST_TEST(check(psl, "kyoto.jp", ""));
+        BOOST_TEST(check(psl, "test.kyoto.jp", "test.kyoto.jp"));
+        BOOST_TEST(check(psl, "ide.kyoto.jp", ""));
+        BOOST_TEST(check(psl, "b.ide.kyoto.jp", "b.ide.kyoto.jp"));
+        BOOST_TEST(check(psl, "a.b.ide.kyoto.jp", "b.ide.kyoto.jp"));
+        BOOST_TEST(check(psl, "c.kobe.jp", ""));
+        BOOST_TEST(check(psl, "b.c.kobe.jp", "b.c.kobe.jp"));
+        BOOST_TEST(check(psl, "a.b.c.kobe.jp", "b.c.kobe.jp"));
+        BOOST_TEST(check(psl, "city.kobe.jp", "city.kobe.jp"));
+        BOOST_TEST(check(psl, "www.city.kobe.jp", "city.kobe.jp"));
+        BOOST_TEST(check(psl, "ck", ""));
+        BOOST_TEST(check(psl, "test.ck", ""));
+        BOOST_TEST(check(psl, "b.test.ck", "b.test.ck"));
+        BOOST_TEST(check(psl, "a.b.test.ck", "b.test.ck"));
+        BOOST_TEST(check(psl, "www.ck", "www.ck"));
+        BOOST_TEST(check(psl, "www.www.ck", "www.ck"));
+        BOOST_TEST(check(psl, "us", ""));
+        BOOST_TEST(check(psl, "test.us", "test.us"));
+        BOOST_TEST(check(psl, "www.test.us", "test.us"));
+        BOOST_TEST(check(psl, "ak.us", ""));
+        BOOST_TEST(check(psl, "test.ak.us", "test.ak.us"));
+        BOOST_TEST(check(psl, "www.test.ak.us", "test.ak.us"));
+        BOOST_TEST(check(psl, "k12.ak.us", ""));
+        BOOST_TEST(check(psl, "test.k12.ak.us", "test.k12.ak.us"));
+        BOOST_TEST(check(psl, "www.test.k12.ak.us", "test.k12.ak.us"));
+
+        // rules and domains in Unicode
+        BOOST_TEST(check(psl,
+            "\xE9\xA3\x9F\xE7\x8B\xAE.com.cn",
+            "\xE9\xA3\x9F\xE7\x8B\xAE.com.cn"));
+        BOOST_TEST(check(psl,
+            "\xE9\xA3\x9F\xE7\x8B\xAE.\xE5\x85\xAC\xE5\x8F\xB8.cn",
+            "\xE9\xA3\x9F\xE7\x8B\xAE.\xE5\x85\xAC\xE5\x8F\xB8.cn"));
+        BOOST_TEST(check(psl,
+            "www.\xE9\xA3\x9F\xE7\x8B\xAE.\xE5\x85\xAC\xE5\x8F\xB8.cn",
+            "\xE9\xA3\x9F\xE7\x8B\xAE.\xE5\x85\xAC\xE5\x8F\xB8.cn"));
+        BOOST_TEST(check(psl,
+            "shishi.\xE5\x85\xAC\xE5\x8F\xB8.cn",
+            "shishi.\xE5\x85\xAC\xE5\x8F\xB8.cn"));
+        BOOST_TEST(check(psl,
+            "\xE5\x85\xAC\xE5\x8F\xB8.cn", ""));
+        BOOST_TEST(check(psl,
+            "www.\xE4\xB8\xAD\xE5\x9B\xBD",
+            "www.\xE4\xB8\xAD\xE5\x9B\xBD"));
+        BOOST_TEST(check(psl, "\xE4\xB8\xAD\xE5\x9B\xBD", ""));
+        BOOST_TEST(check(psl, "a.xn--fiqz9s", "a.xn--fiqz9s"));
+        BOOST_TEST(check(psl, "a.b.mil.kr", "b.mil.kr"));
+    }
+
+    void
+    testSuffix()
+    {
+        auto const psl = make_list();
+
+        // views into the domain
+        core::string_view const s = "www.example.co.uk";
+        BOOST_TEST_EQ(psl.public_suffix(s), "uk");
+        BOOST_TEST_EQ(psl.public_suffix(s).data(),
+            s.data() + s.size() - 2);
+        BOOST_TEST_EQ(psl.registrable_domain(s), "co.uk");
+        BOOST_TEST_EQ(psl.public_suffix("a.b.c.kobe.jp"),
+            "c.kobe.jp");
+        BOOST_TEST_EQ(psl.public_suffix("www.city.kobe.jp"),
+            "kobe.jp");
+
+        // a trailing dot is kept
+        BOOST_TEST_EQ(psl.public_suffix("example.com."),
+            "com.");
+        BOOST_TEST_EQ(psl.registrable_domain("www.example.com."),
+            "example.com.");
+        BOOST_TEST_EQ(psl.registrable_domain("com."), "");
+
+        // empty labels
+        BOOST_TEST_EQ(psl.public_suffix("a..com"), "com");
+        BOOST_TEST_EQ(psl.registrable_domain("a..com"), "");
+        BOOST_TEST_EQ(psl.registrable_domain(".com"), "");
+
+        // the implicit rule "*"
+        public_suffix_list const empty;
+        BOOST_TEST_EQ(empty.size(), 0u);
+        BOOST_TEST_EQ(empty.public_suffix("a.b.c"), "c");
+        BOOST_TEST_EQ(empty.registrable_domain("a.b.c"), "b.c");
+        BOOST_TEST_EQ(empty.public_suffix(""), "");
+    }
+
+    void
+    testInvalid()
+    {
+        BOOST_TEST(public_suffix_list::parse(
+            "a.*.com\n").has_error());
+        BOOST_TEST(public_suffix_list::parse(
+            "*\n").has_error());
+        BOOST_TEST(public_suffix_list::parse(
+            "a..com\n").has_error());
+        BOOST_TEST(public_suffix_list::parse(
+            "com.\n").has_error());
+        BOOST_TEST(public_suffix_list::parse(
+            "\xFF\n").has_error());
+
+        // an empty list
+        auto rv = public_suffix_list::parse("");
+        BOOST_TEST(rv.has_value());
+        BOOST_TEST_EQ(rv->size(), 0u);
+
+        BOOST_TEST(public_suffix_list::load(
+            "/nonexistent/public_suffix_list.dat")
+                .has_error());
+    }
+
+    void
+    run()
+    {
+        testRegistrable();
+        testSuffix();
+        testInvalid();
+    }
+};
+
+TEST_SUITE(
+    public_suffix_list_test,
+    "boost.punycode.public_suffix_list");
+
+} // punycode
+} // boost
@@ -10,11 +10,11 @@
 // Test that header file is self-contained.
 #include <boost/punycode/punycode.hpp>
 #include <boost/punycode/ascii_count.hpp>
-#include <boost/punycode/utf8_count.hpp>
+#include <boost/punycode/transcode.hpp>
 #include <boost/punycode/utf8_input.hpp>
 #include <boost/punycode/utf8_output.hpp>
-#include <boost/punycode/utf32_count.hpp>
 #include <boost/core/detail/string_view.hpp>
+#include <boost/system/system_error.hpp>
 
 #include "test_suite.hpp"
 
@@ -63,12 +63,10 @@ public:
     to_utf8(std::u32string const& in)
     {
         std::string out;
-        out.resize(std::copy(
-            in.begin(),
-            in.end(),
-            utf8_count()).count());
-        std::copy(in.begin(), in.end(),
-            utf8_output(&out[0]));
+        out.resize(utf8_length(
+            in.data(), in.size()));
+        utf8_output(&out[0], &out[0] + out.size())
+            .write(in.data(), in.size());
         return out;
     }
 
@@ -77,13 +75,7 @@ public:
     from_utf8(std::string const& in)
     {
         std::u32string out;
-        out.resize(std::copy(
-            utf8_input(
-                in.data(),
-                in.data() + in.size()),
-            utf8_input(
-                in.data() + in.size()),
-            utf32_count()).count());
+        out.resize(utf32_length(in));
         std::copy(
             utf8_input(
                 in.data(),
@@ -258,10 +250,41 @@ public:
         test_set(check);
     }
 
+    void
+    testMalformed()
+    {
+        // truncated variable length integer
+        {
+            char32_t buf[16];
+            std::size_t len = 16;
+            punycode::decode("abc-d", 5, buf, &len);
+            BOOST_TEST_EQ(len, 3u);
+        }
+
+        // basic code points do not fit
+        {
+            char32_t buf[2];
+            std::size_t len = 2;
+            BOOST_TEST_THROWS(punycode::decode(
+                "abcdef-x", 8, buf, &len),
+                system::system_error);
+        }
+
+        // high ascii
+        {
+            char32_t buf[16];
+            std::size_t len = 16;
+            BOOST_TEST_THROWS(punycode::decode(
+                "ab\x80-x", 5, buf, &len),
+                system::system_error);
+        }
+    }
+
     void
     run()
     {
         doTestSet();
+        testMalformed();
     }
 };
 
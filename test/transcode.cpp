@@ -0,0 +1,654 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+// Test that header file is self-contained.
+#include <boost/punycode/transcode.hpp>
+
+#include <boost/punycode/idna.hpp>
+#include <boost/punycode/punycode.hpp>
+#include <boost/punycode/utf8_count.hpp>
+#include <boost/punycode/utf8_input.hpp>
+#include <boost/punycode/utf8_output.hpp>
+#include <boost/punycode/utf32_count.hpp>
+#include <boost/system/system_error.hpp>
+
+#include "adversarial.hpp"
+#include "test_suite.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace punycode {
+
+class transcode_test
+{
+public:
+    using level = detail::simd_level;
+
+    // every kernel, including those the
+    // processor lacks, which fall back
+    static constexpr level levels[] = {
+        level::none, level::sse4,
+        level::avx2, level::avx512 };
+
+    // straightforward validation, for reference
+    static
+    bool
+    valid(core::string_view s)
+    {
+        auto const p = reinterpret_cast<
+            unsigned char const*>(s.data());
+        auto const n = s.size();
+        std::size_t i = 0;
+        while(i < n)
+        {
+            unsigned const c = p[i];
+            if(c < 0x80)
+            {
+                ++i;
+                continue;
+            }
+            std::size_t len;
+            char32_t cp;
+            if(c >= 0xc2 && c <= 0xdf)
+            {
+                len = 2;
+                cp = c & 0x1f;
+            }
+            else if(c >= 0xe0 && c <= 0xef)
+            {
+                len = 3;
+                cp = c & 0x0f;
+            }
+            else if(c >= 0xf0 && c <= 0xf4)
+            {
+                len = 4;
+                cp = c & 0x07;
+            }
+            else
+            {
+                return false;
+            }
+            if(n - i < len)
+                return false;
+            for(std::size_t k = 1; k < len; ++k)
+            {
+                if((p[i + k] & 0xc0) != 0x80)
+                    return false;
+                cp = (cp << 6) | (p[i + k] & 0x3f);
+            }
+            if(len == 3 && (cp < 0x800 ||
+                (cp >= 0xd800 && cp <= 0xdfff)))
+                return false;
+            if(len == 4 && (cp < 0x10000 ||
+                cp > 0x10ffff))
+                return false;
+            i += len;
+        }
+        return true;
+    }
+
+    // true if every kernel agrees with the
+    // reference, and decodes to the same
+    static
+    bool
+    agrees(core::string_view s)
+    {
+        bool const v = valid(s);
+        std::vector<char32_t> ref(s.size() + 1);
+        auto const n0 = detail::utf8_to_utf32(
+            s, ref.data(), level::none);
+        if(v != (n0 != SIZE_MAX))
+            return false;
+        std::vector<char32_t> u(s.size() + 1);
+        for(auto lv : levels)
+        {
+            if(detail::is_valid_utf8(s, lv) != v)
+                return false;
+            auto const n = detail::utf8_to_utf32(
+                s, u.data(), lv);
+            if(n != n0)
+                return false;
+            if(v && ! std::equal(
+                    u.begin(), u.begin() + n, ref.begin()))
+                return false;
+        }
+
+        // the iterator throws instead
+        try
+        {
+            auto const end = std::copy(
+                utf8_input(s.data(), s.data() + s.size()),
+                utf8_input(s.data() + s.size()),
+                u.data());
+            if(! v || ! std::equal(
+                    u.data(), end, ref.begin()) ||
+                static_cast<std::size_t>(
+                    end - u.data()) != n0)
+                return false;
+        }
+        catch(system::system_error const&)
+        {
+            if(v)
+                return false;
+        }
+        return true;
+    }
+
+    void
+    testDecode()
+    {
+        auto const check = [](
+            core::string_view s,
+            std::u32string const& u)
+        {
+            for(auto lv : levels)
+            {
+                std::vector<char32_t> v(s.size() + 1);
+                auto const n = detail::utf8_to_utf32(
+                    s, v.data(), lv);
+                if(! BOOST_TEST_EQ(n, u.size()))
+                    continue;
+                BOOST_TEST(std::u32string(
+                    v.data(), n) == u);
+            }
+            std::vector<char32_t> v(s.size() + 1);
+            auto rv = utf8_to_utf32(s, v.data());
+            if(BOOST_TEST(rv.has_value()))
+                BOOST_TEST_EQ(*rv, u.size());
+        };
+
+        check("", U"");
+        check("a", U"a");
+        check("\x7f", U"\u007f");
+        check("\xC2\x80", U"\u0080");
+        check("\xDF\xBF", U"߿");
+        check("\xE0\xA0\x80", U"ࠀ");
+        check("\xED\x9F\xBF", U"퟿");
+        check("\xEE\x80\x80", U"");
+        check("\xEF\xBF\xBF", U"￿");
+        check("\xF0\x90\x80\x80", U"\U00010000");
+        check("\xF4\x8F\xBF\xBF", U"\U0010ffff");
+
+        // long enough for every register width,
+        // with ascii runs and mixed blocks
+        std::u32string u;
+        for(char32_t i = 0; i < 200; ++i)
+            u += i % 7 ? char32_t('a' + i % 26) :
+                char32_t(0x400 + i);
+        u += std::u32string(130, U'z');
+        u += U"中文\U0001F600";
+        check(adversarial::to_utf8(u), u);
+    }
+
+    void
+    testInvalid()
+    {
+        static char const* const bad[] = {
+            "\x80",                 // stray continuation
+            "\xBF",
+            "\xC0\x80",             // overlong
+            "\xC1\xBF",
+            "\xE0\x80\x80",
+            "\xE0\x9F\xBF",
+            "\xF0\x80\x80\x80",
+            "\xF0\x8F\xBF\xBF",
+            "\xED\xA0\x80",         // surrogates
+            "\xED\xBF\xBF",
+            "\xF4\x90\x80\x80",     // above U+10FFFF
+            "\xF5\x80\x80\x80",
+            "\xFF",
+            "\xC3",                 // truncated
+            "\xE2\x82",
+            "\xF0\x9F\x98",
+            "\xC3\xC3\xA9",
+            "\xE2\x28\xA1" };
+
+        // at every offset, so that each one
+        // straddles every block boundary
+        std::size_t failed = 0;
+        for(auto b : bad)
+        {
+            for(std::size_t i = 0; i < 140; ++i)
+            {
+                std::string s(i, 'a');
+                s += b;
+                if(! agrees(s))
+                    ++failed;
+                s += std::string(i % 70, 'b');
+                if(! agrees(s))
+                    ++failed;
+                for(auto lv : levels)
+                    if(detail::is_valid_utf8(s, lv))
+                        ++failed;
+            }
+        }
+        BOOST_TEST_EQ(failed, 0u);
+
+        char32_t u[8];
+        auto rv = utf8_to_utf32("\xC0\x80", u);
+        if(BOOST_TEST(rv.has_error()))
+            BOOST_TEST(rv.error() ==
+                system::errc::illegal_byte_sequence);
+        BOOST_TEST(! is_valid_utf8("\xED\xA0\x80"));
+        BOOST_TEST(is_valid_utf8("\xED\x9F\xBF"));
+    }
+
+    void
+    testExhaustive()
+    {
+        // all sequences of one and two octets, and
+        // three and four octet sequences over the
+        // interesting ranges, at moving offsets
+        std::size_t failed = 0;
+        std::size_t k = 0;
+        auto const at = [&k](std::string const& seq)
+        {
+            auto const i = k++ % 67;
+            std::string s(i, 'x');
+            s += seq;
+            s.append(67 - i, 'y');
+            return s;
+        };
+        for(unsigned a = 0; a < 256; ++a)
+        {
+            std::string seq(1, char(a));
+            if(! agrees(at(seq)))
+                ++failed;
+            for(unsigned b = 0; b < 256; ++b)
+            {
+                seq = { char(a), char(b) };
+                if(! agrees(at(seq)))
+                    ++failed;
+            }
+        }
+        for(unsigned a = 0xe0; a < 0xf8; ++a)
+        for(unsigned b = 0x70; b < 0xd0; b += 3)
+        for(unsigned c = 0x70; c < 0xd0; c += 5)
+        {
+            std::string seq = { char(a), char(b), char(c) };
+            if(! agrees(at(seq)))
+                ++failed;
+            seq.push_back(char(0x80 + (a + b + c) % 0x50));
+            if(! agrees(at(seq)))
+                ++failed;
+        }
+        BOOST_TEST_EQ(failed, 0u);
+    }
+
+    void
+    testRandom()
+    {
+        std::mt19937 g(2024);
+        std::size_t failed = 0;
+        for(int i = 0; i < 2000; ++i)
+        {
+            // random code points of mixed width
+            std::u32string u;
+            auto const n = g() % 300;
+            for(std::size_t j = 0; j < n; ++j)
+            {
+                char32_t cp;
+                switch(g() % 4)
+                {
+                case 0: cp = g() % 0x80; break;
+                case 1: cp = 0x80 + g() % 0x780; break;
+                case 2: cp = 0x800 + g() % 0xf800; break;
+                default: cp = 0x10000 + g() % 0x100000; break;
+                }
+                if(cp >= 0xd800 && cp <= 0xdfff)
+                    cp = 'q';
+                u.push_back(cp);
+            }
+            auto s = adversarial::to_utf8(u);
+            std::vector<char32_t> v(s.size() + 1);
+            for(auto lv : levels)
+            {
+                auto const m = detail::utf8_to_utf32(
+                    s, v.data(), lv);
+                if( m != u.size() ||
+                    std::u32string(v.data(), m) != u)
+                    ++failed;
+            }
+
+            // then damage one octet
+            if(! s.empty())
+            {
+                s[g() % s.size()] = static_cast<char>(g());
+                if(! agrees(s))
+                    ++failed;
+            }
+        }
+        BOOST_TEST_EQ(failed, 0u);
+    }
+
+    void
+    testEncode()
+    {
+        std::u32string const u =
+            U"bücher-über-中文";
+        auto const s = adversarial::to_utf8(u);
+        BOOST_TEST_EQ(adversarial::to_puny(u), [&s]
+        {
+            std::string out;
+            punycode::encode(
+                std::back_inserter(out), s);
+            return out;
+        }());
+
+        // longer than the stack buffer
+        auto const w = adversarial::max_deltas(600);
+        std::string out;
+        punycode::encode(std::back_inserter(out),
+            adversarial::to_utf8(w));
+        BOOST_TEST_EQ(out, adversarial::to_puny(w));
+
+        BOOST_TEST_THROWS(punycode::encode(
+            std::back_inserter(out),
+            core::string_view("\xC0\x80")),
+            system::system_error);
+    }
+
+    void
+    testIdna()
+    {
+        auto rv = utf8_to_idna("b\xC3\xBC" "cher.\xED\xA0\x80");
+        if(BOOST_TEST(rv.has_error()))
+            BOOST_TEST(rv.error() ==
+                system::errc::illegal_byte_sequence);
+
+        // too long for the stack buffer
+        std::string s(300, 'a');
+        s += ".b\xC3\xBC" "cher";
+        rv = utf8_to_idna(s);
+        if(BOOST_TEST(rv.has_value()))
+            BOOST_TEST_EQ(*rv,
+                std::string(300, 'a') + ".xn--bcher-kva");
+        s += "\xE2\x82";
+        rv = utf8_to_idna(s);
+        if(BOOST_TEST(rv.has_error()))
+            BOOST_TEST(rv.error() ==
+                system::errc::illegal_byte_sequence);
+    }
+
+    // one code point at a time, for reference
+    static
+    std::string
+    encode_each(std::u32string const& u)
+    {
+        std::string s(4 * u.size(), '\0');
+        auto const end = std::copy(
+            u.begin(), u.end(), utf8_output(&s[0]));
+        s.resize(end.base() - &s[0]);
+        return s;
+    }
+
+    // true if every kernel encodes u like
+    // the reference, or rejects it at i
+    static
+    bool
+    encodes(
+        std::u32string const& u,
+        std::size_t bad = std::size_t(-1))
+    {
+        auto const ref = encode_each(u);
+        std::string s(4 * u.size() + 1, '\0');
+        for(auto lv : levels)
+        {
+            auto const rv = detail::utf32_to_utf8(
+                u.data(), u.data() + u.size(),
+                &s[0], &s[0] + s.size(), lv);
+            if(bad < u.size())
+            {
+                if(rv.in != u.data() + bad)
+                    return false;
+                continue;
+            }
+            if( rv.in != u.data() + u.size() ||
+                std::string(&s[0], rv.out) != ref)
+                return false;
+
+            // exactly enough room, then one less
+            std::string t(ref.size(), '\0');
+            auto const fit = detail::utf32_to_utf8(
+                u.data(), u.data() + u.size(),
+                &t[0], &t[0] + t.size(), lv);
+            if( fit.in != u.data() + u.size() ||
+                t != ref)
+                return false;
+            if(ref.empty())
+                continue;
+            auto const full = detail::utf32_to_utf8(
+                u.data(), u.data() + u.size(),
+                &t[0], &t[0] + t.size() - 1, lv);
+            if( full.in == u.data() + u.size() ||
+                ! detail::is_scalar_value(*full.in) ||
+                full.out > &t[0] + t.size() - 1)
+                return false;
+        }
+        return true;
+    }
+
+    void
+    testUtf32ToUtf8()
+    {
+        BOOST_TEST(encodes(U""));
+        BOOST_TEST(encodes(U"a"));
+        BOOST_TEST(encodes(std::u32string(100, U'a')));
+        BOOST_TEST(encodes(std::u32string(100, U'\u07ff')));
+        BOOST_TEST(encodes(std::u32string(100, U'\u0800')));
+        BOOST_TEST(encodes(std::u32string(100, U'\uffff')));
+
+        // every boundary, in every lane
+        static char32_t const edges[] = {
+            0x7f, 0x80, 0x7ff, 0x800, 0xd7ff,
+            0xe000, 0xffff, 0x10000, 0x10ffff };
+        std::size_t failed = 0;
+        for(auto cp : edges)
+        {
+            for(std::size_t i = 0; i < 70; ++i)
+            {
+                std::u32string u(i, U'x');
+                u.push_back(cp);
+                u.append(i % 23, U'\u0444');
+                if(! encodes(u))
+                    ++failed;
+            }
+        }
+
+        // invalid code points are reported in place
+        static char32_t const bad[] = {
+            0xd800, 0xdbff, 0xdc00, 0xdfff,
+            0x110000, 0xffffffff };
+        for(auto cp : bad)
+        {
+            for(std::size_t i = 0; i < 70; ++i)
+            {
+                std::u32string u(i, U'\u4e2d');
+                u.push_back(cp);
+                u.append(i % 19, U'y');
+                if(! encodes(u, i))
+                    ++failed;
+            }
+        }
+
+        std::mt19937 g(33);
+        for(int i = 0; i < 2000; ++i)
+        {
+            std::u32string u;
+            auto const n = g() % 200;
+            for(std::size_t j = 0; j < n; ++j)
+            {
+                char32_t cp;
+                switch(g() % 4)
+                {
+                case 0: cp = g() % 0x80; break;
+                case 1: cp = 0x80 + g() % 0x780; break;
+                case 2: cp = 0x800 + g() % 0xf800; break;
+                default: cp = 0x10000 + g() % 0x100000; break;
+                }
+                if(! detail::is_scalar_value(cp))
+                    cp = 'q';
+                u.push_back(cp);
+            }
+            if(! encodes(u))
+                ++failed;
+        }
+        BOOST_TEST_EQ(failed, 0u);
+
+        char s[16];
+        auto rv = utf32_to_utf8(U"ab\u4e2d", 3, s, sizeof(s));
+        if(BOOST_TEST(rv.has_value()))
+            BOOST_TEST_EQ(std::string(s, *rv),
+                "ab\xE4\xB8\xAD");
+        rv = utf32_to_utf8(U"ab\u4e2d", 3, s, 4);
+        if(BOOST_TEST(rv.has_error()))
+            BOOST_TEST(rv.error() ==
+                system::errc::no_buffer_space);
+        char32_t const sur[] = { 'a', 0xdc00 };
+        rv = utf32_to_utf8(sur, 2, s, sizeof(s));
+        if(BOOST_TEST(rv.has_error()))
+            BOOST_TEST(rv.error() ==
+                system::errc::illegal_byte_sequence);
+    }
+
+    void
+    testWrite()
+    {
+        std::u32string const u = U"b\u00fccher-\u4e2d\U0001F600";
+        auto const ref = encode_each(u);
+        std::string s(ref.size(), '\0');
+        utf8_output out(&s[0], &s[0] + s.size());
+        out.write(u.data(), 3);
+        BOOST_TEST_EQ(out.base() - &s[0], 4);
+        out.write(u.data() + 3, u.size() - 3);
+        BOOST_TEST(out.base() == &s[0] + s.size());
+        BOOST_TEST_EQ(s, ref);
+
+        // no room left
+        BOOST_TEST_THROWS(out.write(u.data(), 1),
+            system::system_error);
+
+        // unbounded
+        std::string t(4 * u.size(), '\0');
+        auto const end = utf8_output(&t[0])
+            .write(u.data(), u.size()).base();
+        BOOST_TEST_EQ(std::string(&t[0], end), ref);
+
+        char32_t const sur[] = { 'a', 0xd800 };
+        utf8_output bad(&t[0], &t[0] + t.size());
+        BOOST_TEST_THROWS(bad.write(sur, 2),
+            system::system_error);
+        BOOST_TEST(bad.base() == &t[0] + 1);
+    }
+
+    void
+    testLength()
+    {
+        // agrees with the counting iterators
+        // at every level and every length
+        std::mt19937 g(34);
+        std::size_t failed = 0;
+        for(int i = 0; i < 1000; ++i)
+        {
+            std::u32string u;
+            auto const n = g() % 150;
+            for(std::size_t j = 0; j < n; ++j)
+            {
+                char32_t cp;
+                switch(g() % 5)
+                {
+                case 0: cp = g() % 0x80; break;
+                case 1: cp = 0x80 + g() % 0x780; break;
+                case 2: cp = 0x800 + g() % 0xf800; break;
+                case 3: cp = 0x10000 + g() % 0x100000; break;
+                default: cp = g() % 2 ? 0x7f + g() % 3 :
+                    (g() % 2 ? 0x7ff + g() % 3 : 0xffff + g() % 3);
+                    break;
+                }
+                if(! detail::is_scalar_value(cp))
+                    cp = 'q';
+                u.push_back(cp);
+            }
+            auto const s = adversarial::to_utf8(u);
+            auto const bytes = std::copy(u.begin(), u.end(),
+                utf8_count()).count();
+            auto const points = std::copy(
+                utf8_input(s.data(), s.data() + s.size()),
+                utf8_input(s.data() + s.size()),
+                utf32_count()).count();
+            if(bytes != s.size() || points != u.size())
+                ++failed;
+            for(auto lv : levels)
+            {
+                if(detail::utf8_length(
+                        u.data(), u.size(), lv) != bytes)
+                    ++failed;
+                if(detail::utf32_length(s, lv) != points)
+                    ++failed;
+            }
+        }
+        BOOST_TEST_EQ(failed, 0u);
+
+        // values beyond unicode count as four,
+        // like the iterator, and the top bit of
+        // a lane does not confuse the comparison
+        char32_t const big[] = {
+            0x110000, 0x7fffffff, 0x80000000,
+            0xffffffff, 0x80, 0x800, 0x10000, 0x7f };
+        std::u32string v;
+        for(int i = 0; i < 20; ++i)
+            v.append(std::begin(big), std::end(big));
+        for(auto lv : levels)
+            BOOST_TEST_EQ(detail::utf8_length(
+                v.data(), v.size(), lv),
+                20u * (4 * 4 + 2 + 3 + 4 + 1));
+
+        // octets which are not continuations
+        std::string s(300, '\x80');
+        for(std::size_t i = 0; i < s.size(); i += 7)
+            s[i] = 'a';
+        for(std::size_t i = 3; i < s.size(); i += 11)
+            s[i] = '\xC3';
+        std::size_t leads = 0;
+        for(auto c : s)
+            if((static_cast<unsigned char>(c) & 0xc0) != 0x80)
+                ++leads;
+        for(auto lv : levels)
+            BOOST_TEST_EQ(detail::utf32_length(s, lv), leads);
+        BOOST_TEST_EQ(utf32_length(s), leads);
+        BOOST_TEST_EQ(utf8_length(U"a\u00e9\u4e2d\U0001F600", 4), 10u);
+    }
+
+    void
+    run()
+    {
+        testDecode();
+        testInvalid();
+        testExhaustive();
+        testRandom();
+        testEncode();
+        testIdna();
+        testUtf32ToUtf8();
+        testWrite();
+        testLength();
+    }
+};
+
+constexpr transcode_test::level
+    transcode_test::levels[];
+
+TEST_SUITE(
+    transcode_test,
+    "boost.punycode.transcode");
+
+} // punycode
+} // boost
@@ -0,0 +1,122 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+// Test that header file is self-contained.
+#include <boost/punycode/utf16_input.hpp>
+#include <boost/punycode/utf16_output.hpp>
+
+#include <boost/punycode/punycode.hpp>
+#include <boost/punycode/ascii_count.hpp>
+#include <boost/system/system_error.hpp>
+
+#include "test_suite.hpp"
+
+#include <algorithm>
+#include <string>
+
+namespace boost {
+namespace punycode {
+
+struct utf16_test
+{
+    static
+    std::u32string
+    from_utf16(std::u16string const& s)
+    {
+        std::u32string out;
+        std::copy(
+            utf16_input(s.data(), s.data() + s.size()),
+            utf16_input(s.data() + s.size()),
+            std::back_inserter(out));
+        return out;
+    }
+
+    static
+    std::u16string
+    to_utf16(std::u32string const& u)
+    {
+        std::u16string out(2 * u.size(), u'\0');
+        auto const it = std::copy(u.begin(), u.end(),
+            utf16_output(&out[0], &out[0] + out.size()));
+        out.resize(it.base() - &out[0]);
+        return out;
+    }
+
+    void
+    testRoundTrip()
+    {
+        auto const check = [](
+            std::u32string const& u,
+            std::u16string const& s)
+        {
+            BOOST_TEST(to_utf16(u) == s);
+            BOOST_TEST(from_utf16(s) == u);
+        };
+
+        check(U"", u"");
+        check(U"abc", u"abc");
+        check(U"é中", u"é中");
+        check(U"퟿￿", u"퟿￿");
+        check(U"\U00010000", u"\U00010000");
+        check(U"\U0001F600x", u"\xD83D\xDE00x");
+        check(U"\U0010FFFF", u"\xDBFF\xDFFF");
+    }
+
+    void
+    testInvalid()
+    {
+        static std::u16string const bad[] = {
+            std::u16string(1, u'\xD800'),           // lone high
+            std::u16string(1, u'\xDC00'),           // lone low
+            std::u16string(u"\xDBFF" u"a"),
+            std::u16string(u"a\xDFFF"),
+            std::u16string(u"\xDC00\xD800"),        // reversed
+            std::u16string(u"\xD800\xD800\xDC00") };
+        for(auto const& s : bad)
+            BOOST_TEST_THROWS(from_utf16(s),
+                system::system_error);
+    }
+
+    void
+    testPunycode()
+    {
+        // encode straight from utf16
+        std::u16string const s = u"bücher\U0001F600";
+        std::string out;
+        punycode::encode(std::back_inserter(out),
+            utf16_input(s.data(), s.data() + s.size()),
+            utf16_input(s.data() + s.size()));
+        std::u32string const u = U"bücher\U0001F600";
+        std::string ref(punycode::encode(
+            ascii_count(), u.begin(), u.end()).count(), '\0');
+        punycode::encode(&ref[0], u.begin(), u.end());
+        BOOST_TEST_EQ(out, ref);
+
+        // and decode back to utf16
+        char32_t buf[32];
+        std::size_t n = 32;
+        punycode::decode(out.data(), out.size(), buf, &n);
+        BOOST_TEST(to_utf16(std::u32string(buf, n)) == s);
+    }
+
+    void
+    run()
+    {
+        testRoundTrip();
+        testInvalid();
+        testPunycode();
+    }
+};
+
+TEST_SUITE(
+    utf16_test,
+    "boost.punycode.utf16");
+
+} // punycode
+} // boost
@@ -0,0 +1,482 @@
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+
+// Test that header file is self-contained.
+#include <boost/punycode/uts46.hpp>
+
+#include <boost/punycode/idna.hpp>
+
+#include "test_suite.hpp"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace punycode {
+
+/*  The conformance tests of UTS #46, in
+    IdnaTestV2.txt next to this file, are the
+    ones for Unicode 16.0, the version of the
+    tables, and every line is run. A source
+    with a lone surrogate has no utf8 form, so
+    it is given as ill-formed octets instead.
+
+    https://www.unicode.org/Public/idna/16.0.0/IdnaTestV2.txt
+*/
+struct uts46_test
+{
+    static
+    void
+    append_utf8(
+        std::string& s,
+        char32_t cp)
+    {
+        if(cp < 0x80)
+        {
+            s.push_back(static_cast<char>(cp));
+        }
+        else if(cp < 0x800)
+        {
+            s.push_back(static_cast<char>(0xc0 | (cp >> 6)));
+            s.push_back(static_cast<char>(0x80 | (cp & 0x3f)));
+        }
+        else if(cp < 0x10000)
+        {
+            s.push_back(static_cast<char>(0xe0 | (cp >> 12)));
+            s.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3f)));
+            s.push_back(static_cast<char>(0x80 | (cp & 0x3f)));
+        }
+        else
+        {
+            s.push_back(static_cast<char>(0xf0 | (cp >> 18)));
+            s.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3f)));
+            s.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3f)));
+            s.push_back(static_cast<char>(0x80 | (cp & 0x3f)));
+        }
+    }
+
+    // a field with its escapes replaced, or false
+    // if it holds a lone surrogate, which has no
+    // utf8 form and is written as three octets
+    static
+    bool
+    unescape(
+        std::string const& f,
+        std::string& out)
+    {
+        out.clear();
+        if(f == "\"\"")
+            return true;
+        bool valid = true;
+        for(std::size_t i = 0; i < f.size();)
+        {
+            char32_t cp;
+            if(f.compare(i, 2, "\\u") == 0)
+            {
+                cp = static_cast<char32_t>(std::stoul(
+                    f.substr(i + 2, 4), nullptr, 16));
+                i += 6;
+            }
+            else if(f.compare(i, 3, "\\x{") == 0)
+            {
+                auto const end = f.find('}', i);
+                cp = static_cast<char32_t>(std::stoul(
+                    f.substr(i + 3, end - i - 3), nullptr, 16));
+                i = end + 1;
+            }
+            else
+            {
+                out.push_back(f[i++]);
+                continue;
+            }
+            if(cp >= 0xd800 && cp <= 0xdfff)
+                valid = false;
+            append_utf8(out, cp);
+        }
+        return valid;
+    }
+
+    // true if a list of status codes has an error
+    // this implementation reports: all but X4_2,
+    // which ToUnicode records for an empty label
+    static
+    bool
+    has_error(std::string const& codes)
+    {
+        std::size_t i = 0;
+        for(;;)
+        {
+            i = codes.find_first_of("PVUABCX", i);
+            if(i == std::string::npos)
+                return false;
+            if(codes.compare(i, 4, "X4_2") != 0)
+                return true;
+            ++i;
+        }
+    }
+
+    // clear the options which the status codes
+    // are for, returning false if one of them
+    // is for a check which cannot be turned off
+    static
+    bool
+    relax(
+        std::string const& codes,
+        uts46_options& opt)
+    {
+        for(std::size_t i = 0;;)
+        {
+            i = codes.find_first_of("PVUABCX", i);
+            if(i == std::string::npos)
+                return true;
+            auto const end = codes.find_first_of(",]", i);
+            auto const code = codes.substr(i, end - i);
+            i = end;
+            if(code[0] == 'B')
+                opt.check_bidi = false;
+            else if(code[0] == 'C')
+                opt.check_joiners = false;
+            else if(code == "V2" || code == "V3")
+                opt.check_hyphens = false;
+            else if(code == "U1")
+                opt.use_std3_rules = false;
+            else if(code == "A4_1" || code == "A4_2")
+                opt.verify_dns_length = false;
+            else if(code != "X4_2")
+                return false;
+        }
+    }
+
+    static
+    std::string
+    trim(std::string const& s)
+    {
+        auto const first = s.find_first_not_of(" \t");
+        if(first == std::string::npos)
+            return {};
+        auto const last = s.find_last_not_of(" \t");
+        return s.substr(first, last - first + 1);
+    }
+
+    // an error must be the one for the status
+    // codes: without the checks they are for,
+    // the line converts to the expected string
+    template<class F>
+    void
+    check(
+        std::size_t line,
+        char const* what,
+        F const& f,
+        std::string const& source,
+        uts46_options opt,
+        std::string const& expected,
+        std::string const& codes)
+    {
+        auto rv = f(source, opt);
+        bool const error = has_error(codes);
+        bool ok = error ?
+            rv.has_error() && rv.error() ==
+                system::errc::invalid_argument :
+            rv.has_value() && *rv == expected;
+        if(ok && error && relax(codes, opt))
+        {
+            rv = f(source, opt);
+            ok = rv.has_value() && *rv == expected;
+        }
+        if(! BOOST_TEST(ok))
+            test_suite::log <<
+                "IdnaTestV2.txt:" << line << ": " << what <<
+                " expected " << (error ? codes : expected) << "\n";
+    }
+
+    void
+    testConformance()
+    {
+        std::string path = __FILE__;
+        path.erase(path.find_last_of("/\\") + 1);
+        path += "IdnaTestV2.txt";
+        std::ifstream in(path);
+        if(! BOOST_TEST(in.is_open()))
+            return;
+
+        auto const to_unicode =
+            [](std::string const& s, uts46_options const& opt)
+            {
+                return uts46_to_unicode(s, opt);
+            };
+        auto const to_ascii =
+            [](std::string const& s, uts46_options const& opt)
+            {
+                return uts46_to_ascii(s, opt);
+            };
+        uts46_options tr;
+        tr.transitional = true;
+        std::size_t line = 0;
+        std::size_t n = 0;
+        std::string s;
+        while(std::getline(in, s))
+        {
+            ++line;
+            s.erase(std::min(s.find('#'), s.size()));
+            if(trim(s).empty())
+                continue;
+            std::vector<std::string> f;
+            for(std::size_t i = 0;;)
+            {
+                auto const semi = s.find(';', i);
+                f.push_back(trim(s.substr(i, semi - i)));
+                if(semi == std::string::npos)
+                    break;
+                i = semi + 1;
+            }
+            if(! BOOST_TEST_EQ(f.size(), 7u))
+                continue;
+
+            // blank fields are the ones before
+            std::string source;
+            std::string uni;
+            std::string ascii_n;
+            std::string ascii_t;
+            if(! unescape(f[0], source))
+            {
+                // the octets are rejected before
+                // any mapping, by every conversion
+                auto const bad =
+                    [&](char const* what,
+                        system::result<std::string> const& rv,
+                        std::string const& codes)
+                    {
+                        if(! BOOST_TEST(has_error(codes) &&
+                            rv.has_error() && rv.error() ==
+                                system::errc::illegal_byte_sequence))
+                            test_suite::log <<
+                                "IdnaTestV2.txt:" << line << ": " <<
+                                what << " expected " << codes << "\n";
+                    };
+                auto const& codes = f[2];
+                bad("toUnicode", uts46_to_unicode(source), codes);
+                bad("toAsciiN", uts46_to_ascii(source),
+                    f[4].empty() ? codes : f[4]);
+                bad("toAsciiT", uts46_to_ascii(source, tr),
+                    f[6].empty() ? f[4].empty() ? codes :
+                        f[4] : f[6]);
+                ++n;
+                continue;
+            }
+            unescape(f[1].empty() ? f[0] : f[1], uni);
+            unescape(f[3].empty() ? f[1].empty() ? f[0] :
+                f[1] : f[3], ascii_n);
+            if(f[5].empty())
+                ascii_t = ascii_n;
+            else
+                unescape(f[5], ascii_t);
+            auto const& uni_codes = f[2];
+            auto const& n_codes =
+                f[4].empty() ? uni_codes : f[4];
+            auto const& t_codes =
+                f[6].empty() ? n_codes : f[6];
+
+            check(line, "toUnicode", to_unicode,
+                source, {}, uni, uni_codes);
+            check(line, "toAsciiN", to_ascii,
+                source, {}, ascii_n, n_codes);
+            check(line, "toAsciiT", to_ascii,
+                source, tr, ascii_t, t_codes);
+            ++n;
+        }
+        // every line of the file
+        BOOST_TEST_GT(n, 6380u);
+    }
+
+    void
+    testOptions()
+    {
+        uts46_options lax;
+        lax.check_hyphens = false;
+        lax.use_std3_rules = false;
+        lax.verify_dns_length = false;
+
+        // CheckHyphens
+        BOOST_TEST(uts46_to_ascii("-a.b").has_error());
+        BOOST_TEST(uts46_to_ascii("a-.b").has_error());
+        BOOST_TEST(uts46_to_ascii("ab--c").has_error());
+        BOOST_TEST_EQ(*uts46_to_ascii("-a.b", lax), "-a.b");
+        BOOST_TEST_EQ(*uts46_to_ascii("ab--c", lax), "ab--c");
+        // ACE labels are still decoded, and must be valid
+        BOOST_TEST(uts46_to_ascii("xn--ab", lax).has_error());
+
+        // UseSTD3ASCIIRules
+        BOOST_TEST(uts46_to_ascii("a_b.com").has_error());
+        BOOST_TEST(uts46_to_ascii(
+            "\xE2\x91\xB4.com").has_error());       // (1)
+        BOOST_TEST_EQ(*uts46_to_ascii("a_b.com", lax), "a_b.com");
+        BOOST_TEST_EQ(*uts46_to_ascii(
+            "\xE2\x91\xB4.com", lax), "(1).com");
+
+        // VerifyDnsLength
+        std::string const label63(63, 'a');
+        std::string const label64(64, 'a');
+        BOOST_TEST(uts46_to_ascii("").has_error());
+        BOOST_TEST(uts46_to_ascii("a..b").has_error());
+        BOOST_TEST(uts46_to_ascii("a.b.").has_error());
+        BOOST_TEST_EQ(*uts46_to_ascii(label63), label63);
+        BOOST_TEST(uts46_to_ascii(label64).has_error());
+        BOOST_TEST_EQ(*uts46_to_ascii("", lax), "");
+        BOOST_TEST_EQ(*uts46_to_ascii("a.b.", lax), "a.b.");
+        BOOST_TEST_EQ(*uts46_to_ascii(label64, lax), label64);
+        BOOST_TEST_EQ(*uts46_to_unicode("a.b."), "a.b.");
+
+        // CheckBidi
+        uts46_options nobidi;
+        nobidi.check_bidi = false;
+        BOOST_TEST(uts46_to_ascii(
+            "1a.\xD7\x90\xD7\x91").has_error());
+        BOOST_TEST_EQ(*uts46_to_ascii(
+            "1a.\xD7\x90\xD7\x91", nobidi), "1a.xn--4dbc");
+        BOOST_TEST_EQ(*uts46_to_ascii(
+            "1a.b\xC3\xBC"), "1a.xn--b-eha");
+
+        // CheckJoiners
+        uts46_options nojoin;
+        nojoin.check_joiners = false;
+        BOOST_TEST(uts46_to_ascii("a\xE2\x80\x8C" "b").error() ==
+            system::errc::invalid_argument);
+        BOOST_TEST(uts46_to_ascii("a\xE2\x80\x8D" "b").has_error());
+        BOOST_TEST_EQ(*uts46_to_ascii(
+            "a\xE2\x80\x8C" "b", nojoin), "xn--ab-j1t");
+        BOOST_TEST_EQ(*uts46_to_ascii(                     // after virama
+            "\xE0\xA4\x95\xE0\xA5\x8D\xE2\x80\x8D\xE0\xA4\xB7"),
+            "xn--11b2ezcw70k");
+        BOOST_TEST_EQ(*uts46_to_ascii(                     // joining
+            "\xD8\xA8\xE2\x80\x8C\xD8\xA7"), "xn--mgbb899q");
+        BOOST_TEST(uts46_to_ascii(
+            "\xD8\xA7\xE2\x80\x8C\xD8\xA8").has_error());
+        BOOST_TEST(uts46_to_ascii(
+            "\xD8\xA8\xE2\x80\x8C").has_error());
+        BOOST_TEST(uts46_to_ascii("xn--ab-j1t").has_error());
+
+        // CONTEXTO
+        uts46_options ctxo;
+        ctxo.check_contexto = true;
+        BOOST_TEST_EQ(*uts46_to_ascii("a\xC2\xB7" "b"), "xn--ab-0ea");
+        BOOST_TEST(uts46_to_ascii("a\xC2\xB7" "b", ctxo).has_error());
+        BOOST_TEST_EQ(*uts46_to_ascii(
+            "l\xC2\xB7l", ctxo), "xn--ll-0ea");
+        BOOST_TEST(uts46_to_ascii("l\xC2\xB7", ctxo).has_error());
+        BOOST_TEST_EQ(*uts46_to_ascii(
+            "\xE3\x82\xA2\xE3\x83\xBB\xE3\x82\xA2", ctxo),
+            "xn--ccka0y");
+        BOOST_TEST(uts46_to_ascii(
+            "a\xE3\x83\xBB" "b", ctxo).has_error());
+        BOOST_TEST(uts46_to_ascii(
+            "\xD8\xA8\xD9\xA0\xDB\xB0", ctxo).has_error());
+
+        // transitional processing
+        uts46_options tr;
+        tr.transitional = true;
+        BOOST_TEST_EQ(*uts46_to_ascii(
+            "fa\xC3\x9F.de"), "xn--fa-hia.de");
+        BOOST_TEST_EQ(*uts46_to_ascii(
+            "fa\xC3\x9F.de", tr), "fass.de");
+        BOOST_TEST_EQ(*uts46_to_ascii(
+            "FA\xE1\xBA\x9E.de", tr), "fass.de");
+        BOOST_TEST_EQ(*uts46_to_ascii(
+            "a\xE2\x80\x8C" "b", tr), "ab");
+    }
+
+    void
+    testNormalization()
+    {
+        // vowel signs of Unicode 16.0 which
+        // compose with themselves
+        std::string const kirat_rai =
+            "\xF0\x96\xB5\x83\xF0\x96\xB5\xA8";  // U+16D43 U+16D68
+        std::string const gurung_khema =
+            "\xF0\x96\x84\x80\xF0\x96\x84\xA1";  // U+16100 U+16121
+        BOOST_TEST_EQ(*uts46_to_unicode(
+            "\xF0\x96\xB5\x83\xF0\x96\xB5\xA7\xF0\x96\xB5\xA7"),
+            kirat_rai);
+        BOOST_TEST_EQ(*uts46_to_unicode(
+            "\xF0\x96\x84\x80\xF0\x96\x84\x9E\xF0\x96\x84\x9E"),
+            gurung_khema);
+        BOOST_TEST_EQ(*uts46_to_ascii(
+            "\xF0\x96\xB5\x83\xF0\x96\xB5\xA7\xF0\x96\xB5\xA7"),
+            *uts46_to_ascii(kirat_rai));
+        BOOST_TEST_EQ(*uts46_to_ascii(
+            "\xF0\x96\x84\x80\xF0\x96\x84\x9E\xF0\x96\x84\x9E"),
+            *uts46_to_ascii(gurung_khema));
+
+        // the second vowel sign composes too
+        BOOST_TEST_EQ(*uts46_to_unicode(
+            "\xF0\x96\xB5\x83\xF0\x96\xB5\xA3\xF0\x96\xB5\xA8"),
+            "\xF0\x96\xB5\x83\xF0\x96\xB5\xAA");    // U+16D43 U+16D6A
+    }
+
+    void
+    testErrors()
+    {
+        BOOST_TEST(uts46_to_ascii("a\xFF").error() ==
+            system::errc::illegal_byte_sequence);
+        BOOST_TEST(uts46_to_unicode("a\xFF").error() ==
+            system::errc::illegal_byte_sequence);
+        BOOST_TEST(uts46_to_ascii("a\xE2\x92\x88").error() ==
+            system::errc::invalid_argument);        // disallowed
+        BOOST_TEST(uts46_to_ascii("xn--a-").error() ==
+            system::errc::invalid_argument);        // all ascii
+        BOOST_TEST(uts46_to_ascii("xn--bcher-kva9").error() ==
+            system::errc::invalid_argument);        // truncated
+        BOOST_TEST(uts46_to_ascii("xn--a\xC3\xA4").error() ==
+            system::errc::invalid_argument);        // not ascii
+    }
+
+    void
+    testStorage()
+    {
+        // the result is built in the storage given
+        std::string storage;
+        storage.reserve(100);
+        auto const p = storage.data();
+        auto rv = uts46_to_ascii(
+            "B\xC3\xBC" "cher.de", {}, std::move(storage));
+        BOOST_TEST_EQ(*rv, "xn--bcher-kva.de");
+        BOOST_TEST(rv->data() == p);
+
+        // upper case ascii is folded without converting
+        BOOST_TEST_EQ(*uts46_to_ascii("WWW.Example.COM"),
+            "www.example.com");
+        BOOST_TEST_EQ(*uts46_to_unicode("xn--bcher-kva.DE"),
+            "b\xC3\xBC" "cher.de");
+
+        // agrees with utf8_to_idna on the usual hosts
+        for(auto const s : {
+            "example.com",
+            "B\xC3\xBC" "cher.de",
+            "\xE4\xBE\x8B\xE3\x81\x88.\xE3\x83\x86\xE3\x82\xB9\xE3\x83\x88",
+            "\xD0\xBF\xD1\x80\xD0\xB8\xD0\xBC\xD0\xB5\xD1\x80.\xD1\x80\xD1\x84" })
+            BOOST_TEST_EQ(*uts46_to_ascii(s), *utf8_to_idna(s));
+    }
+
+    void
+    run()
+    {
+        testConformance();
+        testOptions();
+        testNormalization();
+        testErrors();
+        testStorage();
+    }
+};
+
+TEST_SUITE(
+    uts46_test,
+    "boost.punycode.uts46");
+
+} // punycode
+} // boost
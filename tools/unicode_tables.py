@@ -0,0 +1,993 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+#
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#
+# Official repository: https://github.com/cppalliance/punycode
+#
+
+"""Generate src/detail/unicode_tables.hpp and .cpp
+
+Every table but those of nameprep comes from the
+data files of one version of Unicode, the one of
+the conformance tests in test/IdnaTestV2.txt:
+
+    ucd/UnicodeData.txt
+    ucd/DerivedNormalizationProps.txt
+    ucd/Scripts.txt
+    ucd/ScriptExtensions.txt
+    ucd/PropertyValueAliases.txt
+    ucd/extracted/DerivedBidiClass.txt
+    ucd/extracted/DerivedJoiningType.txt
+    idna/IdnaMappingTable.txt
+    security/confusables.txt
+    security/IdentifierStatus.txt
+
+as published under https://www.unicode.org/Public/
+with the version in the path, as in ucd/16.0.0
+or idna/16.0.0. They are looked for by name
+anywhere below the given directory. The files of
+UTS #39 under security may be of an older version,
+which the tables then name; all the others must
+be of the same one. Nameprep normalizes with the
+data of Unicode 3.2, as RFC 3491 says, which the
+unicodedata module keeps as ucd_3_2_0. Run from
+the root of the repository:
+
+    python3 tools/unicode_tables.py <directory>
+
+Each property is a three stage table: the top
+stage is indexed by the high bits of the code
+point, the middle stage by the bits below them,
+and the leaf holds the value, of up to 64 bits.
+Blocks which
+repeat are stored once, so that the planes which
+are all unassigned cost a single block.
+"""
+
+import os
+import re
+import stringprep
+import sys
+import unicodedata
+
+N = 0x110000
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..')
+
+COPYRIGHT = '''\
+//
+// Copyright (c) 2024 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/cppalliance/punycode
+//
+'''
+
+#------------------------------------------------
+#
+# Data files
+#
+
+class Ucd:
+    """The properties of one version of Unicode"""
+
+    def __init__(self, path):
+        self.files = {}
+        for top, dirs, names in os.walk(path):
+            for name in names:
+                self.files.setdefault(name, os.path.join(top, name))
+        self.versions = {}
+        aliases = {}
+        for f in self.read('PropertyValueAliases.txt'):
+            if len(f) >= 3:
+                aliases[(f[0], f[2])] = f[1]
+        self.aliases = aliases
+
+        self.category = ['Cn'] * N
+        self.combining = [0] * N
+        self.decomposition = [None] * N
+        self.decimal = [None] * N
+        first = None
+        for f in self.read('UnicodeData.txt'):
+            cp = int(f[0], 16)
+            # a range is given by its first and
+            # last code points
+            if f[1].endswith(', First>'):
+                first = cp
+                continue
+            if not f[1].endswith(', Last>'):
+                first = cp
+            for c in range(first, cp + 1):
+                self.category[c] = f[2]
+                self.combining[c] = int(f[3])
+            if f[5] and not f[5].startswith('<'):
+                self.decomposition[cp] = [int(x, 16) for x in f[5].split()]
+            if f[6]:
+                self.decimal[cp] = int(f[6])
+
+        self.exclusion = set()
+        self.nfc_maybe = set()
+        for f in self.read('DerivedNormalizationProps.txt'):
+            if f[1] == 'Full_Composition_Exclusion':
+                self.exclusion.update(self.codes(f[0]))
+            elif f[1] == 'NFC_QC' and f[2] in ('N', 'M'):
+                self.nfc_maybe.update(self.codes(f[0]))
+
+        self.bidi = self.property('DerivedBidiClass.txt', 'bc')
+        self.joining = self.property('DerivedJoiningType.txt', 'jt')
+        names = self.property('Scripts.txt', None, 'Unknown')
+        self.script = [aliases[('sc', x)] for x in names]
+        self.extensions = [[x] for x in self.script]
+        for f in self.read('ScriptExtensions.txt'):
+            for cp in self.codes(f[0]):
+                self.extensions[cp] = f[1].split()
+
+        # the statuses of IDNA2008 are not used
+        letter = { 'valid': 'V', 'disallowed': 'X', 'mapped': 'M',
+            'ignored': 'I', 'deviation': 'D' }
+        self.status = [None] * N
+        self.mapping = [None] * N
+        for f in self.read('IdnaMappingTable.txt'):
+            m = ''.join(chr(int(x, 16))
+                for x in f[2].split()) if len(f) > 2 else ''
+            for cp in self.codes(f[0]):
+                self.status[cp] = letter[f[1]]
+                self.mapping[cp] = m
+        assert None not in self.status
+
+        self.prototype = {}
+        for f in self.read('confusables.txt'):
+            self.prototype[int(f[0], 16)] = ''.join(
+                chr(int(x, 16)) for x in f[1].split())
+        self.allowed = [False] * N
+        for f in self.read('IdentifierStatus.txt'):
+            if f[1] == 'Allowed':
+                for cp in self.codes(f[0]):
+                    self.allowed[cp] = True
+
+        self.confusables_version = self.versions.pop('confusables.txt')
+        self.identifier_version = self.versions.pop('IdentifierStatus.txt')
+        versions = set(self.versions.values())
+        if len(versions) != 1:
+            sys.exit('the data files are of versions ' +
+                ', '.join(sorted(versions)))
+        self.version = versions.pop()
+
+    @staticmethod
+    def codes(s):
+        """The code points of a field"""
+        first, _, last = s.partition('..')
+        return range(int(first, 16), int(last or first, 16) + 1)
+
+    def read(self, name, missing=None):
+        """The fields of each line of a data file"""
+        if name not in self.files:
+            sys.exit(name + ' not found')
+        with open(self.files[name], encoding='utf-8') as f:
+            text = f.read()
+        # the version is in the name of the file
+        # on its first line, or on a line of its own
+        if name != 'UnicodeData.txt':
+            self.versions[name] = re.search(
+                r'^# (?:\S+-|Version: )(\d+\.\d+\.\d+)',
+                text, re.M).group(1)
+        for line in text.splitlines():
+            if missing is not None and line.startswith('# @missing:'):
+                missing.append([x.strip() for x in line[11:].split(';')])
+            line = line.split('#')[0].strip()
+            if line:
+                yield [x.strip() for x in line.split(';')]
+
+    def property(self, name, alias, default=None):
+        """A property given by ranges, with the defaults of @missing"""
+        missing = []
+        lines = list(self.read(name, missing))
+        values = [default] * N
+        for f in missing:
+            v = self.aliases[(alias, f[1])] if alias else f[1]
+            for cp in self.codes(f[0]):
+                values[cp] = v
+        for f in lines:
+            for cp in self.codes(f[0]):
+                values[cp] = f[1]
+        return values
+
+    def canonical(self, cp):
+        """Return the full canonical decomposition"""
+        if 0xac00 <= cp <= 0xd7a3:
+            # Hangul syllables, by arithmetic
+            s = cp - 0xac00
+            d = [0x1100 + s // 588, 0x1161 + s % 588 // 28]
+            return d + [0x11a7 + s % 28] if s % 28 else d
+        d = self.decomposition[cp]
+        if not d:
+            return [cp]
+        out = []
+        for x in d:
+            out.extend(self.canonical(x))
+        return out
+
+    def nfd(self, s):
+        """Return the NFD of a string"""
+        d = []
+        for c in s:
+            d.extend(self.canonical(ord(c)))
+        # put each run of marks in canonical order
+        for i in range(1, len(d)):
+            j = i
+            while (j > 0 and self.combining[d[j]] and
+                    self.combining[d[j - 1]] > self.combining[d[j]]):
+                d[j - 1], d[j] = d[j], d[j - 1]
+                j -= 1
+        return ''.join(chr(x) for x in d)
+
+#------------------------------------------------
+#
+# Tables
+#
+
+class Trie:
+    """A three stage table over all code points"""
+
+    def __init__(self, name, values, width=4):
+        self.name = name
+        self.width = width
+        best = None
+        for mid in range(2, 9):
+            for leaf in range(3, 9):
+                t = self._build(values, mid, leaf, width)
+                if t and (best is None or t[0] < best[0]):
+                    best = t
+        (self.size, self.mid_bits, self.leaf_bits,
+            self.top, self.mid, self.leaf) = best
+
+    @staticmethod
+    def _build(values, mid_bits, leaf_bits, width):
+        n = 1 << leaf_bits
+        blocks = {}
+        leaf = []
+        ids = []
+        for i in range(0, N, n):
+            b = tuple(values[i:i + n])
+            if b not in blocks:
+                blocks[b] = len(blocks)
+                leaf.extend(b)
+            ids.append(blocks[b])
+        m = 1 << mid_bits
+        blocks = {}
+        mid = []
+        top = []
+        for i in range(0, len(ids), m):
+            b = tuple(ids[i:i + m])
+            if b not in blocks:
+                blocks[b] = len(blocks)
+                mid.extend(b)
+            top.append(blocks[b])
+        # the top stage holds octets
+        if len(blocks) > 256:
+            return None
+        size = len(top) + 2 * len(mid) + width * len(leaf)
+        return (size, mid_bits, leaf_bits, top, mid, leaf)
+
+    def declare(self):
+        n = self.name
+        return (
+            'extern std::uint8_t const {0}_top[];\n'
+            'extern std::uint16_t const {0}_mid[];\n'
+            'extern std::uint{6}_t const {0}_leaf[];\n'
+            '\n'
+            'inline\n'
+            'std::uint{7}_t\n'
+            '{0}(char32_t cp) noexcept\n'
+            '{{\n'
+            '    BOOST_ASSERT(cp < 0x110000);\n'
+            '    std::uint32_t const i = {0}_top[\n'
+            '        cp >> {1}];\n'
+            '    std::uint32_t const j = {0}_mid[\n'
+            '        (i << {2}) | ((cp >> {3}) & {4})];\n'
+            '    return {0}_leaf[\n'
+            '        (j << {3}) | (cp & {5})];\n'
+            '}}\n').format(
+                n,
+                self.mid_bits + self.leaf_bits,
+                self.mid_bits,
+                self.leaf_bits,
+                (1 << self.mid_bits) - 1,
+                (1 << self.leaf_bits) - 1,
+                8 * self.width,
+                max(32, 8 * self.width))
+
+    def define(self):
+        n = self.name
+        return (
+            array('std::uint8_t', n + '_top', self.top, 2) +
+            array('std::uint16_t', n + '_mid', self.mid, 4) +
+            array('std::uint{0}_t'.format(8 * self.width),
+                n + '_leaf', self.leaf, 2 * self.width))
+
+
+def array(type, name, values, digits):
+    per_line = 72 // (digits + 4)
+    out = '{0} const {1}[] = {{\n'.format(type, name)
+    for i in range(0, len(values), per_line):
+        out += '    ' + ' '.join(
+            '0x{0:0{1}x},'.format(v, digits)
+            for v in values[i:i + per_line]) + '\n'
+    return out + '};\n\n'
+
+#------------------------------------------------
+#
+# UTS #46
+#
+# bits 0-2      status
+# bit 3         the code point or its mapping has
+#               a combining class or is not NFC
+#               quick check Yes, so the string
+#               needs the normalization pass
+# bits 4-8      length of a mapping in the pool
+# bits 9-31     offset of the mapping in the pool
+# bits 8-31     or, for MAPPED, the signed distance
+#               to the single code point
+#
+
+VALID       = 0
+DISALLOWED  = 1
+MAPPED      = 2     # to the code point at a distance
+REPLACED    = 3     # to a string in the pool, maybe empty
+DEVIATION   = 4     # a string, in transitional processing
+
+def uts46(ucd, unstable):
+    status = ucd.status
+    mapping = ucd.mapping
+
+    pool = []
+    offsets = {}
+    def intern(s):
+        if s not in offsets:
+            offsets[s] = len(pool)
+            pool.extend(ord(c) for c in s)
+        return offsets[s]
+
+    # mappings are to valid code points, which the
+    # processing relies on, but for U+1E9E, which
+    # is special in transitional processing
+    for cp in range(N):
+        if cp != 0x1e9e:
+            assert all(status[ord(c)] == 'V'
+                for c in mapping[cp] or '')
+
+    values = [0] * N
+    for cp in range(N):
+        s = status[cp]
+        m = mapping[cp] or ''
+        if s == 'V':
+            v = VALID
+        elif s == 'X':
+            v = DISALLOWED
+        elif s == 'M' and len(m) == 1:
+            v = MAPPED | (((ord(m) - cp) & 0xffffff) << 8)
+        elif s in 'MI':
+            v = REPLACED | (len(m) << 4) | (intern(m) << 9)
+        elif s == 'D':
+            v = DEVIATION | (len(m) << 4) | (intern(m) << 9)
+        else:
+            raise ValueError('status ' + s)
+        assert len(m) < 32 and len(pool) < (1 << 23)
+        kept = [] if s in 'MIX' else [cp]
+        if any(unstable(ord(c)) for c in m) or any(
+                unstable(c) for c in kept):
+            v |= 1 << 3
+        values[cp] = v
+    return Trie('uts46_lookup', values), pool
+
+#------------------------------------------------
+#
+# Normalization
+#
+# bits 0-7      canonical combining class
+# bit 8         NFC_Quick_Check is No or Maybe
+# bit 9         General_Category is Mark
+# bits 10-12    length of the full canonical
+#               decomposition
+# bits 13-31    offset of the decomposition
+#
+
+def normalization(ucd):
+    pairs = {}
+    for cp in range(N):
+        d = ucd.decomposition[cp]
+        # a primary composite is what NFC turns
+        # its decomposition back into
+        if d and cp not in ucd.exclusion:
+            assert len(d) == 2
+            pairs[(d[0], d[1])] = cp
+
+    pool = []
+    offsets = {}
+    values = [0] * N
+    for cp in range(N):
+        if 0xd800 <= cp < 0xe000:
+            continue
+        v = ucd.combining[cp]
+        if cp in ucd.nfc_maybe:
+            v |= 1 << 8
+        if ucd.category[cp].startswith('M'):
+            v |= 1 << 9
+        # Hangul syllables are decomposed by
+        # arithmetic, without the tables
+        if not 0xac00 <= cp <= 0xd7a3:
+            d = ucd.canonical(cp)
+            if d != [cp]:
+                t = tuple(d)
+                if t not in offsets:
+                    offsets[t] = len(pool)
+                    pool.extend(d)
+                assert len(d) < 8
+                v |= (len(d) << 10) | (offsets[t] << 13)
+        values[cp] = v
+    assert len(pool) < (1 << 19)
+
+    compose = sorted(
+        (a << 42) | (b << 21) | c
+        for (a, b), c in pairs.items())
+    return Trie('nfc_lookup', values), pool, compose, values
+
+#------------------------------------------------
+#
+# NFKC for nameprep, as of Unicode 3.2
+#
+# bits 0-7      canonical combining class
+# bit 8         NFKC_Quick_Check is No or Maybe
+# bits 9-13     length of the full compatibility
+#               decomposition, or 0 for none
+# bit 14        the NFKC has a prohibited character,
+#               as described below
+# bits 15-31    offset of the decomposition;
+#               Hangul syllables have only the
+#               length, being done by arithmetic
+#
+
+# tables C.1.2, C.2.2 and C.3 to C.9 of RFC 3454,
+# which nameprep prohibits in its output
+PROHIBITED = (
+    stringprep.in_table_c12,
+    stringprep.in_table_c22,
+    stringprep.in_table_c3,
+    stringprep.in_table_c4,
+    stringprep.in_table_c5,
+    stringprep.in_table_c6,
+    stringprep.in_table_c7,
+    stringprep.in_table_c8,
+    stringprep.in_table_c9)
+
+def is_prohibited(c):
+    return any(t(c) for t in PROHIBITED)
+
+def nfkc():
+    ucd = unicodedata.ucd_3_2_0
+    pairs = {}
+    for cp in range(N):
+        if 0xd800 <= cp < 0xe000:
+            continue
+        d = ucd.decomposition(chr(cp))
+        if not d or d.startswith('<'):
+            continue
+        d = [int(x, 16) for x in d.split()]
+        if len(d) == 2 and ucd.normalize(
+                'NFC', chr(d[0]) + chr(d[1])) == chr(cp):
+            pairs[(d[0], d[1])] = cp
+    seconds = set(b for (a, b) in pairs)
+
+    pool = []
+    offsets = {}
+    values = [0] * N
+    for cp in range(N):
+        if 0xd800 <= cp < 0xe000:
+            values[cp] = 1 << 14
+            continue
+        c = chr(cp)
+        v = ucd.combining(c)
+        if any(is_prohibited(x) for x in ucd.normalize('NFKC', c)):
+            v |= 1 << 14
+        if (ucd.normalize('NFKC', c) != c or
+                cp in seconds or
+                0x1161 <= cp <= 0x1175 or
+                0x11a8 <= cp <= 0x11c2):
+            v |= 1 << 8
+        if 0xac00 <= cp <= 0xd7a3:
+            v |= 3 << 9
+        else:
+            # normalize, rather than decomposition,
+            # has the corrections made since 3.2
+            d = [ord(x) for x in ucd.normalize('NFKD', c)]
+            if d != [cp]:
+                t = tuple(d)
+                if t not in offsets:
+                    offsets[t] = len(pool)
+                    pool.extend(d)
+                assert len(d) < 32
+                v |= (len(d) << 9) | (offsets[t] << 15)
+        values[cp] = v
+    assert len(pool) < (1 << 17)
+
+    # nothing below U+00A0 is changed, and only
+    # the controls from U+0080 are prohibited,
+    # which lets ascii skip the table
+    assert all(values[cp] == 0 for cp in range(0x80))
+    assert all(values[cp] == 1 << 14 for cp in range(0x80, 0xa0))
+
+    compose = sorted(
+        (a << 42) | (b << 21) | c
+        for (a, b), c in pairs.items())
+    return Trie('nfkc_lookup', values), pool, compose
+
+#------------------------------------------------
+#
+# Nameprep prohibited and unassigned code points
+#
+# These are properties of the input: a code point
+# is prohibited when its mapping, after NFKC, has
+# a prohibited character. Composition never makes
+# or consumes one, so the output has a prohibited
+# character exactly when the input does.
+#
+
+class Bitset:
+    """A two stage bitset over all code points"""
+
+    def __init__(self, name, bits):
+        self.name = name
+        best = None
+        for shift in range(6, 13):
+            t = self._build(bits, shift)
+            if t and (best is None or t[0] < best[0]):
+                best = t
+        self.size, self.shift, self.index, self.words = best
+
+    @staticmethod
+    def _build(bits, shift):
+        n = 1 << shift
+        blocks = {}
+        words = []
+        index = []
+        for i in range(0, N, n):
+            b = []
+            for j in range(i, i + n, 64):
+                w = 0
+                for k in range(64):
+                    if bits[j + k]:
+                        w |= 1 << k
+                b.append(w)
+            b = tuple(b)
+            if b not in blocks:
+                blocks[b] = len(blocks)
+                words.extend(b)
+            index.append(blocks[b])
+        if len(blocks) > 256:
+            return None
+        return (len(index) + 8 * len(words), shift, index, words)
+
+    def declare(self):
+        n = self.name
+        return (
+            'extern std::uint8_t const {0}_index[];\n'
+            'extern std::uint64_t const {0}_words[];\n'
+            '\n'
+            'inline\n'
+            'bool\n'
+            '{0}(char32_t cp) noexcept\n'
+            '{{\n'
+            '    BOOST_ASSERT(cp < 0x110000);\n'
+            '    std::uint32_t const i = {0}_index[\n'
+            '        cp >> {1}];\n'
+            '    return ({0}_words[\n'
+            '        (i << {2}) | ((cp >> 6) & {3})] >>\n'
+            '            (cp & 63)) & 1;\n'
+            '}}\n').format(
+                n,
+                self.shift,
+                self.shift - 6,
+                (1 << (self.shift - 6)) - 1)
+
+    def define(self):
+        n = self.name
+        return (
+            array('std::uint8_t', n + '_index', self.index, 2) +
+            array('std::uint64_t', n + '_words', self.words, 16))
+
+
+def nameprep_bits(nfkc_compose):
+    ucd = unicodedata.ucd_3_2_0
+    composed = set()
+    for v in nfkc_compose:
+        composed.update((v >> 42, (v >> 21) & 0x1fffff, v & 0x1fffff))
+    assert not any(is_prohibited(chr(cp)) for cp in composed)
+
+    prohibited = [False] * N
+    unassigned = [False] * N
+    for cp in range(N):
+        c = chr(cp)
+        unassigned[cp] = stringprep.in_table_a1(c)
+        if 0xd800 <= cp < 0xe000:
+            prohibited[cp] = True
+            continue
+        if stringprep.in_table_b1(c):
+            continue
+        # the case folding of stringprep comes from
+        # the running interpreter, which may know
+        # newer letters; they are never prohibited
+        m = ucd.normalize('NFKC', stringprep.map_table_b2(c))
+        prohibited[cp] = any(is_prohibited(x) for x in m)
+    assert not any(prohibited[cp] for cp in range(0x80))
+    assert not any(unassigned[cp] for cp in range(0x80))
+    strict = [p or u for p, u in zip(prohibited, unassigned)]
+    return (
+        Bitset('prohibited_bits', prohibited),
+        Bitset('prohibited_unassigned_bits', strict))
+
+#------------------------------------------------
+#
+# Bidi classes, for the Bidi Rule of RFC 5893
+#
+# The classes the rule tells apart, with the
+# explicit formatting classes and the separators
+# as OTHER, which it never allows.
+#
+
+BIDI = ('L', 'R', 'AL', 'AN', 'EN', 'ES', 'CS',
+    'ET', 'ON', 'BN', 'NSM', 'OTHER')
+
+def bidi(ucd):
+    values = [0] * N
+    for cp in range(N):
+        b = ucd.bidi[cp]
+        if b not in BIDI:
+            b = 'OTHER'
+        values[cp] = BIDI.index(b)
+    # letters are L, digits EN and the hyphen
+    # ES, which lets host names skip the table
+    assert all(values[cp] == 0 for cp in range(0x41, 0x5b))
+    assert all(values[cp] == 0 for cp in range(0x61, 0x7b))
+    assert all(values[cp] == 4 for cp in range(0x30, 0x3a))
+    assert values[0x2d] == 5
+    return Trie('bidi_lookup', values, 1)
+
+#------------------------------------------------
+#
+# Contextual rules of RFC 5892, appendix A
+#
+# bit 0         Joining_Type T
+# bit 1         Joining_Type L or D
+# bit 2         Joining_Type R or D
+# bit 3         script Greek
+# bit 4         script Hebrew
+# bit 5         script Hiragana, Katakana or Han
+# bit 6         Canonical_Combining_Class Virama
+#
+
+def context(ucd):
+    values = [0] * N
+    bits = {'T': 1, 'L': 2, 'D': 6, 'R': 4}
+    scripts = {'Grek': 8, 'Hebr': 16, 'Hira': 32,
+        'Kana': 32, 'Hani': 32}
+    for cp in range(N):
+        values[cp] = (bits.get(ucd.joining[cp], 0) |
+            scripts.get(ucd.script[cp], 0))
+        if ucd.combining[cp] == 9:
+            values[cp] |= 64
+    # nothing in ascii takes part, which
+    # lets it skip the table
+    assert all(values[cp] == 0 for cp in range(0x80))
+    return Trie('context_lookup', values, 1)
+
+#------------------------------------------------
+#
+# Confusables of UTS #39
+#
+# The table holds the 16-bit index of the
+# prototype in the list of them, or zero for a
+# code point which is its own prototype. Only
+# code points which are their own NFD have one:
+# the skeleton decomposes its input first. Each
+# entry of the list is
+#
+# bits 0-4      length of the prototype
+# bits 5-31     offset of the prototype in the pool
+#
+# where each prototype is stored in NFD.
+#
+
+def confusables(ucd):
+    pool = []
+    index = {}
+    prototypes = [0]
+    values = [0] * N
+    for cp in range(N):
+        if 0xd800 <= cp < 0xe000:
+            continue
+        c = chr(cp)
+        if cp not in ucd.prototype or ucd.nfd(c) != c:
+            continue
+        # the skeleton of the code point
+        p = ucd.nfd(ucd.prototype[cp])
+        if p == c:
+            continue
+        if p not in index:
+            assert len(p) < 32
+            index[p] = len(prototypes)
+            prototypes.append(len(p) | (len(pool) << 5))
+            pool.extend(ord(x) for x in p)
+        values[cp] = index[p]
+    assert len(prototypes) <= 0x10000
+    # the separator of labels is left alone
+    assert values[ord('.')] == 0
+    return Trie('confusable_lookup', values, 2), prototypes, pool
+
+#------------------------------------------------
+#
+# Scripts and identifier status of UTS #39
+#
+# bits 0-28     the recommended scripts of UAX #31
+#               in the Script_Extensions, in the
+#               order of RECOMMENDED
+# bit 29        any other script
+# bits 30-32    Hanb, Jpan and Kore, which augment
+#               the script sets
+# bit 33        Identifier_Status Allowed
+# bit 34        General_Category Nd
+# bits 35-38    the value of the digit
+# bits 39-63    the other scripts which Allowed
+#               characters have, each on its own
+#
+# Common and Inherited, which go with any
+# script, have no script bits. Only Allowed
+# characters are told apart by the last bits,
+# since a label with any other character is
+# unrestricted, whatever its scripts. Of
+# those, only the scripts which can be all
+# that a label resolves to get one: when the
+# Allowed characters having a script have a
+# recommended one in common, a label with it
+# resolves to that one too.
+#
+
+RECOMMENDED = (
+    'Arab', 'Armn', 'Beng', 'Bopo', 'Cyrl', 'Deva', 'Ethi',
+    'Geor', 'Grek', 'Gujr', 'Guru', 'Hang', 'Hani', 'Hebr',
+    'Hira', 'Kana', 'Khmr', 'Knda', 'Laoo', 'Latn', 'Mlym',
+    'Mymr', 'Orya', 'Sinh', 'Taml', 'Telu', 'Thaa', 'Thai',
+    'Tibt')
+
+AUGMENT = {
+    'Hani': ('Hanb', 'Jpan', 'Kore'),
+    'Hira': ('Jpan',),
+    'Kana': ('Jpan',),
+    'Hang': ('Kore',),
+    'Bopo': ('Hanb',) }
+
+def scripts(ucd):
+    scx = ucd.extensions
+    allowed = ucd.allowed
+    common = {}
+    for cp in range(N):
+        if not allowed[cp] or set(scx[cp]) & set(('Zyyy', 'Zinh')):
+            continue
+        s = set()
+        for x in scx[cp]:
+            if x in RECOMMENDED:
+                s.update((x,) + AUGMENT.get(x, ()))
+        for x in scx[cp]:
+            if x not in RECOMMENDED:
+                common[x] = common.get(x, s) & s
+    extra = sorted(x for x in common if not common[x])
+    assert len(RECOMMENDED) == 29 and len(extra) <= 25
+
+    bit = dict((x, 1 << i) for i, x in enumerate(RECOMMENDED))
+    bit.update(Hanb=1 << 30, Jpan=1 << 31, Kore=1 << 32)
+    for i, x in enumerate(extra):
+        bit[x] = (1 << 29) | (1 << (39 + i))
+    values = [0] * N
+    for cp in range(N):
+        if 0xd800 <= cp < 0xe000:
+            continue
+        v = 0
+        if not set(scx[cp]) & set(('Zyyy', 'Zinh')):
+            for x in scx[cp]:
+                v |= bit.get(x, 1 << 29)
+                for y in AUGMENT.get(x, ()):
+                    v |= bit[y]
+        if allowed[cp]:
+            v |= 1 << 33
+        if ucd.category[cp] == 'Nd':
+            v |= (1 << 34) | (ucd.decimal[cp] << 35)
+        values[cp] = v
+    return Trie('script_lookup', values, 8)
+
+#------------------------------------------------
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit(__doc__)
+    ucd = Ucd(sys.argv[1])
+    # the conformance tests are of the same version
+    with open(os.path.join(ROOT, 'test', 'IdnaTestV2.txt'),
+            encoding='utf-8') as f:
+        v = re.search(r'^# Version: (\S+)', f.read(), re.M).group(1)
+    if v != ucd.version:
+        sys.exit('test/IdnaTestV2.txt is {0}, not {1}'.format(
+            v, ucd.version))
+
+    nfc_trie, nfc_pool, compose, nfc = normalization(ucd)
+    map_trie, map_pool = uts46(ucd,
+        lambda cp: (nfc[cp] & 0x1ff) != 0)
+    nfkc_trie, nfkc_pool, nfkc_compose = nfkc()
+    prohibited, strict = nameprep_bits(nfkc_compose)
+    bidi_trie = bidi(ucd)
+    context_trie = context(ucd)
+    confusable_trie, prototypes, confusable_pool = confusables(ucd)
+    script_trie = scripts(ucd)
+
+    source = (
+        '// Generated by tools/unicode_tables.py from\n'
+        '// the data files of Unicode {0}, with the\n'
+        '// confusables of UTS #39 {1}, its\n'
+        '// identifier status {2}, and {3} for\n'
+        '// nameprep. Do not edit.\n').format(
+            ucd.version,
+            ucd.confusables_version,
+            ucd.identifier_version,
+            unicodedata.ucd_3_2_0.unidata_version)
+
+    with open(os.path.join(
+            ROOT, 'src', 'detail', 'unicode_tables.hpp'), 'w') as f:
+        f.write(COPYRIGHT + '\n' + source + '''
+#ifndef BOOST_PUNYCODE_SRC_DETAIL_UNICODE_TABLES_HPP
+#define BOOST_PUNYCODE_SRC_DETAIL_UNICODE_TABLES_HPP
+
+#include <boost/assert.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace boost {
+namespace punycode {
+namespace detail {
+
+// UTS #46 mapping: the status in bits 0-2, and
+// in bit 3 whether the result may need the
+// normalization pass. A mapping to one code
+// point is the signed distance to it in bits
+// 8-31, and any other has its length in bits
+// 4-8 and its offset in uts46_pool in 9-31
+''' + map_trie.declare() + '''
+extern char32_t const uts46_pool[];
+
+// normalization: the canonical combining class
+// in bits 0-7, NFC_Quick_Check other than Yes
+// in bit 8, a mark in bit 9, and the full
+// canonical decomposition as a length in bits
+// 10-12 and an offset in nfc_pool in 13-31
+''' + nfc_trie.declare() + '''
+extern char32_t const nfc_pool[];
+
+// primary composites, as the first code point
+// in bits 42-62, the second in 21-41 and the
+// composite in bits 0-20, sorted
+extern std::uint64_t const nfc_compose_table[];
+constexpr std::size_t nfc_compose_size = ''' + str(len(compose)) + ''';
+
+// NFKC of Unicode 3.2, for nameprep: the
+// canonical combining class in bits 0-7,
+// NFKC_Quick_Check other than Yes in bit 8,
+// the full compatibility decomposition as a
+// length in bits 9-13 and an offset in
+// nfkc_pool in 15-31, and in bit 14 whether
+// the NFKC has a character nameprep
+// prohibits. Hangul syllables have the
+// length and no offset.
+''' + nfkc_trie.declare() + '''
+extern char32_t const nfkc_pool[];
+
+// primary composites, as in nfc_compose_table
+extern std::uint64_t const nfkc_compose_table[];
+constexpr std::size_t nfkc_compose_size = ''' + str(len(nfkc_compose)) + ''';
+
+// input code points nameprep prohibits, and
+// those along with the ones unassigned in
+// Unicode 3.2, which stored strings reject
+''' + prohibited.declare() + '''
+''' + strict.declare() + '''
+// the bidi class, as the index in
+// L R AL AN EN ES CS ET ON BN NSM, or 11
+// for the classes the Bidi Rule never allows
+''' + bidi_trie.declare() + '''
+// properties for the contextual rules of
+// RFC 5892: Joining_Type T in bit 0, L or D
+// in bit 1 and R or D in bit 2, the scripts
+// Greek in bit 3, Hebrew in bit 4, and
+// Hiragana, Katakana or Han in bit 5, and
+// a combining class of Virama in bit 6
+''' + context_trie.declare() + '''
+// the prototype of UTS #39, for code points
+// which are their own NFD, as an index in
+// confusable_prototypes, or zero if it is
+// the code point. Each prototype has its
+// length in bits 0-4 and its offset in
+// confusable_pool in 5-31.
+''' + confusable_trie.declare() + '''
+extern std::uint32_t const confusable_prototypes[];
+extern char32_t const confusable_pool[];
+
+// scripts and identifier status of UTS #39:
+// a bit for each recommended script in the
+// Script_Extensions in bits 0-28, any other
+// script in bit 29, and the augmenting sets
+// Hanb, Jpan and Kore in bits 30-32, with
+// none for Common or Inherited. Bit 33 is
+// Identifier_Status Allowed, bit 34 a decimal
+// digit, and its value is in bits 35-38. The
+// other scripts of Allowed characters which a
+// label can resolve to alone have a bit each
+// from bit 39 up
+''' + script_trie.declare() + '''
+} // detail
+} // punycode
+} // boost
+
+#endif
+''')
+
+    with open(os.path.join(
+            ROOT, 'src', 'detail', 'unicode_tables.cpp'), 'w') as f:
+        f.write(COPYRIGHT + '\n' + source + '''
+#include "src/detail/unicode_tables.hpp"
+
+namespace boost {
+namespace punycode {
+namespace detail {
+
+''' +
+            map_trie.define() +
+            array('char32_t', 'uts46_pool', map_pool, 5) +
+            nfc_trie.define() +
+            array('char32_t', 'nfc_pool', nfc_pool, 5) +
+            array('std::uint64_t', 'nfc_compose_table', compose, 16) +
+            nfkc_trie.define() +
+            array('char32_t', 'nfkc_pool', nfkc_pool, 5) +
+            array('std::uint64_t', 'nfkc_compose_table',
+                nfkc_compose, 16) +
+            prohibited.define() +
+            strict.define() +
+            bidi_trie.define() +
+            context_trie.define() +
+            confusable_trie.define() +
+            array('std::uint32_t', 'confusable_prototypes',
+                prototypes, 8) +
+            array('char32_t', 'confusable_pool',
+                confusable_pool, 5) +
+            script_trie.define() + '''\
+} // detail
+} // punycode
+} // boost
+''')
+
+    print('uts46: {0} + {1} octets, nfc: {2} + {3} octets, '
+        'nfkc: {4} + {5} octets, nameprep: {6} + {7} '
+        'octets, bidi: {8} octets, context: {9} '
+        'octets, confusables: {10} + {11} octets, '
+        'scripts: {12} octets'.format(
+        map_trie.size, 4 * len(map_pool),
+        nfc_trie.size, 4 * len(nfc_pool) + 8 * len(compose),
+        nfkc_trie.size,
+        4 * len(nfkc_pool) + 8 * len(nfkc_compose),
+        prohibited.size, strict.size, bidi_trie.size,
+        context_trie.size, confusable_trie.size,
+        4 * len(prototypes) + 4 * len(confusable_pool),
+        script_trie.size),
+        file=sys.stderr)
+
+if __name__ == '__main__':
+    main()